@@ -0,0 +1,118 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "io/StandardMapParser.h"
+#include "io/TestParserStatus.h"
+#include "io/WorldReader.h"
+#include "mdl/LayerNode.h"
+#include "mdl/WorldNode.h"
+
+#include "vm/bbox.h"
+
+#include <fmt/format.h>
+
+#include <string>
+
+namespace tb::io
+{
+namespace
+{
+
+constexpr size_t NumBrushes = 20'000;
+
+/**
+ * Returns a Valve 220 map with one cuboid brush per entity. Every face has 20 numbers,
+ * most of them with fractional digits.
+ */
+std::string makeMap()
+{
+  auto result = std::string{"{\n\"classname\" \"worldspawn\"\n\"mapversion\" \"220\"\n}\n"};
+  for (size_t i = 0; i < NumBrushes; ++i)
+  {
+    const auto x = double(i % 100) * 64.0 - 3200.0;
+    const auto y = double(i / 100) * 64.0 - 6400.0;
+    const auto offset = double(i % 64) + 0.375;
+
+    result += "{\n\"classname\" \"func_detail\"\n{\n";
+    result += fmt::format(
+      "( {0} {1} 0 ) ( {0} {3} 0 ) ( {0} {1} 32 ) wall [ 0 -1 0 {4} ] [ 0 0 -1 0.5 ] "
+      "32.6509 0.25 0.25\n"
+      "( {2} {1} 0 ) ( {2} {1} 32 ) ( {2} {3} 0 ) wall [ 0 1 0 {4} ] [ 0 0 -1 0.5 ] "
+      "32.6509 0.25 0.25\n"
+      "( {0} {1} 0 ) ( {0} {1} 32 ) ( {2} {1} 0 ) wall [ 1 0 0 {4} ] [ 0 0 -1 0.5 ] "
+      "35.6251 0.25 0.25\n"
+      "( {0} {3} 0 ) ( {2} {3} 0 ) ( {0} {3} 32 ) wall [ -1 0 0 {4} ] [ 0 0 -1 0.5 ] "
+      "35.6251 0.25 0.25\n"
+      "( {0} {1} 0 ) ( {2} {1} 0 ) ( {0} {3} 0 ) floor [ 1 0 0 {4} ] [ 0 -1 0 -4.75 ] "
+      "324.375 0.5 0.5\n"
+      "( {0} {1} 32 ) ( {0} {3} 32 ) ( {2} {1} 32 ) floor [ 1 0 0 {4} ] [ 0 -1 0 -4.75 ] "
+      "324.375 0.5 0.5\n",
+      x,
+      y,
+      x + 48.0,
+      y + 48.0,
+      offset);
+    result += "}\n}\n";
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("MapParserBenchmark.parseValveMap")
+{
+  const auto map = makeMap();
+
+  auto numberCount = size_t(0);
+  auto sum = 0.0;
+  timeLambda(
+    [&]() {
+      auto tokenizer = QuakeMapTokenizer{map};
+      for (auto token = tokenizer.nextToken(); !token.hasType(QuakeMapToken::Eof);
+           token = tokenizer.nextToken())
+      {
+        if (token.hasType(QuakeMapToken::Number))
+        {
+          sum += token.toFloat<double>();
+          ++numberCount;
+        }
+      }
+    },
+    fmt::format("tokenize {} bytes and convert all numbers", map.size()));
+
+  CHECK(numberCount >= NumBrushes * 6 * 20);
+  CHECK(sum != 0.0);
+
+  const auto worldBounds = vm::bbox3d{8192.0};
+  auto status = TestParserStatus{};
+  auto reader = WorldReader{map, mdl::MapFormat::Valve, {}};
+
+  auto world = std::unique_ptr<mdl::WorldNode>{};
+  timeLambda(
+    [&]() { world = reader.read(worldBounds, status); },
+    fmt::format("read map with {} brushes", NumBrushes));
+
+  REQUIRE(world != nullptr);
+  CHECK(world->defaultLayer()->childCount() == NumBrushes);
+}
+
+} // namespace tb::io
@@ -0,0 +1,102 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "Color.h"
+#include "io/Reader.h"
+#include "mdl/Palette.h"
+#include "mdl/TextureBuffer.h"
+
+#include "kdl/result.h"
+
+#include <fmt/format.h>
+
+#include <random>
+#include <vector>
+
+namespace tb::mdl
+{
+namespace
+{
+
+constexpr size_t NumPixels = 64 * 1024 * 1024;
+
+auto makeRandomPalette(std::mt19937& rng)
+{
+  auto data = std::vector<unsigned char>(768);
+  for (auto& c : data)
+  {
+    c = static_cast<unsigned char>(rng());
+  }
+  return makePalette(data, PaletteColorFormat::Rgb) | kdl::value();
+}
+
+} // namespace
+
+TEST_CASE("PaletteBenchmark.indexedToRgba")
+{
+  auto rng = std::mt19937{};
+  const auto palette = makeRandomPalette(rng);
+
+  for (const auto size : {64u, 128u, 256u, 512u, 1024u})
+  {
+    const auto pixelCount = size_t(size) * size_t(size);
+    // convert the same number of pixels for every texture size
+    const auto repetitions = NumPixels / pixelCount;
+
+    auto indices = std::vector<unsigned char>(pixelCount);
+    for (auto& index : indices)
+    {
+      index = static_cast<unsigned char>(rng());
+    }
+
+    auto rgbaImage = TextureBuffer{pixelCount * 4};
+    auto averageColor = Color{};
+
+    timeLambda(
+      [&]() {
+        for (size_t i = 0; i < repetitions; ++i)
+        {
+          palette.indexedToRgba(
+            indices, rgbaImage, PaletteTransparency::Index255Transparent, averageColor);
+        }
+      },
+      fmt::format("convert {} {}x{} textures from span", repetitions, size, size));
+
+    timeLambda(
+      [&]() {
+        for (size_t i = 0; i < repetitions; ++i)
+        {
+          auto reader = io::Reader::from(
+            reinterpret_cast<const char*>(indices.data()),
+            reinterpret_cast<const char*>(indices.data() + indices.size()));
+          palette.indexedToRgba(
+            reader,
+            pixelCount,
+            rgbaImage,
+            PaletteTransparency::Index255Transparent,
+            averageColor);
+        }
+      },
+      fmt::format("convert {} {}x{} textures from reader", repetitions, size, size));
+  }
+}
+
+} // namespace tb::mdl
@@ -0,0 +1,134 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "mdl/Polyhedron.h"
+#include "mdl/Polyhedron3.h"
+#include "mdl/Polyhedron_Instantiation.h"
+
+#include "vm/bbox.h"
+#include "vm/plane.h"
+#include "vm/vec.h"
+
+#include <fmt/format.h>
+
+#include <vector>
+
+namespace tb::mdl
+{
+namespace
+{
+
+constexpr size_t NumPolyhedra = 64'000;
+constexpr size_t GridSize = 40;
+
+/**
+ * Returns the planes of a beveled cuboid, which is how brushes are built when a map is
+ * loaded: a polyhedron spanning the world bounds is clipped by every face plane.
+ */
+auto makePlanes(const size_t i)
+{
+  const auto min =
+    vm::vec3d{
+      double(i % GridSize),
+      double((i / GridSize) % GridSize),
+      double(i / (GridSize * GridSize))}
+      * 96.0
+    - vm::vec3d::fill(double(GridSize) * 48.0);
+  const auto max = min + vm::vec3d::fill(64.0);
+  const auto center = (min + max) / 2.0;
+
+  return std::vector<vm::plane3d>{
+    {min, vm::vec3d{-1, 0, 0}},
+    {min, vm::vec3d{0, -1, 0}},
+    {min, vm::vec3d{0, 0, -1}},
+    {max, vm::vec3d{1, 0, 0}},
+    {max, vm::vec3d{0, 1, 0}},
+    {max, vm::vec3d{0, 0, 1}},
+    {center + vm::vec3d{24, 24, 0}, vm::normalize(vm::vec3d{1, 1, 0})},
+    {center + vm::vec3d{-24, -24, 0}, vm::normalize(vm::vec3d{-1, -1, 0})},
+  };
+}
+
+} // namespace
+
+TEST_CASE("PolyhedronBenchmark.createAndCopy")
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+
+  auto planes = std::vector<std::vector<vm::plane3d>>{};
+  planes.reserve(NumPolyhedra);
+  for (size_t i = 0; i < NumPolyhedra; ++i)
+  {
+    planes.push_back(makePlanes(i));
+  }
+
+  auto polyhedra = std::vector<Polyhedron3>{};
+  polyhedra.reserve(NumPolyhedra);
+  timeLambda(
+    [&]() {
+      for (const auto& polyhedronPlanes : planes)
+      {
+        auto& polyhedron = polyhedra.emplace_back(worldBounds);
+        for (const auto& plane : polyhedronPlanes)
+        {
+          polyhedron.clip(plane);
+        }
+      }
+    },
+    fmt::format("create {} polyhedra by clipping", NumPolyhedra));
+
+  auto copies = std::vector<Polyhedron3>{};
+  copies.reserve(NumPolyhedra);
+  timeLambda(
+    [&]() {
+      for (const auto& polyhedron : polyhedra)
+      {
+        copies.push_back(polyhedron);
+      }
+    },
+    fmt::format("copy {} polyhedra", NumPolyhedra));
+
+  timeLambda(
+    [&]() {
+      copies.clear();
+      polyhedra.clear();
+    },
+    fmt::format("destroy {} polyhedra", 2 * NumPolyhedra));
+
+  // exercises the reuse of previously freed topology elements
+  timeLambda(
+    [&]() {
+      for (const auto& polyhedronPlanes : planes)
+      {
+        auto& polyhedron = polyhedra.emplace_back(worldBounds);
+        for (const auto& plane : polyhedronPlanes)
+        {
+          polyhedron.clip(plane);
+        }
+      }
+    },
+    fmt::format("recreate {} polyhedra by clipping", NumPolyhedra));
+
+  CHECK(polyhedra.size() == NumPolyhedra);
+  CHECK(polyhedra.front().faceCount() == 8u);
+}
+
+} // namespace tb::mdl
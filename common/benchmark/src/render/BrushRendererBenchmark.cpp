@@ -42,6 +42,7 @@ namespace
 {
 
 constexpr size_t NumBrushes = 64'000;
+constexpr size_t GridSize = 40;
 constexpr size_t NumMaterials = 256;
 
 /**
@@ -67,7 +68,17 @@ auto makeBrushes()
   size_t currentMaterialIndex = 0;
   for (size_t i = 0; i < NumBrushes; ++i)
   {
-    auto brush = builder.createCube(64.0, "") | kdl::value();
+    // spread the brushes over a grid so that they fall into different chunks
+    const auto position =
+      vm::vec3d{
+        double(i % GridSize),
+        double((i / GridSize) % GridSize),
+        double(i / (GridSize * GridSize))}
+        * 96.0
+      - vm::vec3d::fill(double(GridSize) * 48.0);
+    auto brush =
+      builder.createCuboid(vm::bbox3d{position, position + vm::vec3d::fill(64.0)}, "")
+      | kdl::value();
     for (auto& face : brush.faces())
     {
       face.setMaterial(&materials.at((currentMaterialIndex++) % NumMaterials));
@@ -96,7 +107,10 @@ TEST_CASE("BrushRendererBenchmark.benchBrushRenderer")
 {
   auto [brushes, materials] = makeBrushes();
 
+  const auto chunkSize = GENERATE(0.0, 1024.0);
+
   BrushRenderer r;
+  r.setChunkSize(chunkSize);
 
   timeLambda(
     [&]() {
@@ -105,7 +119,8 @@ TEST_CASE("BrushRendererBenchmark.benchBrushRenderer")
         r.addBrush(brush.get());
       }
     },
-    fmt::format("add {} brushes to BrushRenderer", brushes.size()));
+    fmt::format(
+      "add {} brushes to BrushRenderer with chunk size {}", brushes.size(), chunkSize));
   timeLambda(
     [&]() {
       if (!r.valid())
@@ -113,10 +128,24 @@ TEST_CASE("BrushRendererBenchmark.benchBrushRenderer")
         r.validate();
       }
     },
-    fmt::format("validate after adding {} brushes to BrushRenderer", brushes.size()));
+    fmt::format(
+      "validate after adding {} brushes to BrushRenderer with chunk size {}",
+      brushes.size(),
+      chunkSize));
+
+  // Tiny change: invalidate a single brush
+  timeLambda(
+    [&]() {
+      r.invalidateBrush(brushes.front().get());
+      r.validate();
+    },
+    fmt::format(
+      "validate one brush in {} chunks with chunk size {}", r.chunkCount(), chunkSize));
 
   // Tiny change: remove the last brush
-  timeLambda([&]() { r.removeBrush(brushes.back().get()); }, "call removeBrush once");
+  timeLambda(
+    [&]() { r.removeBrush(brushes.back().get()); },
+    fmt::format("call removeBrush once with chunk size {}", chunkSize));
   timeLambda(
     [&]() {
       if (!r.valid())
@@ -124,7 +153,7 @@ TEST_CASE("BrushRendererBenchmark.benchBrushRenderer")
         r.validate();
       }
     },
-    "validate after removing one brush");
+    fmt::format("validate after removing one brush with chunk size {}", chunkSize));
 
   // Large change: keep every second brush
   timeLambda(
@@ -137,7 +166,7 @@ TEST_CASE("BrushRendererBenchmark.benchBrushRenderer")
         }
       }
     },
-    "remove every second brush");
+    fmt::format("remove every second brush with chunk size {}", chunkSize));
 
   timeLambda(
     [&]() {
@@ -146,7 +175,7 @@ TEST_CASE("BrushRendererBenchmark.benchBrushRenderer")
         r.validate();
       }
     },
-    "validate remaining brushes");
+    fmt::format("validate remaining brushes with chunk size {}", chunkSize));
 }
 
 } // namespace tb::render
@@ -0,0 +1,147 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../test/src/Catch2.h"
+#include "BenchmarkUtils.h"
+#include "mdl/PickResult.h"
+#include "render/PerspectiveCamera.h"
+#include "ui/Lasso.h"
+#include "ui/VertexHandleManager.h"
+
+#include "vm/ray.h"
+#include "vm/vec.h"
+
+#include <fmt/format.h>
+
+#include <random>
+#include <vector>
+
+namespace tb::ui
+{
+namespace
+{
+
+constexpr size_t NumPicks = 1000;
+constexpr double HandleRadius = 3.0;
+
+auto makeCamera()
+{
+  return render::PerspectiveCamera{
+    90.0f,
+    1.0f,
+    8192.0f,
+    render::Camera::Viewport{0, 0, 1024, 768},
+    vm::vec3f{-4096.0f, 0.0f, 0.0f},
+    vm::vec3f{1.0f, 0.0f, 0.0f},
+    vm::vec3f{0.0f, 0.0f, 1.0f}};
+}
+
+auto makeHandles(const size_t count)
+{
+  auto rng = std::mt19937{0};
+  auto dist = std::uniform_real_distribution<double>{-2048.0, 2048.0};
+
+  auto result = std::vector<vm::vec3d>{};
+  result.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    result.emplace_back(dist(rng), dist(rng), dist(rng));
+  }
+  return result;
+}
+
+auto makePickRays(const render::Camera& camera)
+{
+  auto rng = std::mt19937{1};
+  auto x = std::uniform_real_distribution<float>{0.0f, 1024.0f};
+  auto y = std::uniform_real_distribution<float>{0.0f, 768.0f};
+
+  auto result = std::vector<vm::ray3d>{};
+  result.reserve(NumPicks);
+  for (size_t i = 0; i < NumPicks; ++i)
+  {
+    result.emplace_back(camera.pickRay(x(rng), y(rng)));
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("VertexHandleManagerBenchmark.pick")
+{
+  const auto handleCount = GENERATE(size_t(1'000), size_t(10'000), size_t(100'000));
+
+  const auto camera = makeCamera();
+  const auto pickRays = makePickRays(camera);
+  const auto handles = makeHandles(handleCount);
+
+  auto manager = VertexHandleManager{};
+  timeLambda(
+    [&]() {
+      for (const auto& handle : handles)
+      {
+        manager.add(handle);
+      }
+    },
+    fmt::format("add {} handles", handleCount));
+
+  auto indexedHits = size_t(0);
+  timeLambda(
+    [&]() {
+      for (const auto& pickRay : pickRays)
+      {
+        auto pickResult = mdl::PickResult{};
+        manager.pick(pickRay, camera, pickResult);
+        indexedHits += pickResult.size();
+      }
+    },
+    fmt::format("pick {} times among {} handles", NumPicks, handleCount));
+
+  // tests every handle, which is what VertexHandleManager::pick did before the handles
+  // were indexed
+  const auto allHandles = manager.allHandles();
+  auto linearHits = size_t(0);
+  timeLambda(
+    [&]() {
+      for (const auto& pickRay : pickRays)
+      {
+        for (const auto& handle : allHandles)
+        {
+          if (camera.pickPointHandle(pickRay, handle, HandleRadius))
+          {
+            ++linearHits;
+          }
+        }
+      }
+    },
+    fmt::format("pick {} times among {} handles without index", NumPicks, handleCount));
+
+  auto lasso = Lasso{camera, 1024.0, vm::vec3d{camera.defaultPoint(256.0f, 192.0f)}};
+  lasso.update(vm::vec3d{camera.defaultPoint(768.0f, 576.0f)});
+
+  auto candidateCount = size_t(0);
+  timeLambda(
+    [&]() { candidateCount = manager.findHandles(lasso.boundsTest()).size(); },
+    fmt::format("find lasso candidates among {} handles", handleCount));
+
+  CHECK(candidateCount <= handleCount);
+  CHECK(indexedHits == linearHits);
+}
+
+} // namespace tb::ui
@@ -23,13 +23,19 @@
 #include "io/DiskIO.h"
 #include "io/SystemPaths.h"
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 
 namespace tb
 {
 namespace
 {
 
+constexpr auto BufferCapacity = size_t(4096);
+constexpr auto FlushInterval = std::chrono::milliseconds{1000};
+constexpr auto MaxFlushWait = std::chrono::milliseconds{100};
+
 std::ofstream openLogFile(const std::filesystem::path& path)
 {
   return io::Disk::createDirectory(path.parent_path())
@@ -44,8 +50,20 @@ std::ofstream openLogFile(const std::filesystem::path& path)
 
 FileLogger::FileLogger(const std::filesystem::path& filePath)
   : m_stream{openLogFile(filePath)}
+  , m_buffer{BufferCapacity}
 {
   ensure(m_stream, "log file could not be opened");
+  m_writerThread = std::thread{[&]() { writeMessages(); }};
+}
+
+FileLogger::~FileLogger()
+{
+  {
+    const auto lock = std::lock_guard{m_mutex};
+    m_stopped = true;
+  }
+  m_writerCondition.notify_one();
+  m_writerThread.join();
 }
 
 FileLogger& FileLogger::instance()
@@ -54,12 +72,138 @@ FileLogger& FileLogger::instance()
   return Instance;
 }
 
+void FileLogger::flush()
+{
+  if (std::this_thread::get_id() == m_writerThread.get_id())
+  {
+    return;
+  }
+
+  auto lock = std::unique_lock{m_mutex};
+  m_flushRequestCount = std::max(m_flushRequestCount, m_pushedCount.load());
+  const auto flushGeneration = ++m_flushRequestGeneration;
+  m_writerCondition.notify_one();
+  m_flushedCondition.wait(
+    lock, [&]() { return m_flushedGeneration >= flushGeneration; });
+}
+
 void FileLogger::doLog(const LogLevel /* level */, const std::string_view message)
 {
-  assert(m_stream);
-  if (m_stream)
+  // count the message before publishing it so that a flush never misses a message that
+  // the writer has already seen
+  ++m_pushedCount;
+
+  auto str = std::string{message};
+  while (!m_buffer.try_push(std::move(str)))
+  {
+    // the buffer is full, let the writer catch up
+    m_writerCondition.notify_one();
+    std::this_thread::yield();
+  }
+
+  // Wake the writer if it has gone to sleep on an empty buffer. Together with the fence
+  // in writeMessages, this guarantees that the writer either sees the message or is woken
+  // up.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (m_writerIdle.exchange(false))
   {
-    m_stream << message << std::endl;
+    const auto lock = std::lock_guard{m_mutex};
+    m_writerCondition.notify_one();
+  }
+}
+
+void FileLogger::writeMessages()
+{
+  auto batch = std::string{};
+  auto writtenCount = size_t(0);
+  auto lastFlush = std::chrono::steady_clock::now();
+  auto dirty = false;
+
+  auto lock = std::unique_lock{m_mutex};
+  while (true)
+  {
+    const auto stopped = m_stopped;
+    const auto flushGeneration = m_flushRequestGeneration;
+    const auto mustFlush = stopped || m_flushedGeneration < flushGeneration;
+    const auto mustWriteCount = stopped ? m_pushedCount.load() : m_flushRequestCount;
+    lock.unlock();
+
+    // a producer may have counted a message without having published it yet, so keep
+    // draining until all messages that must be flushed have arrived, but give up after a
+    // while in case the producer crashed, e.g. when the crash reporter flushes the log
+    const auto flushDeadline = std::chrono::steady_clock::now() + MaxFlushWait;
+    while (true)
+    {
+      while (auto message = m_buffer.try_pop())
+      {
+        batch += *message;
+        batch += '\n';
+        ++writtenCount;
+      }
+
+      if (
+        !mustFlush || writtenCount >= mustWriteCount
+        || std::chrono::steady_clock::now() >= flushDeadline)
+      {
+        break;
+      }
+      std::this_thread::yield();
+    }
+
+    const auto idle = batch.empty();
+    if (!idle)
+    {
+      assert(m_stream);
+      m_stream << batch;
+      batch.clear();
+      dirty = true;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    if (dirty && (idle || mustFlush || now - lastFlush >= FlushInterval))
+    {
+      m_stream.flush();
+      lastFlush = now;
+      dirty = false;
+    }
+
+    lock.lock();
+    if (mustFlush)
+    {
+      m_flushedGeneration = flushGeneration;
+      m_flushedCondition.notify_all();
+    }
+
+    if (stopped)
+    {
+      return;
+    }
+
+    if (!idle)
+    {
+      // check for more messages before going to sleep
+      continue;
+    }
+
+    // The buffer was empty and the file has been flushed. Announce that the writer is
+    // going to sleep, then check the buffer once more for a message whose producer
+    // didn't see the announcement.
+    m_writerIdle = true;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (auto message = m_buffer.try_pop())
+    {
+      m_writerIdle = false;
+      batch += *message;
+      batch += '\n';
+      ++writtenCount;
+      continue;
+    }
+
+    m_writerCondition.wait(lock, [&]() {
+      return m_stopped || m_flushedGeneration < m_flushRequestGeneration
+             || !m_writerIdle;
+    });
+    m_writerIdle = false;
   }
 }
 
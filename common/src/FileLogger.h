@@ -22,25 +22,70 @@
 #include "Logger.h"
 #include "Macros.h"
 
+#include "kdl/mpsc_ring_buffer.h"
+
+#include <atomic>
+#include <condition_variable>
 #include <filesystem>
 #include <fstream>
+#include <mutex>
+#include <string>
 #include <string_view>
+#include <thread>
 
 namespace tb
 {
 
+/**
+ * Writes log messages to a file.
+ *
+ * Logging a message only appends it to a bounded lock free ring buffer. A writer thread
+ * drains the buffer and writes the messages in batches. When the buffer is empty, the
+ * writer sleeps until a logging thread wakes it up, which only happens for the first
+ * message after the writer went to sleep. The file is flushed before the writer goes to
+ * sleep, at least once per flush interval while messages keep arriving, when flush() is
+ * called, and when the logger is destroyed.
+ *
+ * If the ring buffer is full, the logging thread waits until the writer has made room
+ * for the message, so no messages are dropped.
+ *
+ * A flush waits only for a limited time for messages whose logging threads have not
+ * finished appending them, because such a thread may have crashed while doing so.
+ */
 class FileLogger : public Logger
 {
 private:
   std::ofstream m_stream;
+  kdl::mpsc_ring_buffer<std::string> m_buffer;
+  std::atomic<size_t> m_pushedCount = 0;
+  std::atomic<bool> m_writerIdle = false;
+
+  std::mutex m_mutex;
+  std::condition_variable m_writerCondition;
+  std::condition_variable m_flushedCondition;
+  size_t m_flushRequestCount = 0;
+  size_t m_flushRequestGeneration = 0;
+  size_t m_flushedGeneration = 0;
+  bool m_stopped = false;
+
+  // started once the log file is open
+  std::thread m_writerThread;
 
 public:
   explicit FileLogger(const std::filesystem::path& filePath);
+  ~FileLogger() override;
 
   static FileLogger& instance();
 
+  /**
+   * Blocks until all messages that were logged before this call are written to the log
+   * file and the file is flushed. Does nothing when called from the writer thread.
+   */
+  void flush();
+
 private:
   void doLog(LogLevel level, std::string_view message) override;
+  void writeMessages();
 
   deleteCopyAndMove(FileLogger);
 };
@@ -181,9 +181,12 @@ Preference<Color> GridColor2D("Rendere/Grid/Color2D", Color(0.8f, 0.8f, 0.8f, 0.
 Preference<int> TextureMinFilter("render/Texture mode min filter", 0x2700);
 Preference<int> TextureMagFilter("render/Texture mode mag filter", 0x2600);
 Preference<bool> EnableMSAA("render/Enable multisampling", true);
+Preference<bool> TextureCacheEnabled("render/Enable texture cache", true);
+Preference<int> TextureCacheSize("render/Texture cache size", 1024);
 
 Preference<bool> AlignmentLock("Editor/Texture lock", true);
 Preference<bool> UVLock("Editor/UV lock", false);
+Preference<int> UndoMemoryBudget("Editor/Undo memory budget", 512);
 
 Preference<std::filesystem::path>& RendererFontPath()
 {
@@ -376,8 +379,11 @@ const std::vector<PreferenceBase*>& staticPreferences()
     &GridColor2D,
     &TextureMinFilter,
     &TextureMagFilter,
+    &TextureCacheEnabled,
+    &TextureCacheSize,
     &AlignmentLock,
     &UVLock,
+    &UndoMemoryBudget,
     &RendererFontPath(),
     &RendererFontSize,
     &BrowserFontSize,
@@ -127,9 +127,21 @@ extern Preference<int> TextureMinFilter;
 extern Preference<int> TextureMagFilter;
 extern Preference<bool> EnableMSAA;
 
+/**
+ * Whether decoded textures are cached in the user data directory, and the maximum size
+ * of the cache in megabytes.
+ */
+extern Preference<bool> TextureCacheEnabled;
+extern Preference<int> TextureCacheSize;
+
 extern Preference<bool> AlignmentLock;
 extern Preference<bool> UVLock;
 
+/**
+ * The maximum memory in megabytes that the undo history may hold, or 0 for no limit.
+ */
+extern Preference<int> UndoMemoryBudget;
+
 Preference<std::filesystem::path>& RendererFontPath();
 extern Preference<int> RendererFontSize;
 
@@ -20,6 +20,7 @@
 #include "TrenchBroomApp.h"
 
 #include "Exceptions.h"
+#include "FileLogger.h"
 #include "PreferenceManager.h"
 #include "Preferences.h"
 #include "Result.h"
@@ -740,7 +741,8 @@ void reportCrashAndExit(const std::string& stacktrace, const std::string& reason
       mapPath = std::filesystem::path{};
     }
 
-    // Copy the log file
+    // Copy the log file after writing all pending messages
+    FileLogger::instance().flush();
     if (!QFile::copy(
           io::pathAsQString(io::SystemPaths::logFilePath()), io::pathAsQString(logPath)))
     {
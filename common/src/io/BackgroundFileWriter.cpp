@@ -0,0 +1,93 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BackgroundFileWriter.h"
+
+#include "io/DiskIO.h"
+
+#include "kdl/reflection_impl.h"
+#include "kdl/result.h"
+
+#include <chrono>
+
+namespace tb::io
+{
+
+kdl_reflect_impl(BackgroundFileWriterProgress);
+
+BackgroundFileWriter::BackgroundFileWriter() = default;
+
+BackgroundFileWriter::~BackgroundFileWriter()
+{
+  wait();
+}
+
+bool BackgroundFileWriter::write(std::filesystem::path path, std::string contents)
+{
+  if (busy())
+  {
+    return false;
+  }
+
+  m_bytesWritten = 0;
+  m_bytesTotal = contents.size();
+
+  m_result = std::async(
+    std::launch::async,
+    [this, path = std::move(path), contents = std::move(contents)]() {
+      return Disk::writeFileAtomically(
+               path, contents, [this](const auto bytesWritten) {
+                 m_bytesWritten = bytesWritten;
+               })
+             | kdl::transform([&]() { return path; });
+    });
+
+  return true;
+}
+
+bool BackgroundFileWriter::busy() const
+{
+  return m_result.valid()
+         && m_result.wait_for(std::chrono::seconds{0}) != std::future_status::ready;
+}
+
+BackgroundFileWriterProgress BackgroundFileWriter::progress() const
+{
+  return {m_bytesWritten, m_bytesTotal};
+}
+
+void BackgroundFileWriter::wait() const
+{
+  if (m_result.valid())
+  {
+    m_result.wait();
+  }
+}
+
+std::optional<Result<std::filesystem::path>> BackgroundFileWriter::takeResult()
+{
+  if (!m_result.valid() || busy())
+  {
+    return std::nullopt;
+  }
+
+  return m_result.get();
+}
+
+} // namespace tb::io
@@ -0,0 +1,104 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Macros.h"
+#include "Result.h"
+
+#include "kdl/reflection_decl.h"
+
+#include <atomic>
+#include <filesystem>
+#include <future>
+#include <optional>
+#include <string>
+
+namespace tb::io
+{
+
+struct BackgroundFileWriterProgress
+{
+  /** The number of bytes of the current file that have been written so far. */
+  size_t bytesWritten = 0;
+  /** The size of the current file in bytes. */
+  size_t bytesTotal = 0;
+
+  kdl_reflect_decl(BackgroundFileWriterProgress, bytesWritten, bytesTotal);
+};
+
+/**
+ * Writes files on a background thread, one at a time.
+ *
+ * The caller produces the file contents on its own thread, e.g. by serializing data that
+ * must not be accessed concurrently, and hands them off to this writer. The files are
+ * written using Disk::writeFileAtomically, so a file is never left partially written.
+ *
+ * Only one write can be in flight at any time. The result of a write must be retrieved
+ * by polling takeResult.
+ */
+class BackgroundFileWriter
+{
+private:
+  std::atomic<size_t> m_bytesWritten = 0;
+  std::atomic<size_t> m_bytesTotal = 0;
+  std::future<Result<std::filesystem::path>> m_result;
+
+public:
+  BackgroundFileWriter();
+
+  /**
+   * Waits for the pending write to finish.
+   */
+  ~BackgroundFileWriter();
+
+  deleteCopyAndMove(BackgroundFileWriter);
+
+  /**
+   * Starts writing the given contents to the given path. Returns false and does nothing
+   * if a write is still in progress.
+   *
+   * The result of a previous write that has not been retrieved is discarded.
+   */
+  bool write(std::filesystem::path path, std::string contents);
+
+  /**
+   * Indicates whether a write is still in progress.
+   */
+  bool busy() const;
+
+  /**
+   * Returns the progress of the current or the last write.
+   */
+  BackgroundFileWriterProgress progress() const;
+
+  /**
+   * Blocks until the pending write, if any, has finished.
+   */
+  void wait() const;
+
+  /**
+   * Returns the path of the written file or an error once the last write has finished.
+   * Returns std::nullopt if the write is still in progress or if its result was already
+   * taken.
+   */
+  std::optional<Result<std::filesystem::path>> takeResult();
+};
+
+} // namespace tb::io
@@ -0,0 +1,78 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BufferedParserStatus.h"
+
+#include "Logger.h"
+
+#include <algorithm>
+#include <string>
+
+namespace tb::io
+{
+
+CombinedParserProgress::CombinedParserProgress(ParserStatus& target)
+  : m_target{target}
+{
+}
+
+void CombinedParserProgress::add(const double amount)
+{
+  const auto lock = std::lock_guard{m_mutex};
+  m_progress = std::min(m_progress + amount, 1.0);
+  if (m_progress - m_reportedProgress >= 0.01)
+  {
+    m_reportedProgress = m_progress;
+    m_target.progress(m_reportedProgress);
+  }
+}
+
+BufferedParserStatus::BufferedParserStatus(
+  ParserStatus& target, CombinedParserProgress& combinedProgress, const double weight)
+  : ParserStatus{target.m_logger, target.m_prefix}
+  , m_target{target}
+  , m_combinedProgress{combinedProgress}
+  , m_weight{weight}
+{
+}
+
+void BufferedParserStatus::flush()
+{
+  for (const auto& [level, str] : m_messages)
+  {
+    m_target.doLog(level, str);
+  }
+  m_messages.clear();
+}
+
+void BufferedParserStatus::doProgress(const double progress)
+{
+  if (progress > m_progress)
+  {
+    m_combinedProgress.add((progress - m_progress) * m_weight);
+    m_progress = progress;
+  }
+}
+
+void BufferedParserStatus::doLog(const LogLevel level, const std::string& str)
+{
+  m_messages.emplace_back(level, str);
+}
+
+} // namespace tb::io
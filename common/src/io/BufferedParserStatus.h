@@ -0,0 +1,90 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "io/ParserStatus.h"
+
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace tb::io
+{
+
+/**
+ * Combines the progress of several parser statuses that each parse a part of the same
+ * input and forwards it to a target status. Progress can be added from multiple threads,
+ * and the target status is updated by one thread at a time.
+ */
+class CombinedParserProgress
+{
+private:
+  ParserStatus& m_target;
+  std::mutex m_mutex;
+  double m_progress = 0.0;
+  double m_reportedProgress = 0.0;
+
+public:
+  explicit CombinedParserProgress(ParserStatus& target);
+
+  /**
+   * Adds the given amount to the combined progress. The target status is only updated
+   * once the progress has advanced by at least one percent.
+   */
+  void add(double amount);
+};
+
+/**
+ * Records the messages logged to it so that they can be forwarded to another parser
+ * status later. The messages are formatted with the prefix of the target status, so
+ * forwarding them yields exactly the messages that would have been logged to the target
+ * status directly.
+ *
+ * This is useful when parsing parts of a file concurrently, where every part gets its own
+ * buffered status and the messages are forwarded in file order afterwards. The progress
+ * of every part is added to a combined progress right away, weighted by the part's share
+ * of the input.
+ */
+class BufferedParserStatus : public ParserStatus
+{
+private:
+  ParserStatus& m_target;
+  CombinedParserProgress& m_combinedProgress;
+  double m_weight;
+  double m_progress = 0.0;
+  std::vector<std::tuple<LogLevel, std::string>> m_messages;
+
+public:
+  BufferedParserStatus(
+    ParserStatus& target, CombinedParserProgress& combinedProgress, double weight);
+
+  /**
+   * Forwards the recorded messages to the target status in the order in which they were
+   * logged and clears them.
+   */
+  void flush();
+
+private:
+  void doProgress(double progress) override;
+  void doLog(LogLevel level, const std::string& str) override;
+};
+
+} // namespace tb::io
@@ -83,6 +83,12 @@ Result<std::shared_ptr<File>> DiskFileSystem::doOpenFile(
            [](auto cFile) { return std::static_pointer_cast<File>(cFile); });
 }
 
+Result<std::filesystem::path> DiskFileSystem::doGetContainerPath(
+  const std::filesystem::path& path) const
+{
+  return makeAbsolute(path) | kdl::transform(Disk::fixPath);
+}
+
 WritableDiskFileSystem::WritableDiskFileSystem(const std::filesystem::path& root)
   : DiskFileSystem{root}
 {
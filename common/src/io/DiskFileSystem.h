@@ -49,6 +49,8 @@ protected:
     const std::filesystem::path& path, const TraversalMode& traversalMode) const override;
   Result<std::shared_ptr<File>> doOpenFile(
     const std::filesystem::path& path) const override;
+  Result<std::filesystem::path> doGetContainerPath(
+    const std::filesystem::path& path) const override;
 };
 
 #ifdef _MSC_VER
@@ -25,9 +25,29 @@
 #include "io/PathInfo.h"
 #include "io/TraversalMode.h"
 
+#include "kdl/path_hash.h"
 #include "kdl/path_utils.h"
 #include "kdl/string_format.h"
 
+#include <algorithm>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 namespace tb::io::Disk
 {
 namespace
@@ -42,6 +62,120 @@ bool doCheckCaseSensitive()
          || !std::filesystem::exists(kdl::str_to_upper(cwd.string()));
 }
 
+/**
+ * Maps the lower case names of the entries of a directory to their actual names.
+ *
+ * The index of a directory is built when it is first needed and rebuilt when the
+ * modification time of the directory changes, which happens whenever an entry is
+ * added, removed or renamed. Since an entry may be added within the timestamp
+ * resolution of the file system without changing the modification time, the index is
+ * also rebuilt when a name cannot be found in it. The indices are shared by all callers
+ * of fixPath. Only the most recently used directories are kept.
+ *
+ * Directories are listed without holding the lock, so that a slow listing does not
+ * block other threads.
+ */
+class DirectoryIndex
+{
+private:
+  using NameMap =
+    std::unordered_map<std::filesystem::path, std::filesystem::path, kdl::path_hash>;
+
+  struct Entry
+  {
+    std::filesystem::file_time_type modificationTime;
+    NameMap names;
+    std::list<std::filesystem::path>::iterator lruPosition;
+  };
+
+  static constexpr size_t MaxEntries = 1024;
+
+  std::mutex m_mutex;
+  std::unordered_map<std::filesystem::path, Entry, kdl::path_hash> m_entries;
+  // most recently used directory first
+  std::list<std::filesystem::path> m_lru;
+
+public:
+  std::optional<std::filesystem::path> findEntryName(
+    const std::filesystem::path& directoryPath, const std::filesystem::path& lowerName)
+  {
+    const auto modificationTime = std::filesystem::last_write_time(directoryPath);
+
+    {
+      const auto lock = std::lock_guard{m_mutex};
+      if (const auto entryIt = m_entries.find(directoryPath);
+          entryIt != m_entries.end()
+          && entryIt->second.modificationTime == modificationTime)
+      {
+        auto& entry = entryIt->second;
+        m_lru.splice(m_lru.begin(), m_lru, entry.lruPosition);
+        if (auto result = findName(entry.names, lowerName))
+        {
+          return result;
+        }
+      }
+    }
+
+    auto names = buildNameMap(directoryPath);
+    auto result = findName(names, lowerName);
+
+    const auto lock = std::lock_guard{m_mutex};
+    storeEntry(directoryPath, modificationTime, std::move(names));
+    return result;
+  }
+
+private:
+  static NameMap buildNameMap(const std::filesystem::path& directoryPath)
+  {
+    auto result = NameMap{};
+    for (const auto& entry : std::filesystem::directory_iterator{directoryPath})
+    {
+      const auto name = entry.path().filename();
+      result.emplace(kdl::path_to_lower(name), name);
+    }
+    return result;
+  }
+
+  static std::optional<std::filesystem::path> findName(
+    const NameMap& names, const std::filesystem::path& lowerName)
+  {
+    const auto nameIt = names.find(lowerName);
+    return nameIt != names.end() ? std::optional{nameIt->second} : std::nullopt;
+  }
+
+  void storeEntry(
+    const std::filesystem::path& directoryPath,
+    const std::filesystem::file_time_type modificationTime,
+    NameMap names)
+  {
+    auto [entryIt, inserted] = m_entries.try_emplace(directoryPath);
+    auto& entry = entryIt->second;
+    if (inserted)
+    {
+      m_lru.push_front(directoryPath);
+      entry.lruPosition = m_lru.begin();
+    }
+    else
+    {
+      m_lru.splice(m_lru.begin(), m_lru, entry.lruPosition);
+    }
+    entry.modificationTime = modificationTime;
+    entry.names = std::move(names);
+
+    while (m_entries.size() > MaxEntries)
+    {
+      m_entries.erase(m_lru.back());
+      m_lru.pop_back();
+    }
+  }
+};
+
+DirectoryIndex& directoryIndex()
+{
+  static auto index = DirectoryIndex{};
+  return index;
+}
+
 std::filesystem::path fixCase(const std::filesystem::path& path)
 {
   try
@@ -59,19 +193,13 @@ std::filesystem::path fixCase(const std::filesystem::path& path)
     while (!remainder.empty())
     {
       const auto nameToFind = kdl::path_front(remainder);
-      const auto entryIt = std::find_if(
-        std::filesystem::directory_iterator{result},
-        std::filesystem::directory_iterator{},
-        [&](const auto& entry) {
-          return nameToFind == kdl::path_to_lower(entry.path().filename());
-        });
-
-      if (entryIt == std::filesystem::directory_iterator{})
+      const auto entryName = directoryIndex().findEntryName(result, nameToFind);
+      if (!entryName)
       {
         return path;
       }
 
-      result = result / entryIt->path().filename();
+      result = result / *entryName;
       remainder = kdl::path_pop_front(remainder);
     }
     return result;
@@ -82,6 +210,74 @@ std::filesystem::path fixCase(const std::filesystem::path& path)
   }
 }
 
+Result<std::filesystem::path> fixFilePath(const std::filesystem::path& path)
+{
+  const auto fixedPath = fixPath(path);
+  if (pathInfo(fixedPath) != PathInfo::File)
+  {
+    return Error{
+      "Failed to open '" + fixedPath.string() + "': path does not denote a file"};
+  }
+  return fixedPath;
+}
+
+/**
+ * Flushes the contents of the given file to the disk so that they survive a crash or a
+ * power loss. Flushing the stream only hands them to the operating system.
+ */
+Result<void> syncFile(const std::filesystem::path& path)
+{
+#ifdef _WIN32
+  const auto handle = CreateFileW(
+    path.c_str(),
+    GENERIC_WRITE,
+    FILE_SHARE_READ | FILE_SHARE_WRITE,
+    nullptr,
+    OPEN_EXISTING,
+    FILE_ATTRIBUTE_NORMAL,
+    nullptr);
+  if (handle == INVALID_HANDLE_VALUE)
+  {
+    return Error{"Could not open file '" + path.string() + "' for flushing"};
+  }
+
+  const auto success = FlushFileBuffers(handle);
+  CloseHandle(handle);
+#else
+  const auto fd = open(path.c_str(), O_WRONLY);
+  if (fd == -1)
+  {
+    return Error{"Could not open file '" + path.string() + "' for flushing"};
+  }
+
+  const auto success = fsync(fd) == 0;
+  close(fd);
+#endif
+
+  if (!success)
+  {
+    return Error{"Could not flush file '" + path.string() + "'"};
+  }
+  return kdl::void_success;
+}
+
+/**
+ * Flushes the entries of the given directory to the disk so that a file that was renamed
+ * into it survives a crash. Windows does not support this, and failures are ignored
+ * because the file itself has already been flushed.
+ */
+void syncDirectory([[maybe_unused]] const std::filesystem::path& path)
+{
+#ifndef _WIN32
+  const auto fd = open(path.c_str(), O_RDONLY | O_DIRECTORY);
+  if (fd != -1)
+  {
+    fsync(fd);
+    close(fd);
+  }
+#endif
+}
+
 } // namespace
 
 bool isCaseSensitive()
@@ -143,16 +339,69 @@ Result<std::vector<std::filesystem::path>> find(
   return result;
 }
 
-Result<std::shared_ptr<CFile>> openFile(const std::filesystem::path& path)
+Result<std::shared_ptr<MappedFile>> openFile(const std::filesystem::path& path)
+{
+  return fixFilePath(path) | kdl::and_then(createMappedFile);
+}
+
+Result<std::shared_ptr<CFile>> openCFile(const std::filesystem::path& path)
 {
+  return fixFilePath(path) | kdl::and_then(createCFile);
+}
+
+Result<void> writeFileAtomically(
+  const std::filesystem::path& path,
+  const std::string_view contents,
+  const std::function<void(size_t)>& progress)
+{
+  constexpr auto ChunkSize = size_t(1024 * 1024);
+
   const auto fixedPath = fixPath(path);
-  if (pathInfo(fixedPath) != PathInfo::File)
+  const auto tempPath = kdl::path_add_extension(fixedPath, ".tmp");
+
+  auto result = withOutputStream(tempPath, [&](auto& stream) -> Result<void> {
+    for (size_t offset = 0; offset < contents.size(); offset += ChunkSize)
+    {
+      const auto count = std::min(ChunkSize, contents.size() - offset);
+      stream.write(contents.data() + offset, std::streamsize(count));
+      if (!stream)
+      {
+        return Error{"Could not write file '" + tempPath.string() + "'"};
+      }
+
+      if (progress)
+      {
+        progress(offset + count);
+      }
+    }
+
+    stream.flush();
+    if (!stream)
+    {
+      return Error{"Could not write file '" + tempPath.string() + "'"};
+    }
+    return kdl::void_success;
+  }) | kdl::and_then([&]() { return syncFile(tempPath); });
+
+  if (result.is_success())
   {
-    return Error{
-      "Failed to open '" + fixedPath.string() + "': path does not denote a file"};
+    auto error = std::error_code{};
+    std::filesystem::rename(tempPath, fixedPath, error);
+    if (!error)
+    {
+      syncDirectory(fixedPath.parent_path());
+      return kdl::void_success;
+    }
+
+    result = Error{
+      "Failed to move '" + tempPath.string() + "' to '" + fixedPath.string()
+      + "': " + error.message()};
   }
 
-  return createCFile(fixedPath);
+  // ignore errors
+  auto error = std::error_code{};
+  std::filesystem::remove(tempPath, error);
+  return result;
 }
 
 Result<bool> createDirectory(const std::filesystem::path& path)
@@ -27,8 +27,10 @@
 
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <memory>
 #include <string>
+#include <string_view>
 
 namespace tb::io
 {
@@ -48,7 +50,18 @@ Result<std::vector<std::filesystem::path>> find(
   const TraversalMode& traversalMode,
   const PathMatcher& pathMatcher = matchAnyPath);
 
-Result<std::shared_ptr<CFile>> openFile(const std::filesystem::path& path);
+/**
+ * Opens the given file by mapping it into memory. See MappedFile for the caveats of
+ * keeping a mapping.
+ */
+Result<std::shared_ptr<MappedFile>> openFile(const std::filesystem::path& path);
+
+/**
+ * Opens the given file without mapping it. Reading copies the data into the caller's
+ * buffers, and other processes may truncate the file while it is open without crashing
+ * the program.
+ */
+Result<std::shared_ptr<CFile>> openCFile(const std::filesystem::path& path);
 
 template <typename Stream, typename F>
 auto withStream(
@@ -119,6 +132,19 @@ auto withOutputStream(const std::filesystem::path& path, const F& function)
   return withStream<std::ofstream>(path, std::ios_base::out, function);
 }
 
+/**
+ * Writes the given contents to a temporary file next to the given path and then renames
+ * the temporary file to the given path. If the given file exists, it is replaced, but it
+ * is never left partially written.
+ *
+ * If a progress function is given, it is called with the number of bytes written so far
+ * after every chunk that was written.
+ */
+Result<void> writeFileAtomically(
+  const std::filesystem::path& path,
+  std::string_view contents,
+  const std::function<void(size_t)>& progress = {});
+
 Result<bool> createDirectory(const std::filesystem::path& path);
 
 Result<bool> deleteFile(const std::filesystem::path& path);
@@ -158,4 +158,11 @@ Result<void> DkPakFileSystem::doReadDirectory()
     return Error{e.what()};
   }
 }
+
+Result<std::filesystem::path> DkPakFileSystem::doGetContainerPath(
+  const std::filesystem::path&) const
+{
+  return m_file->path();
+}
+
 } // namespace tb::io
@@ -24,14 +24,16 @@
 
 namespace tb::io
 {
-class CFile;
+class MappedFile;
 
-class DkPakFileSystem : public ImageFileSystem<CFile>
+class DkPakFileSystem : public ImageFileSystem<MappedFile>
 {
 public:
   using ImageFileSystem::ImageFileSystem;
 
 private:
   Result<void> doReadDirectory() override;
+  Result<std::filesystem::path> doGetContainerPath(
+    const std::filesystem::path& path) const override;
 };
 } // namespace tb::io
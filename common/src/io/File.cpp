@@ -22,9 +22,25 @@
 #
 #include "kdl/result.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace tb::io
 {
 
@@ -102,8 +118,10 @@ Result<size_t> fileSize(std::FILE* file)
 }
 } // namespace
 
-CFile::CFile(kdl::resource<std::FILE*> file, const size_t size)
-  : m_file{std::move(file)}
+CFile::CFile(
+  std::filesystem::path path, kdl::resource<std::FILE*> file, const size_t size)
+  : m_path{std::move(path)}
+  , m_file{std::move(file)}
   , m_size{size}
 {
 }
@@ -118,6 +136,11 @@ size_t CFile::size() const
   return m_size;
 }
 
+const std::filesystem::path& CFile::path() const
+{
+  return m_path;
+}
+
 std::FILE* CFile::file() const
 {
   return *m_file;
@@ -185,14 +208,164 @@ Error CFile::makeError(const std::string& msg) const
 
 Result<std::shared_ptr<CFile>> createCFile(const std::filesystem::path& path)
 {
-  return openPathAsFILE(path, "rb") | kdl::and_then([](auto file) {
+  return openPathAsFILE(path, "rb") | kdl::and_then([&](auto file) {
            return fileSize(*file) | kdl::transform([&](auto size) {
                     // NOLINTNEXTLINE
-                    return std::shared_ptr<CFile>{new CFile{std::move(file), size}};
+                    return std::shared_ptr<CFile>{new CFile{path, std::move(file), size}};
                   });
          });
 }
 
+MappedFile::MappedFile(
+  std::filesystem::path path, const char* begin, const size_t size)
+  : m_path{std::move(path)}
+  , m_begin{begin}
+  , m_size{size}
+{
+}
+
+MappedFile::~MappedFile()
+{
+  if (m_begin)
+  {
+#ifdef _WIN32
+    UnmapViewOfFile(m_begin);
+#else
+    munmap(const_cast<char*>(m_begin), m_size);
+#endif
+  }
+}
+
+Reader MappedFile::reader() const
+{
+  return Reader::from(shared_from_this(), begin(), end());
+}
+
+size_t MappedFile::size() const
+{
+  return m_size;
+}
+
+const std::filesystem::path& MappedFile::path() const
+{
+  return m_path;
+}
+
+const char* MappedFile::begin() const
+{
+  return m_begin;
+}
+
+const char* MappedFile::end() const
+{
+  return m_begin + m_size;
+}
+
+std::unique_ptr<OwningBufferFile> MappedFile::buffer() const
+{
+  auto buffer = std::make_unique<char[]>(m_size);
+  std::copy(begin(), end(), buffer.get());
+  return std::make_unique<OwningBufferFile>(std::move(buffer), m_size);
+}
+
+Result<std::shared_ptr<MappedFile>> createMappedFile(const std::filesystem::path& path)
+{
+#ifdef _WIN32
+  auto file = kdl::resource{
+    CreateFileW(
+      path.wstring().c_str(),
+      GENERIC_READ,
+      // other processes cannot write to the file while it is mapped
+      FILE_SHARE_READ,
+      nullptr,
+      OPEN_EXISTING,
+      FILE_ATTRIBUTE_NORMAL,
+      nullptr),
+    [](auto handle) {
+      if (handle != INVALID_HANDLE_VALUE)
+      {
+        CloseHandle(handle);
+      }
+    }};
+  if (*file == INVALID_HANDLE_VALUE)
+  {
+    return Error{"Cannot open file " + path.string()};
+  }
+
+  auto fileSize = LARGE_INTEGER{};
+  if (!GetFileSizeEx(*file, &fileSize))
+  {
+    return Error{"Cannot determine size of file " + path.string()};
+  }
+
+  const auto size = static_cast<size_t>(fileSize.QuadPart);
+  if (size == 0)
+  {
+    // NOLINTNEXTLINE
+    return std::shared_ptr<MappedFile>{new MappedFile{path, nullptr, 0}};
+  }
+
+  // the view keeps the mapping alive, so both handles can be closed once it is mapped
+  auto mapping = kdl::resource{
+    CreateFileMappingW(*file, nullptr, PAGE_READONLY, 0, 0, nullptr),
+    [](auto handle) {
+      if (handle)
+      {
+        CloseHandle(handle);
+      }
+    }};
+  if (!mapping)
+  {
+    return Error{"Cannot map file " + path.string()};
+  }
+
+  const auto* begin =
+    static_cast<const char*>(MapViewOfFile(*mapping, FILE_MAP_READ, 0, 0, 0));
+  if (!begin)
+  {
+    return Error{"Cannot map file " + path.string()};
+  }
+#else
+  auto file = kdl::resource{open(path.c_str(), O_RDONLY | O_CLOEXEC), [](auto fd) {
+    if (fd >= 0)
+    {
+      close(fd);
+    }
+  }};
+  if (*file < 0)
+  {
+    return Error{"Cannot open file " + path.string() + ": " + std::strerror(errno)};
+  }
+
+  struct stat fileStat;
+  if (fstat(*file, &fileStat) != 0)
+  {
+    return Error{
+      "Cannot determine size of file " + path.string() + ": " + std::strerror(errno)};
+  }
+
+  const auto size = static_cast<size_t>(fileStat.st_size);
+  if (size == 0)
+  {
+    // mmap fails for empty files
+    // NOLINTNEXTLINE
+    return std::shared_ptr<MappedFile>{new MappedFile{path, nullptr, 0}};
+  }
+
+  // the mapping remains valid after the file descriptor is closed
+  auto* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, *file, 0);
+  if (addr == MAP_FAILED)
+  {
+    return Error{"Cannot map file " + path.string() + ": " + std::strerror(errno)};
+  }
+
+  const auto* begin = static_cast<const char*>(addr);
+#endif
+
+  // NOLINTNEXTLINE
+  return std::shared_ptr<MappedFile>{new MappedFile{path, begin, size}};
+}
+
 FileView::FileView(std::shared_ptr<File> file, const size_t offset, const size_t length)
   : m_file{std::move(file)}
   , m_offset{offset}
@@ -93,14 +93,15 @@ public:
   using BufferType = std::shared_ptr<char[]>;
 #endif
 private:
+  std::filesystem::path m_path;
   kdl::resource<std::FILE*> m_file;
   size_t m_size;
   mutable std::mutex m_mutex;
 
   /**
-   * Creates a new file with the given file ptr and size in bytes.
+   * Creates a new file with the given path, file ptr and size in bytes.
    */
-  CFile(kdl::resource<std::FILE*> file, size_t size);
+  CFile(std::filesystem::path path, kdl::resource<std::FILE*> file, size_t size);
 
 public:
   friend Result<std::shared_ptr<CFile>> createCFile(const std::filesystem::path& path);
@@ -108,6 +109,11 @@ public:
   Reader reader() const override;
   size_t size() const override;
 
+  /**
+   * Returns the path of the file on the disk.
+   */
+  const std::filesystem::path& path() const;
+
   /**
    * Returns the underlying file.
    */
@@ -126,6 +132,70 @@ private:
 
 Result<std::shared_ptr<CFile>> createCFile(const std::filesystem::path& path);
 
+/**
+ * A file that is backed by a physical file on the disk which is mapped into memory. The
+ * file is mapped in its entirety when it is created and unmapped in the destructor.
+ *
+ * Readers created by this file, including readers of file views into this file, access
+ * the mapped memory directly. Reading does not copy the data through a buffer and does
+ * not require any synchronization. Buffering a reader returns a view of the mapped
+ * memory. Every such reader keeps the mapping alive, so a reader may outlive the file
+ * object it was created from.
+ *
+ * Replacing a mapped file, e.g. by writing a new file and renaming it over the old one,
+ * is safe on POSIX systems because the mapping keeps referring to the old file. If
+ * another process truncates the file in place while it is mapped, reading the truncated
+ * part crashes the program (SIGBUS). On Windows, the file is opened without write
+ * sharing, so other processes cannot modify or replace it while it is mapped.
+ */
+class MappedFile : public File, public std::enable_shared_from_this<MappedFile>
+{
+private:
+  std::filesystem::path m_path;
+  const char* m_begin;
+  size_t m_size;
+
+  /**
+   * Creates a new file with the given path for the given mapped memory region. An empty
+   * file is represented by a null pointer and a size of 0.
+   */
+  MappedFile(std::filesystem::path path, const char* begin, size_t size);
+
+public:
+  friend Result<std::shared_ptr<MappedFile>> createMappedFile(
+    const std::filesystem::path& path);
+
+  ~MappedFile() override;
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  Reader reader() const override;
+  size_t size() const override;
+
+  /**
+   * Returns the path of the file on the disk.
+   */
+  const std::filesystem::path& path() const;
+
+  /**
+   * Returns the beginning of the mapped memory region.
+   */
+  const char* begin() const;
+
+  /**
+   * Returns the end of the mapped memory region.
+   */
+  const char* end() const;
+
+  /**
+   * Returns a copy of the contents of this file that does not depend on the mapping.
+   */
+  std::unique_ptr<OwningBufferFile> buffer() const;
+};
+
+Result<std::shared_ptr<MappedFile>> createMappedFile(const std::filesystem::path& path);
+
 /**
  * A file that is backed by a portion of a physical file.
  */
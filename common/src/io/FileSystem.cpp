@@ -71,6 +71,28 @@ Result<std::shared_ptr<File>> FileSystem::openFile(
   return doOpenFile(path);
 }
 
+Result<std::filesystem::path> FileSystem::containerPath(
+  const std::filesystem::path& path) const
+{
+  if (path.is_absolute())
+  {
+    return Error{"Path '" + path.string() + "' is absolute"};
+  }
+
+  if (pathInfo(path) != PathInfo::File)
+  {
+    return Error{"'" + path.string() + "' not found"};
+  }
+
+  return doGetContainerPath(path);
+}
+
+Result<std::filesystem::path> FileSystem::doGetContainerPath(
+  const std::filesystem::path& path) const
+{
+  return Error{"'" + path.string() + "' is not stored on the disk"};
+}
+
 WritableFileSystem::~WritableFileSystem() = default;
 
 Result<void> WritableFileSystem::createFileAtomic(
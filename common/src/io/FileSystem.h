@@ -68,11 +68,22 @@ public:
    */
   Result<std::shared_ptr<File>> openFile(const std::filesystem::path& path) const;
 
+  /** Returns the absolute path of the file on the disk that contains the file at the
+   * given path. For a file in an archive, this is the path of the archive, otherwise it
+   * is the path of the file itself.
+   *
+   * @return the path or an error if the file is not stored on the disk by itself or in
+   * an archive
+   */
+  Result<std::filesystem::path> containerPath(const std::filesystem::path& path) const;
+
 protected:
   virtual Result<std::vector<std::filesystem::path>> doFind(
     const std::filesystem::path& path, const TraversalMode& traversalMode) const = 0;
   virtual Result<std::shared_ptr<File>> doOpenFile(
     const std::filesystem::path& path) const = 0;
+  virtual Result<std::filesystem::path> doGetContainerPath(
+    const std::filesystem::path& path) const;
 };
 
 class WritableFileSystem : public virtual FileSystem
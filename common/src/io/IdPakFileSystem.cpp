@@ -79,4 +79,10 @@ Result<void> IdPakFileSystem::doReadDirectory()
   }
 }
 
+Result<std::filesystem::path> IdPakFileSystem::doGetContainerPath(
+  const std::filesystem::path&) const
+{
+  return m_file->path();
+}
+
 } // namespace tb::io
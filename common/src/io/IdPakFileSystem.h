@@ -24,15 +24,17 @@
 
 namespace tb::io
 {
-class CFile;
+class MappedFile;
 
-class IdPakFileSystem : public ImageFileSystem<CFile>
+class IdPakFileSystem : public ImageFileSystem<MappedFile>
 {
 public:
   using ImageFileSystem::ImageFileSystem;
 
 private:
   Result<void> doReadDirectory() override;
+  Result<std::filesystem::path> doGetContainerPath(
+    const std::filesystem::path& path) const override;
 };
 
 } // namespace tb::io
@@ -34,7 +34,7 @@
 
 namespace tb::io
 {
-class CFile;
+class MappedFile;
 class File;
 
 using GetImageFile = std::function<Result<std::shared_ptr<File>>()>;
@@ -31,6 +31,7 @@
 #include "io/ReadMipTexture.h"
 #include "io/ReadWalTexture.h"
 #include "io/ResourceUtils.h"
+#include "io/TextureCache.h"
 #include "io/TraversalMode.h"
 #include "mdl/GameConfig.h"
 #include "mdl/MaterialCollection.h"
@@ -41,6 +42,7 @@
 
 #include "kdl/functional.h"
 #include "kdl/grouped_range.h"
+#include "kdl/hash_utils.h"
 #include "kdl/map_utils.h"
 #include "kdl/path_hash.h"
 #include "kdl/path_utils.h"
@@ -52,7 +54,9 @@
 
 #include <fmt/format.h>
 
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace tb::io
@@ -319,12 +323,78 @@ mdl::ResourceLoader<mdl::Texture> makeTextureResourceLoader(
   };
 }
 
+uint64_t hashTextureParameters(
+  const std::string& extension,
+  const mdl::TextureMask mask,
+  const std::optional<Result<mdl::Palette>>& paletteResult)
+{
+  auto paletteHash = size_t(0);
+  if (paletteResult && paletteResult->is_success())
+  {
+    const auto& paletteData = paletteResult->value().data().opaqueData;
+    paletteHash = kdl::hash(std::string_view{
+      reinterpret_cast<const char*>(paletteData.data()), paletteData.size()});
+  }
+
+  return uint64_t(kdl::hash(extension, static_cast<int>(mask), paletteHash));
+}
+
+/**
+ * Wraps the given texture loader so that it first looks up the decoded texture in the
+ * given texture cache. The cache key is computed from the path of the texture file and
+ * the modification time and size of the file or archive containing it, so that changed
+ * files are decoded again. Textures that were decoded are stored in the cache.
+ *
+ * Textures that are not stored on the disk are decoded without consulting the cache.
+ *
+ * Like the wrapped loader, the returned loader references the given file system, which
+ * must not be destroyed while the loader runs.
+ */
+mdl::ResourceLoader<mdl::Texture> makeCachingTextureResourceLoader(
+  mdl::ResourceLoader<mdl::Texture> textureLoader,
+  const std::filesystem::path& path,
+  const std::string& name,
+  const FileSystem& fs,
+  const std::optional<Result<mdl::Palette>>& paletteResult,
+  std::shared_ptr<TextureCache> textureCache)
+{
+  const auto parameterHash = hashTextureParameters(
+    kdl::str_to_lower(path.extension().string()),
+    getTextureMaskFromName(name),
+    paletteResult);
+
+  return [&fs,
+          path,
+          parameterHash,
+          textureLoader = std::move(textureLoader),
+          textureCache = std::move(textureCache)]() -> Result<mdl::Texture> {
+    const auto keyResult =
+      fs.containerPath(path) | kdl::and_then([&](const auto& containerPath) {
+        return makeTextureCacheKey(containerPath, path, parameterHash);
+      });
+    if (!keyResult.is_success())
+    {
+      return textureLoader();
+    }
+
+    const auto& key = keyResult.value();
+    return textureCache->load(key) | kdl::or_else([&](auto) {
+             return textureLoader() | kdl::transform([&](auto texture) {
+                      textureCache->store(key, texture)
+                        | kdl::or_else([](auto) { return kdl::void_success; });
+                      return texture;
+                    });
+           });
+  };
+}
+
 Result<mdl::Material> loadTextureMaterial(
   const std::filesystem::path& texturePath,
   const FileSystem& fs,
   const mdl::MaterialConfig& materialConfig,
   const mdl::CreateTextureResource& createResource,
-  const std::optional<Result<mdl::Palette>>& paletteResult)
+  const std::optional<Result<mdl::Palette>>& paletteResult,
+  const std::shared_ptr<TextureCache>& textureCache)
 {
   const auto prefixLength = kdl::path_length(materialConfig.root);
   const auto pathMatcher = !materialConfig.extensions.empty()
@@ -333,6 +403,11 @@ Result<mdl::Material> loadTextureMaterial(
 
   auto name = getMaterialNameFromPathSuffix(texturePath, prefixLength);
   auto textureLoader = makeTextureResourceLoader(texturePath, name, fs, paletteResult);
+  if (textureCache)
+  {
+    textureLoader = makeCachingTextureResourceLoader(
+      std::move(textureLoader), texturePath, name, fs, paletteResult, textureCache);
+  }
   auto textureResource = createResource(std::move(textureLoader));
   return mdl::Material{std::move(name), std::move(textureResource)};
 }
@@ -374,16 +449,14 @@ std::vector<mdl::MaterialCollection> groupMaterialsIntoCollections(
   });
 }
 
-} // namespace
-
-
 Result<mdl::Material> loadMaterial(
   const FileSystem& fs,
   const mdl::MaterialConfig& materialConfig,
   const std::filesystem::path& materialPath,
   const mdl::CreateTextureResource& createResource,
   const std::vector<mdl::Quake3Shader>& shaders,
-  const std::optional<Result<mdl::Palette>>& paletteResult)
+  const std::optional<Result<mdl::Palette>>& paletteResult,
+  const std::shared_ptr<TextureCache>& textureCache)
 {
   const auto materialPathStem = kdl::path_remove_extension(materialPath);
   const auto iShader =
@@ -394,7 +467,12 @@ Result<mdl::Material> loadMaterial(
   return (iShader != shaders.end()
             ? loadShaderMaterial(*iShader, fs, materialConfig, createResource)
             : loadTextureMaterial(
-                materialPath, fs, materialConfig, createResource, paletteResult))
+                materialPath,
+                fs,
+                materialConfig,
+                createResource,
+                paletteResult,
+                textureCache))
          | kdl::transform([&](auto material) {
              fs.makeAbsolute(materialPath)
                | kdl::transform([&](auto absPath) { material.setAbsolutePath(absPath); })
@@ -404,10 +482,26 @@ Result<mdl::Material> loadMaterial(
            });
 }
 
+} // namespace
+
+
+Result<mdl::Material> loadMaterial(
+  const FileSystem& fs,
+  const mdl::MaterialConfig& materialConfig,
+  const std::filesystem::path& materialPath,
+  const mdl::CreateTextureResource& createResource,
+  const std::vector<mdl::Quake3Shader>& shaders,
+  const std::optional<Result<mdl::Palette>>& paletteResult)
+{
+  return loadMaterial(
+    fs, materialConfig, materialPath, createResource, shaders, paletteResult, nullptr);
+}
+
 Result<std::vector<mdl::MaterialCollection>> loadMaterialCollections(
   const FileSystem& fs,
   const mdl::MaterialConfig& materialConfig,
   const mdl::CreateTextureResource& createResource,
+  const std::shared_ptr<TextureCache>& textureCache,
   Logger& logger)
 {
   const auto paletteResult = loadPalette(fs, materialConfig);
@@ -429,7 +523,8 @@ Result<std::vector<mdl::MaterialCollection>> loadMaterialCollections(
                                      materialPath,
                                      createResource,
                                      shaders,
-                                     paletteResult);
+                                     paletteResult,
+                                     textureCache);
                                  })
                                | kdl::fold;
                       });
@@ -25,6 +25,7 @@
 #include "mdl/TextureResource.h"
 
 #include <filesystem>
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -43,6 +44,7 @@ struct MaterialConfig;
 namespace tb::io
 {
 class FileSystem;
+class TextureCache;
 
 Result<mdl::Material> loadMaterial(
   const FileSystem& fs,
@@ -52,10 +54,17 @@ Result<mdl::Material> loadMaterial(
   const std::vector<mdl::Quake3Shader>& shaders,
   const std::optional<Result<mdl::Palette>>& paletteResult);
 
+/**
+ * Loads all material collections for the given material config.
+ *
+ * If a texture cache is given, the texture loaders look up decoded textures in the cache
+ * before decoding them and store the textures they decoded in the cache.
+ */
 Result<std::vector<mdl::MaterialCollection>> loadMaterialCollections(
   const FileSystem& fs,
   const mdl::MaterialConfig& materialConfig,
   const mdl::CreateTextureResource& createResource,
+  const std::shared_ptr<TextureCache>& textureCache,
   Logger& logger);
 
 } // namespace tb::io
@@ -34,13 +34,17 @@
 
 #include "kdl/overload.h"
 #include "kdl/parallel.h"
+#include "kdl/range_to.h"
 #include "kdl/string_format.h"
+#include "kdl/vector_utils.h"
 
 #include <fmt/format.h>
 
 #include <iterator>
 #include <memory>
+#include <ranges>
 #include <sstream>
+#include <unordered_set>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -322,7 +326,10 @@ private:
   }
 };
 
-std::unique_ptr<NodeSerializer> MapFileSerializer::create(
+namespace
+{
+
+std::unique_ptr<MapFileSerializer> createSerializer(
   const mdl::MapFormat format, std::ostream& stream)
 {
   switch (format)
@@ -351,25 +358,40 @@ std::unique_ptr<NodeSerializer> MapFileSerializer::create(
   }
 }
 
+} // namespace
+
+std::unique_ptr<NodeSerializer> MapFileSerializer::create(
+  const mdl::MapFormat format, std::ostream& stream, NodeSerializationCache* cache)
+{
+  auto serializer = createSerializer(format, stream);
+  serializer->m_mapFormat = format;
+  if (cache)
+  {
+    serializer->m_cache = cache;
+  }
+  return serializer;
+}
+
 MapFileSerializer::MapFileSerializer(std::ostream& stream)
   : m_line(1)
   , m_stream(stream)
+  , m_cache(&m_ownCache)
 {
 }
 
 void MapFileSerializer::doBeginFile(const std::vector<const mdl::Node*>& rootNodes)
 {
-  ensure(m_nodeToPrecomputedString.empty(), "MapFileSerializer may not be reused");
-
   // collect nodes
   std::vector<std::variant<const mdl::BrushNode*, const mdl::PatchNode*>>
     nodesToSerialize;
   nodesToSerialize.reserve(rootNodes.size());
 
+  auto writesWorld = false;
   mdl::Node::visitAll(
     rootNodes,
     kdl::overload(
-      [](auto&& thisLambda, const mdl::WorldNode* world) {
+      [&](auto&& thisLambda, const mdl::WorldNode* world) {
+        writesWorld = true;
         world->visitChildren(thisLambda);
       },
       [](auto&& thisLambda, const mdl::LayerNode* layer) {
@@ -386,10 +408,26 @@ void MapFileSerializer::doBeginFile(const std::vector<const mdl::Node*>& rootNod
         nodesToSerialize.emplace_back(patchNode);
       }));
 
+  const auto toNode = [](const auto& node) {
+    return std::visit([](const mdl::Node* n) { return n; }, node);
+  };
+
+  if (writesWorld)
+  {
+    // drop the cache entries of nodes that were removed from the world
+    m_cache->retain(
+      nodesToSerialize | std::views::transform(toNode)
+      | kdl::to<std::unordered_set<const mdl::Node*>>());
+  }
+
+  auto uncachedNodes = kdl::vec_filter(std::move(nodesToSerialize), [&](const auto& node) {
+    return m_cache->find(m_mapFormat, *toNode(node)) == nullptr;
+  });
+
   // serialize brushes to strings in parallel
   using Entry = std::pair<const mdl::Node*, PrecomputedString>;
   std::vector<Entry> result =
-    kdl::vec_parallel_transform(std::move(nodesToSerialize), [&](const auto& node) {
+    kdl::vec_parallel_transform(std::move(uncachedNodes), [&](const auto& node) {
       return std::visit(
         kdl::overload(
           [&](const mdl::BrushNode* brushNode) {
@@ -401,10 +439,10 @@ void MapFileSerializer::doBeginFile(const std::vector<const mdl::Node*>& rootNod
         node);
     });
 
-  // move strings into a map
-  for (auto& entry : result)
+  // move strings into the cache
+  for (auto& [node, precomputedString] : result)
   {
-    m_nodeToPrecomputedString.insert(std::move(entry));
+    m_cache->insert(m_mapFormat, *node, std::move(precomputedString));
   }
 }
 
@@ -445,13 +483,12 @@ void MapFileSerializer::doBrush(const mdl::BrushNode* brush)
   ++m_line;
 
   // write pre-serialized brush faces
-  auto it = m_nodeToPrecomputedString.find(brush);
+  const auto* precomputedString = m_cache->find(m_mapFormat, *brush);
   ensure(
-    it != std::end(m_nodeToPrecomputedString),
+    precomputedString != nullptr,
     "attempted to serialize a brush which was not passed to doBeginFile");
-  const PrecomputedString& precomputedString = it->second;
-  m_stream << precomputedString.string;
-  m_line += precomputedString.lineCount;
+  m_stream << precomputedString->string;
+  m_line += precomputedString->lineCount;
 
   fmt::format_to(std::ostreambuf_iterator<char>(m_stream), "}}\n");
   ++m_line;
@@ -473,13 +510,12 @@ void MapFileSerializer::doPatch(const mdl::PatchNode* patchNode)
   m_startLineStack.push_back(m_line);
 
   // write pre-serialized patch
-  auto it = m_nodeToPrecomputedString.find(patchNode);
+  const auto* precomputedString = m_cache->find(m_mapFormat, *patchNode);
   ensure(
-    it != std::end(m_nodeToPrecomputedString),
+    precomputedString != nullptr,
     "attempted to serialize a patch which was not passed to doBeginFile");
-  const PrecomputedString& precomputedString = it->second;
-  m_stream << precomputedString.string;
-  m_line += precomputedString.lineCount;
+  m_stream << precomputedString->string;
+  m_line += precomputedString->lineCount;
 
   setFilePosition(patchNode);
 }
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include "io/NodeSerializationCache.h"
 #include "io/NodeSerializer.h"
 #include "mdl/MapFormat.h"
 
@@ -48,16 +49,23 @@ private:
   size_t m_line;
   std::ostream& m_stream;
 
-  struct PrecomputedString
-  {
-    std::string string;
-    size_t lineCount;
-  };
-  std::unordered_map<const mdl::Node*, PrecomputedString> m_nodeToPrecomputedString;
+  using PrecomputedString = NodeSerializationCache::Entry;
+  mdl::MapFormat m_mapFormat = mdl::MapFormat::Unknown;
+  NodeSerializationCache m_ownCache;
+  NodeSerializationCache* m_cache;
 
 public:
+  /**
+   * Creates a serializer for the given format.
+   *
+   * If a cache is given, brushes and patches that are found in the cache are not
+   * serialized again, and the newly serialized ones are added to the cache. Otherwise,
+   * the serializer uses a cache of its own that is discarded with it.
+   */
   static std::unique_ptr<NodeSerializer> create(
-    mdl::MapFormat format, std::ostream& stream);
+    mdl::MapFormat format,
+    std::ostream& stream,
+    NodeSerializationCache* cache = nullptr);
 
 protected:
   explicit MapFileSerializer(std::ostream& stream);
@@ -20,8 +20,10 @@
 #include "MapReader.h"
 
 #include "Error.h" // IWYU pragma: keep
+#include "Exceptions.h"
 #include "FileLocation.h"
 #include "Uuid.h"
+#include "io/BufferedParserStatus.h"
 #include "io/ParserStatus.h"
 #include "mdl/BrushFace.h"
 #include "mdl/BrushNode.h"
@@ -36,6 +38,7 @@
 #include "mdl/VisibilityState.h"
 #include "mdl/WorldNode.h"
 
+#include "kdl/overload.h"
 #include "kdl/parallel.h"
 #include "kdl/result.h"
 #include "kdl/string_format.h"
@@ -51,6 +54,8 @@
 
 #include <cassert>
 #include <cstddef>
+#include <exception>
+#include <memory>
 #include <optional>
 #include <ostream>
 #include <string>
@@ -72,6 +77,32 @@ auto getFilePosition(const T& info)
   return std::tuple{startLine, lineCount};
 }
 
+/**
+ * Parses a chunk of the input on behalf of another reader. Only the MapParser callbacks
+ * are used, the other reader merges the results and creates the nodes.
+ */
+class EntityChunkReader : public MapReader
+{
+public:
+  EntityChunkReader(
+    const MapChunk& chunk,
+    const mdl::MapFormat sourceMapFormat,
+    const mdl::MapFormat targetMapFormat)
+    : MapReader{chunk, sourceMapFormat, targetMapFormat, {}}
+  {
+  }
+
+private:
+  mdl::Node* onWorldNode(std::unique_ptr<mdl::WorldNode>, ParserStatus&) override
+  {
+    return nullptr;
+  }
+
+  void onLayerNode(std::unique_ptr<mdl::Node>, ParserStatus&) override {}
+
+  void onNode(mdl::Node*, std::unique_ptr<mdl::Node>, ParserStatus&) override {}
+};
+
 } // namespace
 
 MapReader::MapReader(
@@ -84,10 +115,23 @@ MapReader::MapReader(
 {
 }
 
+MapReader::MapReader(
+  const MapChunk& chunk,
+  const mdl::MapFormat sourceMapFormat,
+  const mdl::MapFormat targetMapFormat,
+  mdl::EntityPropertyConfig entityPropertyConfig)
+  : StandardMapParser{chunk, sourceMapFormat, targetMapFormat}
+  , m_entityPropertyConfig{std::move(entityPropertyConfig)}
+{
+}
+
 void MapReader::readEntities(const vm::bbox3d& worldBounds, ParserStatus& status)
 {
   m_worldBounds = worldBounds;
-  parseEntities(status);
+  if (!parseEntitiesInParallel(status))
+  {
+    parseEntities(status);
+  }
   createNodes(status);
 }
 
@@ -220,6 +264,112 @@ void MapReader::onPatch(
 
 // helper methods
 
+bool MapReader::parseEntitiesInParallel(ParserStatus& status)
+{
+  struct ChunkResult
+  {
+    std::vector<ObjectInfo> objectInfos;
+    std::optional<size_t> currentEntityInfo;
+    std::unique_ptr<BufferedParserStatus> status;
+    std::exception_ptr error;
+    bool errorAtEnd = false;
+  };
+
+  auto chunks = splitEntities();
+  if (chunks.size() < 2)
+  {
+    return false;
+  }
+
+  auto inputLength = size_t(0);
+  for (const auto& chunk : chunks)
+  {
+    inputLength += chunk.str.size();
+  }
+
+  auto combinedProgress = CombinedParserProgress{status};
+  auto chunkResults = kdl::vec_parallel_transform(
+    std::move(chunks), [&](const MapChunk& chunk) {
+      auto chunkStatus = std::make_unique<BufferedParserStatus>(
+        status, combinedProgress, double(chunk.str.size()) / double(inputLength));
+      auto reader = EntityChunkReader{chunk, m_sourceMapFormat, m_targetMapFormat};
+      try
+      {
+        reader.parseEntities(*chunkStatus);
+      }
+      catch (const ParserException&)
+      {
+        return ChunkResult{
+          {},
+          std::nullopt,
+          std::move(chunkStatus),
+          std::current_exception(),
+          reader.m_tokenizer.eof()};
+      }
+
+      return ChunkResult{
+        std::move(reader.m_objectInfos),
+        reader.m_currentEntityInfo,
+        std::move(chunkStatus),
+        nullptr};
+    });
+
+  // Every chunk but the last must end with a closed entity, otherwise the input was not
+  // split at the ends of the entities. For the same reason, an error at the end of a
+  // chunk may be caused by the split, so the input is parsed as a whole in both cases.
+  for (size_t i = 0; i < chunkResults.size(); ++i)
+  {
+    const auto& chunkResult = chunkResults[i];
+    if (chunkResult.error)
+    {
+      if (chunkResult.errorAtEnd)
+      {
+        return false;
+      }
+
+      // the chunks up to here were parsed exactly like the input as a whole would be, so
+      // the messages and the error are the same as those of a serial parse
+      for (size_t j = 0; j <= i; ++j)
+      {
+        chunkResults[j].status->flush();
+      }
+      std::rethrow_exception(chunkResult.error);
+    }
+
+    if (i + 1 < chunkResults.size() && chunkResult.currentEntityInfo)
+    {
+      return false;
+    }
+  }
+
+  for (auto& chunkResult : chunkResults)
+  {
+    const auto offset = m_objectInfos.size();
+    for (auto& objectInfo : chunkResult.objectInfos)
+    {
+      std::visit(
+        kdl::overload(
+          [](EntityInfo&) {},
+          [&](auto& info) {
+            if (info.parentIndex)
+            {
+              *info.parentIndex += offset;
+            }
+          }),
+        objectInfo);
+      m_objectInfos.push_back(std::move(objectInfo));
+    }
+
+    m_currentEntityInfo = chunkResult.currentEntityInfo
+                            ? std::optional{*chunkResult.currentEntityInfo + offset}
+                            : std::nullopt;
+    chunkResult.status->flush();
+  }
+
+  status.progress(1.0);
+  return true;
+}
+
 namespace
 {
 /** The type of a node's container. */
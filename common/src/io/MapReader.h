@@ -61,7 +61,8 @@ class ParserStatus;
  * The flow of control is:
  *
  * 1. MapParser callbacks get called with the raw data, which we just store
- * (m_objectInfos).
+ * (m_objectInfos). When reading entities, the top level entities are parsed in parallel
+ * and the raw data is merged in file order (parseEntitiesInParallel).
  * 2. Convert the raw data to nodes in parallel (createNodes) and record any additional
  * information necessary to restore the parent / child relationships.
  * 3. Validate the created nodes.
@@ -125,6 +126,15 @@ protected:
     mdl::MapFormat targetMapFormat,
     mdl::EntityPropertyConfig entityPropertyConfig);
 
+  /**
+   * Creates a new reader for the given chunk of a larger input, see StandardMapParser.
+   */
+  MapReader(
+    const MapChunk& chunk,
+    mdl::MapFormat sourceMapFormat,
+    mdl::MapFormat targetMapFormat,
+    mdl::EntityPropertyConfig entityPropertyConfig);
+
   /**
    * Attempts to parse as one or more entities.
    *
@@ -192,6 +202,23 @@ protected: // implement MapParser interface
     ParserStatus& status) override;
 
 private: // helper methods
+  /**
+   * Splits the input at the top level entities and parses every entity on a worker
+   * thread with its own tokenizer and parser status. The results and the messages are
+   * merged in file order, so they are the same as if the input had been parsed as a
+   * whole.
+   *
+   * If parsing an entity fails, the messages of the preceding entities and of the failed
+   * entity are forwarded and the error is rethrown. Progress is reported while the
+   * entities are parsed.
+   *
+   * Returns false without changing any state if the input cannot be split at the ends of
+   * the entities. The input must then be parsed as a whole.
+   *
+   * @throws ParserException if parsing any entity fails
+   */
+  bool parseEntitiesInParallel(ParserStatus& status);
+
   void createNodes(ParserStatus& status);
 
 private: // subclassing interface - these will be called in the order that nodes should be
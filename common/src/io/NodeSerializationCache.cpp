@@ -0,0 +1,64 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NodeSerializationCache.h"
+
+#include "mdl/Node.h"
+
+namespace tb::io
+{
+
+const NodeSerializationCache::Entry* NodeSerializationCache::find(
+  const mdl::MapFormat mapFormat, const mdl::Node& node) const
+{
+  if (mapFormat != m_mapFormat)
+  {
+    return nullptr;
+  }
+
+  const auto it = m_entries.find(&node);
+  return it != m_entries.end() && it->second.revision == node.revision()
+           ? &it->second.entry
+           : nullptr;
+}
+
+void NodeSerializationCache::insert(
+  const mdl::MapFormat mapFormat, const mdl::Node& node, Entry entry)
+{
+  if (mapFormat != m_mapFormat)
+  {
+    m_entries.clear();
+    m_mapFormat = mapFormat;
+  }
+
+  m_entries.insert_or_assign(&node, RevisionedEntry{node.revision(), std::move(entry)});
+}
+
+void NodeSerializationCache::retain(const std::unordered_set<const mdl::Node*>& nodes)
+{
+  std::erase_if(
+    m_entries, [&](const auto& entry) { return !nodes.contains(entry.first); });
+}
+
+size_t NodeSerializationCache::size() const
+{
+  return m_entries.size();
+}
+
+} // namespace tb::io
@@ -0,0 +1,85 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "mdl/MapFormat.h"
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace tb::mdl
+{
+class Node;
+} // namespace tb::mdl
+
+namespace tb::io
+{
+
+/**
+ * Caches the serialized text of brushes and patches between writes so that only the
+ * nodes that changed since the last write must be serialized again.
+ *
+ * An entry is only valid for the revision that its node had when the entry was added.
+ * Since revisions are unique across all nodes, the entry of a deleted node is never
+ * mistaken for the entry of a new node that was allocated at the same address.
+ */
+class NodeSerializationCache
+{
+public:
+  struct Entry
+  {
+    std::string string;
+    size_t lineCount = 0;
+  };
+
+private:
+  struct RevisionedEntry
+  {
+    size_t revision;
+    Entry entry;
+  };
+
+  mdl::MapFormat m_mapFormat = mdl::MapFormat::Unknown;
+  std::unordered_map<const mdl::Node*, RevisionedEntry> m_entries;
+
+public:
+  /**
+   * Returns the entry for the given node if it was serialized in the given format and
+   * the node has not changed since. Otherwise, returns nullptr.
+   */
+  const Entry* find(mdl::MapFormat mapFormat, const mdl::Node& node) const;
+
+  /**
+   * Adds an entry for the current revision of the given node, replacing any previous
+   * entry. If the given format differs from the format of the cached entries, the cached
+   * entries are dropped.
+   */
+  void insert(mdl::MapFormat mapFormat, const mdl::Node& node, Entry entry);
+
+  /**
+   * Drops the entries of all nodes except the given nodes.
+   */
+  void retain(const std::unordered_set<const mdl::Node*>& nodes);
+
+  size_t size() const;
+};
+
+} // namespace tb::io
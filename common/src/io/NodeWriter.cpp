@@ -88,7 +88,10 @@ void doWriteNodes(
 } // namespace
 
 NodeWriter::NodeWriter(const mdl::WorldNode& world, std::ostream& stream)
-  : NodeWriter{world, MapFileSerializer::create(world.mapFormat(), stream)}
+  : NodeWriter{
+      world,
+      MapFileSerializer::create(
+        world.mapFormat(), stream, &world.serializationCache())}
 {
 }
 
@@ -33,6 +33,8 @@ namespace tb::io
 class ParserStatus
 {
 private:
+  friend class BufferedParserStatus;
+
   Logger& m_logger;
   std::string m_prefix;
 
@@ -149,21 +149,33 @@ public:
   }
 };
 
+/**
+ * A reader source that reads from a memory region and keeps the owner of the memory
+ * region alive. Sub sources and buffers share the owner.
+ */
 class OwningBufferReaderSource : public BufferReaderSource
 {
 private:
-  CFile::BufferType m_buffer;
+  std::shared_ptr<const void> m_owner;
 
 public:
-  OwningBufferReaderSource(CFile::BufferType buffer, const char* begin, const char* end)
+  OwningBufferReaderSource(
+    std::shared_ptr<const void> owner, const char* begin, const char* end)
     : BufferReaderSource{begin, end}
-    , m_buffer{std::move(buffer)}
+    , m_owner{std::move(owner)}
+  {
+  }
+
+  std::shared_ptr<ReaderSource> subSource(
+    const size_t offset, const size_t length) const override
   {
+    return std::make_shared<OwningBufferReaderSource>(
+      m_owner, begin() + offset, begin() + offset + length);
   }
 
   std::shared_ptr<BufferReaderSource> buffer() const override
   {
-    return std::make_shared<OwningBufferReaderSource>(m_buffer, begin(), end());
+    return std::make_shared<OwningBufferReaderSource>(m_owner, begin(), end());
   }
 };
 
@@ -243,6 +255,13 @@ Reader Reader::from(const char* begin, const char* end)
   return Reader{std::make_shared<BufferReaderSource>(begin, end)};
 }
 
+Reader Reader::from(
+  std::shared_ptr<const void> owner, const char* begin, const char* end)
+{
+  return Reader{
+    std::make_shared<OwningBufferReaderSource>(std::move(owner), begin, end)};
+}
+
 size_t Reader::size() const
 {
   return m_source->size();
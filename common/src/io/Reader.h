@@ -75,6 +75,21 @@ public:
    */
   static Reader from(const char* begin, const char* end);
 
+  /**
+   * Creates a new reader that reads from the given memory region, which is owned by the
+   * given owner. The reader and all readers created from it, including buffered readers
+   * and sub readers, keep the owner alive.
+   *
+   * @param owner the owner of the memory region
+   * @param begin the beginning of the memory region
+   * @param end the end of the memory region (the position after the last byte)
+   * @return the reader
+   *
+   * @throw ReaderException if the reader cannot be created
+   */
+  static Reader from(
+    std::shared_ptr<const void> owner, const char* begin, const char* end);
+
 public:
   /**
    * Returns the size of the underlying reader source.
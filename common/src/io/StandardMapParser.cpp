@@ -40,8 +40,9 @@ const std::string& QuakeMapTokenizer::NumberDelim()
   return numberDelim;
 }
 
-QuakeMapTokenizer::QuakeMapTokenizer(const std::string_view str)
-  : Tokenizer{str, "\"", '\\'}
+QuakeMapTokenizer::QuakeMapTokenizer(
+  const std::string_view str, const size_t line, const size_t column)
+  : Tokenizer{str, "\"", '\\', line, column}
 {
 }
 
@@ -147,6 +148,83 @@ QuakeMapTokenizer::Token QuakeMapTokenizer::emitToken()
   return Token{QuakeMapToken::Eof, nullptr, nullptr, length(), line(), column()};
 }
 
+std::vector<TokenizerState> QuakeMapTokenizer::scanEntityEnds()
+{
+  auto result = std::vector<TokenizerState>{};
+  auto depth = size_t(0);
+
+  while (!eof())
+  {
+    switch (curChar())
+    {
+    case '/':
+      advance();
+      if (curChar() == '/')
+      {
+        advance();
+        if (curChar() == '/' && lookAhead(1) == ' ')
+        {
+          // the remainder of a /// comment is tokenized
+          advance();
+          break;
+        }
+        discardUntil("\n\r");
+      }
+      break;
+    case ';':
+      advance();
+      discardUntil("\n\r");
+      break;
+    case '{':
+      advance();
+      // material names such as {BLUE begin with an opening brace
+      if (eof() || isWhitespace(curChar()))
+      {
+        ++depth;
+      }
+      break;
+    case '}':
+      advance();
+      if (depth == 0)
+      {
+        return {};
+      }
+      if (--depth == 0)
+      {
+        result.push_back(snapshot());
+      }
+      break;
+    case '(':
+    case ')':
+    case '[':
+    case ']':
+      advance();
+      break;
+    case '"':
+      advance();
+      readQuotedString('"', "\n}");
+      break;
+    case '\r':
+    case '\n':
+    case ' ':
+    case '\t':
+      discardWhile(Whitespace());
+      break;
+    default:
+      readUntil(Whitespace());
+      break;
+    }
+  }
+
+  if (depth > 0 || result.empty())
+  {
+    return {};
+  }
+
+  result.back() = snapshot();
+  return result;
+}
+
 const std::string StandardMapParser::BrushPrimitiveId = "brushDef";
 const std::string StandardMapParser::PatchId = "patchDef2";
 
@@ -162,8 +240,46 @@ StandardMapParser::StandardMapParser(
   assert(targetMapFormat != mdl::MapFormat::Unknown);
 }
 
+StandardMapParser::StandardMapParser(
+  const MapChunk& chunk,
+  const mdl::MapFormat sourceMapFormat,
+  const mdl::MapFormat targetMapFormat)
+  : m_tokenizer{chunk.str, chunk.line, chunk.column}
+  , m_sourceMapFormat{sourceMapFormat}
+  , m_targetMapFormat{targetMapFormat}
+{
+  assert(m_sourceMapFormat != mdl::MapFormat::Unknown);
+  assert(targetMapFormat != mdl::MapFormat::Unknown);
+}
+
 StandardMapParser::~StandardMapParser() = default;
 
+std::vector<MapChunk> StandardMapParser::splitEntities()
+{
+  const auto start = m_tokenizer.snapshot();
+
+  auto result = std::vector<MapChunk>{};
+  try
+  {
+    auto chunkStart = start;
+    for (const auto& chunkEnd : m_tokenizer.scanEntityEnds())
+    {
+      result.push_back(MapChunk{
+        std::string_view{chunkStart.cur, size_t(chunkEnd.cur - chunkStart.cur)},
+        chunkStart.line,
+        chunkStart.column});
+      chunkStart = chunkEnd;
+    }
+  }
+  catch (const ParserException&)
+  {
+    result.clear();
+  }
+
+  m_tokenizer.restore(start);
+  return result;
+}
+
 void StandardMapParser::parseEntities(ParserStatus& status)
 {
   auto token = m_tokenizer.peekToken();
@@ -171,8 +287,10 @@ void StandardMapParser::parseEntities(ParserStatus& status)
   {
     expect(QuakeMapToken::OBrace, token);
     parseEntity(status);
+    status.progress(m_tokenizer.progress());
     token = m_tokenizer.peekToken();
   }
+  status.progress(1.0);
 }
 
 void StandardMapParser::parseBrushesOrPatches(ParserStatus& status)
@@ -735,7 +853,7 @@ void StandardMapParser::parsePatch(
     rowCount,
     columnCount,
     std::move(controlPoints),
-    std::move(materialName),
+    materialName.str(),
     status);
 }
 
@@ -758,11 +876,12 @@ std::tuple<vm::vec3d, vm::vec3d, vm::vec3d> StandardMapParser::parseFacePoints(
   return {p1, p2, p3};
 }
 
-std::string StandardMapParser::parseMaterialName(ParserStatus& /* status */)
+mdl::MaterialName StandardMapParser::parseMaterialName(ParserStatus& /* status */)
 {
   const auto [materialName, wasQuoted] =
     m_tokenizer.readAnyString(QuakeMapTokenizer::Whitespace());
-  return wasQuoted ? kdl::str_unescape(materialName, "\"\\") : std::string{materialName};
+  return wasQuoted ? mdl::MaterialName{kdl::str_unescape(materialName, "\"\\")}
+                   : mdl::MaterialName{materialName};
 }
 
 std::tuple<vm::vec3d, float, vm::vec3d, float> StandardMapParser::parseValveUVAxes(
@@ -23,6 +23,7 @@
 #include "io/Parser.h"
 #include "io/Tokenizer.h"
 #include "mdl/MapFormat.h"
+#include "mdl/MaterialName.h"
 
 #include "kdl/vector_set_forward.h"
 
@@ -66,14 +67,38 @@ private:
   bool m_skipEol = true;
 
 public:
-  explicit QuakeMapTokenizer(std::string_view str);
+  explicit QuakeMapTokenizer(std::string_view str, size_t line = 1, size_t column = 1);
 
   void setSkipEol(bool skipEol);
 
+  /**
+   * Scans the remaining input for the ends of the top level entities without emitting
+   * any tokens. Quoted strings and comments are skipped in the same way as when
+   * tokenizing, so braces within them are ignored.
+   *
+   * Returns the tokenizer state after the closing brace of every top level entity,
+   * except that the last state is at the end of the input. Returns an empty vector if
+   * the braces are unbalanced.
+   *
+   * @throws ParserException if the input ends within a quoted string
+   */
+  std::vector<TokenizerState> scanEntityEnds();
+
 private:
   Token emitToken() override;
 };
 
+/**
+ * A contiguous part of the input of a StandardMapParser and its location within the
+ * input.
+ */
+struct MapChunk
+{
+  std::string_view str;
+  size_t line;
+  size_t column;
+};
+
 class StandardMapParser : public MapParser, public Parser<QuakeMapToken::Type>
 {
 protected:
@@ -106,6 +131,31 @@ public:
   vm::vec<float, 4> parseColor(ParserStatus& status);
 
 protected:
+  /**
+   * Creates a new parser for the given chunk of a larger input. The locations reported
+   * by the parser are relative to the beginning of the larger input.
+   *
+   * @param chunk the chunk to parse
+   * @param sourceMapFormat the expected format of the given chunk
+   * @param targetMapFormat the format to convert the created objects to
+   */
+  StandardMapParser(
+    const MapChunk& chunk,
+    mdl::MapFormat sourceMapFormat,
+    mdl::MapFormat targetMapFormat);
+
+  /**
+   * Splits the input into chunks such that every chunk contains one top level entity
+   * and the whitespace and comments preceding it. The last chunk also contains any
+   * trailing input. Parsing the chunks one after another with parseEntities yields the
+   * same callbacks as parsing the entire input.
+   *
+   * Returns an empty vector if the input cannot be split, e.g. because the braces are
+   * unbalanced. The input must then be parsed as a whole so that errors are reported
+   * correctly.
+   */
+  std::vector<MapChunk> splitEntities();
+
   void parseEntities(ParserStatus& status);
   void parseBrushesOrPatches(ParserStatus& status);
   void parseBrushFaces(ParserStatus& status);
@@ -137,7 +187,7 @@ protected:
   void parsePatch(ParserStatus& status, const FileLocation& startLocation);
 
   std::tuple<vm::vec3d, vm::vec3d, vm::vec3d> parseFacePoints(ParserStatus& status);
-  std::string parseMaterialName(ParserStatus& status);
+  mdl::MaterialName parseMaterialName(ParserStatus& status);
   std::tuple<vm::vec3d, float, vm::vec3d, float> parseValveUVAxes(ParserStatus& status);
   std::tuple<vm::vec3d, vm::vec3d> parsePrimitiveUVAxes(ParserStatus& status);
 
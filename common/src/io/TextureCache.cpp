@@ -0,0 +1,536 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TextureCache.h"
+
+#include "Color.h"
+#include "io/DiskIO.h"
+#include "io/File.h"
+#include "io/Reader.h"
+#include "io/ReaderException.h"
+#include "mdl/Texture.h"
+#include "mdl/TextureBuffer.h"
+
+#include "kdl/hash_utils.h"
+#include "kdl/overload.h"
+#include "kdl/path_utils.h"
+#include "kdl/reflection_impl.h"
+#include "kdl/result.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <charconv>
+#include <optional>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace tb::io
+{
+namespace
+{
+
+/*
+ * Cache entries are written in native byte order. They are not meant to be shared
+ * between machines.
+ *
+ * Bump the version whenever the layout changes or a texture reader changes its output,
+ * so that stale entries are discarded.
+ */
+constexpr auto EntryMagic = std::string_view{"TBTX"};
+constexpr auto EntryVersion = uint32_t(2);
+constexpr auto EntryExtension = std::string_view{".tbtex"};
+constexpr auto MaxMipCount = uint32_t(32);
+
+uint64_t entryId(const TextureCacheKey& key)
+{
+  return uint64_t(kdl::hash(
+    key.pathHash, key.modificationTime, key.containerSize, key.parameterHash));
+}
+
+template <typename T>
+void append(std::string& data, const T& value)
+{
+  const auto* bytes = reinterpret_cast<const char*>(&value);
+  data.append(bytes, sizeof(T));
+}
+
+std::string serializeEntry(
+  const TextureCacheKey& key,
+  const mdl::Texture& texture,
+  const std::vector<mdl::TextureBuffer>& buffers)
+{
+  auto dataSize = size_t(128) + buffers.size() * sizeof(uint64_t);
+  for (const auto& buffer : buffers)
+  {
+    dataSize += buffer.size();
+  }
+
+  auto data = std::string{};
+  data.reserve(dataSize);
+
+  data.append(EntryMagic);
+  append(data, EntryVersion);
+  append(data, key.pathHash);
+  append(data, key.modificationTime);
+  append(data, key.containerSize);
+  append(data, key.parameterHash);
+
+  append(data, uint64_t(texture.width()));
+  append(data, uint64_t(texture.height()));
+  append(data, uint32_t(texture.format()));
+  append(data, uint32_t(texture.mask()));
+
+  const auto& averageColor = texture.averageColor();
+  append(data, averageColor.r());
+  append(data, averageColor.g());
+  append(data, averageColor.b());
+  append(data, averageColor.a());
+
+  std::visit(
+    kdl::overload(
+      [&](const mdl::NoEmbeddedDefaults&) {
+        append(data, uint32_t(0));
+        append(data, int32_t(0));
+        append(data, int32_t(0));
+        append(data, int32_t(0));
+      },
+      [&](const mdl::Q2EmbeddedDefaults& q2Defaults) {
+        append(data, uint32_t(1));
+        append(data, int32_t(q2Defaults.flags));
+        append(data, int32_t(q2Defaults.contents));
+        append(data, int32_t(q2Defaults.value));
+      }),
+    texture.embeddedDefaults());
+
+  append(data, uint32_t(buffers.size()));
+  for (const auto& buffer : buffers)
+  {
+    append(data, uint64_t(buffer.size()));
+  }
+  for (const auto& buffer : buffers)
+  {
+    data.append(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+  }
+
+  return data;
+}
+
+Result<mdl::Texture> readEntry(Reader reader, const TextureCacheKey& key)
+{
+  try
+  {
+    auto magic = std::string(EntryMagic.size(), '\0');
+    reader.read(magic.data(), magic.size());
+    if (magic != EntryMagic)
+    {
+      return Error{"Unknown texture cache entry format"};
+    }
+
+    if (reader.readUnsignedInt<uint32_t>() != EntryVersion)
+    {
+      return Error{"Outdated texture cache entry"};
+    }
+
+    const auto pathHash = reader.read<uint64_t, uint64_t>();
+    const auto modificationTime = reader.read<int64_t, int64_t>();
+    const auto containerSize = reader.read<uint64_t, uint64_t>();
+    const auto parameterHash = reader.read<uint64_t, uint64_t>();
+    if (
+      TextureCacheKey{pathHash, modificationTime, containerSize, parameterHash} != key)
+    {
+      return Error{"Texture cache entry does not match its key"};
+    }
+
+    const auto width = reader.readSize<uint64_t>();
+    const auto height = reader.readSize<uint64_t>();
+    const auto format = GLenum(reader.readUnsignedInt<uint32_t>());
+
+    const auto maskValue = reader.readUnsignedInt<uint32_t>();
+    if (maskValue > uint32_t(mdl::TextureMask::Off))
+    {
+      return Error{"Invalid texture mask in texture cache entry"};
+    }
+    const auto mask = mdl::TextureMask(maskValue);
+
+    const auto r = reader.read<float, float>();
+    const auto g = reader.read<float, float>();
+    const auto b = reader.read<float, float>();
+    const auto a = reader.read<float, float>();
+
+    const auto embeddedDefaultsType = reader.readUnsignedInt<uint32_t>();
+    const auto flags = reader.readInt<int32_t>();
+    const auto contents = reader.readInt<int32_t>();
+    const auto value = reader.readInt<int32_t>();
+    if (embeddedDefaultsType > 1)
+    {
+      return Error{"Invalid embedded defaults in texture cache entry"};
+    }
+    auto embeddedDefaults =
+      embeddedDefaultsType == 1
+        ? mdl::EmbeddedDefaults{mdl::Q2EmbeddedDefaults{flags, contents, value}}
+        : mdl::EmbeddedDefaults{mdl::NoEmbeddedDefaults{}};
+
+    const auto mipCount = reader.readUnsignedInt<uint32_t>();
+    if (mipCount == 0 || mipCount > MaxMipCount)
+    {
+      return Error{"Invalid mip count in texture cache entry"};
+    }
+
+    auto mipSizes = std::vector<size_t>{};
+    mipSizes.reserve(mipCount);
+    for (uint32_t i = 0; i < mipCount; ++i)
+    {
+      mipSizes.push_back(reader.readSize<uint64_t>());
+    }
+
+    auto buffers = std::vector<mdl::TextureBuffer>{};
+    buffers.reserve(mipCount);
+    for (const auto mipSize : mipSizes)
+    {
+      if (!reader.canRead(mipSize))
+      {
+        return Error{"Truncated texture cache entry"};
+      }
+
+      auto& buffer = buffers.emplace_back(mipSize);
+      reader.read(buffer.data(), mipSize);
+    }
+
+    return mdl::Texture{
+      width,
+      height,
+      Color{r, g, b, a},
+      format,
+      mask,
+      std::move(embeddedDefaults),
+      std::move(buffers)};
+  }
+  catch (const ReaderException& e)
+  {
+    return Error{e.what()};
+  }
+}
+
+Result<void> writeTempFile(const std::filesystem::path& tempPath, const std::string& data)
+{
+  return Disk::withOutputStream(
+    tempPath,
+    std::ios::out | std::ios::binary | std::ios::trunc,
+    [&](auto& stream) -> Result<void> {
+      stream.write(data.data(), std::streamsize(data.size()));
+      stream.flush();
+      if (!stream)
+      {
+        return Error{"Could not write file '" + tempPath.string() + "'"};
+      }
+      return kdl::void_success;
+    });
+}
+
+Result<void> moveTempFile(
+  const std::filesystem::path& tempPath, const std::filesystem::path& path)
+{
+  auto error = std::error_code{};
+  std::filesystem::rename(tempPath, path, error);
+  if (error)
+  {
+    std::filesystem::remove(tempPath, error);
+    return Error{"Could not rename '" + tempPath.string() + "'"};
+  }
+  return kdl::void_success;
+}
+
+std::optional<uint64_t> parseEntryId(const std::filesystem::path& path)
+{
+  if (path.extension() != EntryExtension)
+  {
+    return std::nullopt;
+  }
+
+  const auto stem = path.stem().string();
+  const auto* end = stem.data() + stem.size();
+
+  auto id = uint64_t(0);
+  const auto [ptr, error] = std::from_chars(stem.data(), end, id, 16);
+  return error == std::errc{} && ptr == end ? std::optional{id} : std::nullopt;
+}
+
+} // namespace
+
+kdl_reflect_impl(TextureCacheKey);
+
+Result<TextureCacheKey> makeTextureCacheKey(
+  const std::filesystem::path& containerPath,
+  const std::filesystem::path& path,
+  const uint64_t parameterHash)
+{
+  auto error = std::error_code{};
+  const auto containerSize = std::filesystem::file_size(containerPath, error);
+  if (error)
+  {
+    return Error{"Could not get size of '" + containerPath.string() + "'"};
+  }
+
+  const auto modificationTime = std::filesystem::last_write_time(containerPath, error);
+  if (error)
+  {
+    return Error{"Could not get modification time of '" + containerPath.string() + "'"};
+  }
+
+  return TextureCacheKey{
+    uint64_t(kdl::hash(containerPath.generic_string(), path.generic_string())),
+    int64_t(modificationTime.time_since_epoch().count()),
+    uint64_t(containerSize),
+    parameterHash};
+}
+
+TextureCache::TextureCache(std::filesystem::path directory, const size_t maxSize)
+  : m_directory{std::move(directory)}
+  , m_maxSize{maxSize}
+{
+}
+
+const std::filesystem::path& TextureCache::directory() const
+{
+  return m_directory;
+}
+
+size_t TextureCache::maxSize() const
+{
+  auto lock = std::lock_guard{m_mutex};
+  return m_maxSize;
+}
+
+void TextureCache::setMaxSize(const size_t maxSize)
+{
+  auto lock = std::lock_guard{m_mutex};
+  m_maxSize = maxSize;
+  evictEntries();
+}
+
+size_t TextureCache::size() const
+{
+  auto lock = std::lock_guard{m_mutex};
+  return m_size;
+}
+
+Result<mdl::Texture> TextureCache::load(const TextureCacheKey& key)
+{
+  const auto id = entryId(key);
+  const auto path = entryPath(id);
+
+  ensureIndexed();
+
+  // The entry may have been written by another instance, so we don't consult the index
+  // here. The entry is read without mapping it so that it can be removed while another
+  // thread or process is reading it.
+  auto entrySize = size_t(0);
+  auto invalid = false;
+  auto result = Disk::openCFile(path) | kdl::and_then([&](auto file) {
+                  entrySize = file->size();
+                  return readEntry(file->reader(), key)
+                         | kdl::or_else([&](auto e) -> Result<mdl::Texture> {
+                             invalid = true;
+                             return e;
+                           });
+                });
+
+  auto lock = std::lock_guard{m_mutex};
+  if (result.is_success())
+  {
+    // record the access so that the order survives restarts, this fails if another
+    // thread has evicted the entry after it was read
+    auto error = std::error_code{};
+    std::filesystem::last_write_time(
+      path, std::filesystem::file_time_type::clock::now(), error);
+
+    if (error)
+    {
+      removeEntry(id);
+    }
+    else if (const auto it = m_entries.find(id); it != m_entries.end())
+    {
+      m_lru.splice(m_lru.begin(), m_lru, it->second.lruPosition);
+    }
+    else
+    {
+      addEntry(id, entrySize);
+      evictEntries();
+    }
+  }
+  else
+  {
+    removeEntry(id);
+
+    // if the file could not be opened, it is gone and there is nothing to remove
+    if (invalid)
+    {
+      removeEntryFiles({EntryFile{id, entrySize}});
+    }
+  }
+
+  return result;
+}
+
+Result<void> TextureCache::store(const TextureCacheKey& key, const mdl::Texture& texture)
+{
+  const auto& buffers = texture.buffersIfLoaded();
+  if (buffers.empty())
+  {
+    return Error{"Texture buffers are not loaded"};
+  }
+
+  const auto id = entryId(key);
+  const auto path = entryPath(id);
+
+  // concurrent writers of the same entry must not share a temporary file
+  const auto threadId = std::hash<std::thread::id>{}(std::this_thread::get_id());
+  const auto tempPath = kdl::path_add_extension(path, fmt::format(".{:x}.tmp", threadId));
+
+  ensureIndexed();
+
+  const auto data = serializeEntry(key, texture, buffers);
+  return Disk::createDirectory(m_directory)
+         | kdl::and_then([&](auto) { return writeTempFile(tempPath, data); })
+         | kdl::and_then([&]() {
+             auto lock = std::lock_guard{m_mutex};
+             return moveTempFile(tempPath, path) | kdl::transform([&]() {
+                      removeEntry(id);
+                      addEntry(id, data.size());
+                      evictEntries();
+                    });
+           });
+}
+
+void TextureCache::clear()
+{
+  ensureIndexed();
+
+  auto lock = std::lock_guard{m_mutex};
+
+  auto removedEntries = std::vector<EntryFile>{};
+  removedEntries.reserve(m_entries.size());
+  for (const auto id : m_lru)
+  {
+    removedEntries.push_back(EntryFile{id, m_entries.at(id).size});
+  }
+
+  m_entries.clear();
+  m_lru.clear();
+  m_size = 0;
+
+  removeEntryFiles(removedEntries);
+}
+
+std::filesystem::path TextureCache::entryPath(const uint64_t id) const
+{
+  return m_directory / fmt::format("{:016x}{}", id, EntryExtension);
+}
+
+void TextureCache::ensureIndexed()
+{
+  std::call_once(m_indexed, [&]() {
+    // Other threads wait here until the index is complete, but the lock isn't held while
+    // the directory is listed.
+    auto entryFiles =
+      std::vector<std::tuple<std::filesystem::file_time_type, uint64_t, uint64_t>>{};
+
+    auto error = std::error_code{};
+    for (auto it = std::filesystem::directory_iterator{m_directory, error};
+         !error && it != std::filesystem::directory_iterator{};
+         it.increment(error))
+    {
+      auto entryError = std::error_code{};
+      if (const auto id = parseEntryId(it->path());
+          id && it->is_regular_file(entryError))
+      {
+        const auto size = it->file_size(entryError);
+        const auto lastUsed = it->last_write_time(entryError);
+        if (!entryError)
+        {
+          entryFiles.emplace_back(lastUsed, *id, size);
+        }
+      }
+    }
+
+    // the most recently used entries are added last so that they end up at the front
+    std::sort(entryFiles.begin(), entryFiles.end());
+
+    auto lock = std::lock_guard{m_mutex};
+    for (const auto& [lastUsed, id, size] : entryFiles)
+    {
+      if (!m_entries.contains(id))
+      {
+        addEntry(id, size);
+      }
+    }
+    evictEntries();
+  });
+}
+
+void TextureCache::addEntry(const uint64_t id, const uint64_t size)
+{
+  m_lru.push_front(id);
+  m_entries.emplace(id, Entry{size, m_lru.begin()});
+  m_size += size;
+}
+
+std::optional<TextureCache::EntryFile> TextureCache::removeEntry(const uint64_t id)
+{
+  if (const auto it = m_entries.find(id); it != m_entries.end())
+  {
+    const auto size = it->second.size;
+    m_size -= size;
+    m_lru.erase(it->second.lruPosition);
+    m_entries.erase(it);
+    return EntryFile{id, size};
+  }
+  return std::nullopt;
+}
+
+void TextureCache::evictEntries()
+{
+  auto evictedEntries = std::vector<EntryFile>{};
+  while (m_size > m_maxSize && !m_lru.empty())
+  {
+    evictedEntries.push_back(*removeEntry(m_lru.back()));
+  }
+  removeEntryFiles(evictedEntries);
+}
+
+void TextureCache::removeEntryFiles(const std::vector<EntryFile>& entryFiles)
+{
+  for (const auto& [id, size] : entryFiles)
+  {
+    // a missing file counts as removed
+    auto error = std::error_code{};
+    std::filesystem::remove(entryPath(id), error);
+    if (error)
+    {
+      m_lru.push_back(id);
+      m_entries.emplace(id, Entry{size, std::prev(m_lru.end())});
+      m_size += size;
+    }
+  }
+}
+
+} // namespace tb::io
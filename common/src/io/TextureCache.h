@@ -0,0 +1,170 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Result.h"
+
+#include "kdl/reflection_decl.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace tb::mdl
+{
+class Texture;
+} // namespace tb::mdl
+
+namespace tb::io
+{
+
+/**
+ * Identifies a decoded texture by the path of its source file, by the modification time
+ * and size of the file on the disk that contains it, and by a hash of the parameters
+ * that affect decoding, e.g. the palette or the texture mask.
+ *
+ * The container is the source file itself or the archive the source file is stored in.
+ * Computing the key only requires the container's metadata, not its contents.
+ *
+ * The hashes are computed with std::hash, which is only guaranteed to be stable within
+ * one build of the program. Entries written by a different build are not found and are
+ * eventually evicted.
+ */
+struct TextureCacheKey
+{
+  uint64_t pathHash;
+  int64_t modificationTime;
+  uint64_t containerSize;
+  uint64_t parameterHash;
+
+  kdl_reflect_decl(
+    TextureCacheKey, pathHash, modificationTime, containerSize, parameterHash);
+};
+
+/**
+ * Creates a key for the texture at the given path within the given container file.
+ *
+ * Returns an error if the container's metadata cannot be read.
+ */
+Result<TextureCacheKey> makeTextureCacheKey(
+  const std::filesystem::path& containerPath,
+  const std::filesystem::path& path,
+  uint64_t parameterHash);
+
+/**
+ * A persistent cache of decoded textures.
+ *
+ * Every entry is stored in its own file in the cache directory. An entry consists of a
+ * fixed size header containing the texture's metadata and the key it was stored under,
+ * followed by the sizes of the mip levels and the mip data, which is read directly into
+ * the texture's buffers.
+ *
+ * The cache keeps the total size of its entries below a given maximum by evicting the
+ * least recently used entries. The modification times of the entry files record when
+ * they were last used, so that the order survives restarts. Entry files that cannot be
+ * removed, e.g. because another process has them open on Windows, remain in the index
+ * and are evicted again later.
+ *
+ * All member functions are thread safe. Entries are read and written to temporary files
+ * without holding the internal lock, but entry files are only moved into place and
+ * removed while holding it, so that the index agrees with the cache directory. The cache
+ * is a best effort: Errors are returned to the caller, who is expected to fall back to
+ * decoding the texture.
+ */
+class TextureCache
+{
+private:
+  struct Entry
+  {
+    uint64_t size;
+    std::list<uint64_t>::iterator lruPosition;
+  };
+
+  struct EntryFile
+  {
+    uint64_t id;
+    uint64_t size;
+  };
+
+  std::filesystem::path m_directory;
+  std::once_flag m_indexed;
+
+  mutable std::mutex m_mutex;
+  size_t m_maxSize;
+  size_t m_size = 0;
+  std::unordered_map<uint64_t, Entry> m_entries;
+  // most recently used entry first
+  std::list<uint64_t> m_lru;
+
+public:
+  TextureCache(std::filesystem::path directory, size_t maxSize);
+
+  const std::filesystem::path& directory() const;
+
+  size_t maxSize() const;
+  void setMaxSize(size_t maxSize);
+
+  /**
+   * Returns the total size of all cache entries in bytes.
+   */
+  size_t size() const;
+
+  /**
+   * Loads the texture stored under the given key. Returns an error if there is no such
+   * entry or if it could not be read. Invalid entries are removed from the cache.
+   */
+  Result<mdl::Texture> load(const TextureCacheKey& key);
+
+  /**
+   * Stores the given texture under the given key, replacing any existing entry, and
+   * evicts the least recently used entries if the cache grows beyond its maximum size.
+   *
+   * Returns an error if the texture's buffers are not loaded or if the entry could not
+   * be written.
+   */
+  Result<void> store(const TextureCacheKey& key, const mdl::Texture& texture);
+
+  /**
+   * Removes all entries from the cache.
+   */
+  void clear();
+
+private:
+  std::filesystem::path entryPath(uint64_t id) const;
+  void ensureIndexed();
+
+  // these must be called while holding the lock
+  void addEntry(uint64_t id, uint64_t size);
+  std::optional<EntryFile> removeEntry(uint64_t id);
+  void evictEntries();
+
+  /**
+   * Removes the files of the given entries, which must have been removed from the index.
+   * Entries whose files cannot be removed are added back as the least recently used
+   * entries. Must be called while holding the lock.
+   */
+  void removeEntryFiles(const std::vector<EntryFile>& entryFiles);
+};
+
+} // namespace tb::io
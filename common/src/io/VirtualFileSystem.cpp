@@ -294,6 +294,25 @@ Result<std::shared_ptr<File>> VirtualFileSystem::doOpenFile(
   return Error{"'" + path.string() + "' not found"};
 }
 
+Result<std::filesystem::path> VirtualFileSystem::doGetContainerPath(
+  const std::filesystem::path& path) const
+{
+  for (auto it = m_mountPoints.rbegin(); it != m_mountPoints.rend(); ++it)
+  {
+    const auto& mountPoint = *it;
+    if (matches(mountPoint, path))
+    {
+      const auto pathSuffix = suffix(mountPoint, path);
+      if (mountPoint.mountedFileSystem->pathInfo(pathSuffix) != PathInfo::Unknown)
+      {
+        return mountPoint.mountedFileSystem->containerPath(pathSuffix);
+      }
+    }
+  }
+
+  return Error{"'" + path.string() + "' not found"};
+}
+
 WritableVirtualFileSystem::WritableVirtualFileSystem(
   VirtualFileSystem virtualFs, std::unique_ptr<WritableFileSystem> writableFs)
   : m_virtualFs{std::move(virtualFs)}
@@ -325,6 +344,12 @@ Result<std::shared_ptr<File>> WritableVirtualFileSystem::doOpenFile(
   return m_virtualFs.openFile(path);
 }
 
+Result<std::filesystem::path> WritableVirtualFileSystem::doGetContainerPath(
+  const std::filesystem::path& path) const
+{
+  return m_virtualFs.containerPath(path);
+}
+
 Result<void> WritableVirtualFileSystem::doCreateFile(
   const std::filesystem::path& path, const std::string& contents)
 {
@@ -70,6 +70,8 @@ protected:
     const std::filesystem::path& path, const TraversalMode& traversalMode) const override;
   Result<std::shared_ptr<File>> doOpenFile(
     const std::filesystem::path& path) const override;
+  Result<std::filesystem::path> doGetContainerPath(
+    const std::filesystem::path& path) const override;
 };
 
 class WritableVirtualFileSystem : public WritableFileSystem
@@ -93,6 +95,8 @@ private:
     const std::filesystem::path& path, const TraversalMode& traversalMode) const override;
   Result<std::shared_ptr<File>> doOpenFile(
     const std::filesystem::path& path) const override;
+  Result<std::filesystem::path> doGetContainerPath(
+    const std::filesystem::path& path) const override;
 
   Result<void> doCreateFile(
     const std::filesystem::path& path, const std::string& contents) override;
@@ -54,8 +54,11 @@ namespace WadEntryType
 // static const char WEPalette   = '@';
 }
 
-WadFileSystem::WadFileSystem(std::shared_ptr<CFile> file)
+// Wad files are copied into memory and not kept mapped so that they can be edited or
+// replaced by external tools while the file system exists.
+WadFileSystem::WadFileSystem(std::shared_ptr<MappedFile> file)
   : ImageFileSystem{file->buffer()}
+  , m_path{file->path()}
 {
 }
 
@@ -128,4 +131,11 @@ Result<void> WadFileSystem::doReadDirectory()
     return Error{e.what()};
   }
 }
+
+Result<std::filesystem::path> WadFileSystem::doGetContainerPath(
+  const std::filesystem::path&) const
+{
+  return m_path;
+}
+
 } // namespace tb::io
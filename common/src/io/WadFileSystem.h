@@ -22,6 +22,8 @@
 #include "Result.h"
 #include "io/ImageFileSystem.h"
 
+#include <filesystem>
+
 namespace tb::io
 {
 class FileSystem;
@@ -29,11 +31,16 @@ class OwningBufferFile;
 
 class WadFileSystem : public ImageFileSystem<OwningBufferFile>
 {
+private:
+  std::filesystem::path m_path;
+
 public:
-  explicit WadFileSystem(std::shared_ptr<CFile> file);
+  explicit WadFileSystem(std::shared_ptr<MappedFile> file);
 
 private:
   Result<void> doReadDirectory() override;
+  Result<std::filesystem::path> doGetContainerPath(
+    const std::filesystem::path& path) const override;
 };
 
 } // namespace tb::io
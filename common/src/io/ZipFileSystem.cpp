@@ -64,9 +64,10 @@ Result<void> ZipFileSystem::doReadDirectory()
 {
   mz_zip_zero_struct(&m_archive);
 
-  if (mz_zip_reader_init_cfile(&m_archive, m_file->file(), m_file->size(), 0) != MZ_TRUE)
+  if (
+    mz_zip_reader_init_mem(&m_archive, m_file->begin(), m_file->size(), 0) != MZ_TRUE)
   {
-    return Error{"Error calling mz_zip_reader_init_cfile"};
+    return Error{"Error calling mz_zip_reader_init_mem"};
   }
 
   const auto numFiles = mz_zip_reader_get_num_files(&m_archive);
@@ -110,4 +111,10 @@ Result<void> ZipFileSystem::doReadDirectory()
   return kdl::void_success;
 }
 
+Result<std::filesystem::path> ZipFileSystem::doGetContainerPath(
+  const std::filesystem::path&) const
+{
+  return m_file->path();
+}
+
 } // namespace tb::io
@@ -28,9 +28,9 @@
 
 namespace tb::io
 {
-class CFile;
+class MappedFile;
 
-class ZipFileSystem : public ImageFileSystem<CFile>
+class ZipFileSystem : public ImageFileSystem<MappedFile>
 {
 private:
   mz_zip_archive m_archive;
@@ -42,5 +42,7 @@ public:
 
 private:
   Result<void> doReadDirectory() override;
+  Result<std::filesystem::path> doGetContainerPath(
+    const std::filesystem::path& path) const override;
 };
 } // namespace tb::io
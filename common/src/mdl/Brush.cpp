@@ -50,36 +50,16 @@ namespace tb::mdl
 
 kdl_reflect_impl(Brush);
 
-class Brush::CopyCallback : public BrushGeometry::CopyCallback
-{
-public:
-  void faceWasCopied(
-    const BrushFaceGeometry* original, BrushFaceGeometry* copy) const override
-  {
-    copy->setPayload(original->payload());
-  }
-};
-
 Brush::Brush() {}
 
 Brush::Brush(const Brush& other)
   : m_faces{other.m_faces}
-  , m_geometry{
-      other.m_geometry
-        ? std::make_unique<BrushGeometry>(*other.m_geometry, CopyCallback())
-        : nullptr}
+  , m_geometry{other.m_geometry}
   , m_cachedColors{other.m_cachedColors}
 {
-  if (m_geometry)
+  for (size_t i = 0u; i < m_faces.size(); ++i)
   {
-    for (BrushFaceGeometry* faceGeometry : m_geometry->faces())
-    {
-      if (const auto faceIndex = faceGeometry->payload())
-      {
-        BrushFace& face = m_faces[*faceIndex];
-        face.setGeometry(faceGeometry);
-      }
-    }
+    m_faces[i].setGeometry(other.m_faces[i].geometry());
   }
 }
 
@@ -565,6 +545,11 @@ size_t Brush::edgeCount() const
   return m_geometry->edgeCount();
 }
 
+size_t Brush::geometryShareCount() const
+{
+  return size_t(m_geometry.use_count());
+}
+
 const Brush::EdgeList& Brush::edges() const
 {
   ensure(m_geometry != nullptr, "geometry is null");
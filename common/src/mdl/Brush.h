@@ -50,8 +50,6 @@ enum class MapFormat;
 class Brush
 {
 private:
-  class CopyCallback;
-
   /**
    * Epsilon value to use when finding a vertex after applying a vertex operation
    */
@@ -63,7 +61,13 @@ public:
 
 private:
   std::vector<BrushFace> m_faces;
-  std::unique_ptr<BrushGeometry> m_geometry;
+
+  /**
+   * The geometry is never modified once it has been built, so copies of a brush share it.
+   * The brush renderer uses vertex payloads as scratch space, which is safe because it
+   * runs on the main thread only.
+   */
+  std::shared_ptr<BrushGeometry> m_geometry;
   std::unordered_map<vm::vec3, Color> m_cachedColors;
 
   kdl_reflect_decl(Brush, m_faces);
@@ -178,6 +182,12 @@ public:
 
   size_t edgeCount() const;
   const EdgeList& edges() const;
+
+  /**
+   * Returns the number of brushes that share this brush's geometry, including this brush.
+   */
+  size_t geometryShareCount() const;
+
   bool containsPoint(const vm::vec3d& point) const;
 
   std::vector<const BrushFace*> incidentFaces(const BrushVertex* vertex) const;
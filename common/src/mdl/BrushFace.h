@@ -86,7 +86,11 @@ private:
   BrushFaceAttributes m_attributes;
 
   AssetReference<Material> m_materialReference;
-  std::unique_ptr<UVCoordSystem> m_uvCoordSystem;
+  /**
+   * Copies of a face share their UV coordinate system until one of them changes it, see
+   * uvCoordSystemForWriting().
+   */
+  std::shared_ptr<const UVCoordSystem> m_uvCoordSystem;
   BrushFaceGeometry* m_geometry = nullptr;
 
   mutable size_t m_lineNumber = 0;
@@ -201,6 +205,12 @@ public:
   void resetUVCoordSystemCache();
   const UVCoordSystem& uvCoordSystem() const;
 
+  /**
+   * Returns the number of faces that share this face's UV coordinate system, including
+   * this face.
+   */
+  size_t uvCoordSystemShareCount() const;
+
   const Material* material() const;
   vm::vec2f textureSize() const;
   vm::vec2f modOffset(const vm::vec2f& offset) const;
@@ -273,6 +283,12 @@ private:
     const vm::vec3d& point0, const vm::vec3d& point1, const vm::vec3d& point2);
   void correctPoints();
 
+  /**
+   * Returns the UV coordinate system of this face for modification. If it is shared with
+   * a copy of this face, it is cloned first.
+   */
+  UVCoordSystem& uvCoordSystemForWriting();
+
 public: // brush renderer
   /**
    * This is used to cache results of evaluating the BrushRenderer Filter.
@@ -31,12 +31,23 @@ namespace tb::mdl
 const std::string BrushFaceAttributes::NoMaterialName = "__TB_empty";
 
 BrushFaceAttributes::BrushFaceAttributes(std::string_view materialName)
+  : BrushFaceAttributes{MaterialName{materialName}}
+{
+}
+
+BrushFaceAttributes::BrushFaceAttributes(MaterialName materialName)
   : m_materialName{materialName}
 {
 }
 
 BrushFaceAttributes::BrushFaceAttributes(
   std::string_view materialName, const BrushFaceAttributes& other)
+  : BrushFaceAttributes{MaterialName{materialName}, other}
+{
+}
+
+BrushFaceAttributes::BrushFaceAttributes(
+  MaterialName materialName, const BrushFaceAttributes& other)
   : m_materialName{materialName}
   , m_offset{other.m_offset}
   , m_scale{other.m_scale}
@@ -51,6 +62,11 @@ BrushFaceAttributes::BrushFaceAttributes(
 kdl_reflect_impl(BrushFaceAttributes);
 
 const std::string& BrushFaceAttributes::materialName() const
+{
+  return m_materialName.str();
+}
+
+const MaterialName& BrushFaceAttributes::internedMaterialName() const
 {
   return m_materialName;
 }
@@ -133,6 +149,16 @@ bool BrushFaceAttributes::valid() const
 }
 
 bool BrushFaceAttributes::setMaterialName(const std::string& materialName)
+{
+  if (materialName != m_materialName.str())
+  {
+    m_materialName = MaterialName{materialName};
+    return true;
+  }
+  return false;
+}
+
+bool BrushFaceAttributes::setMaterialName(const MaterialName& materialName)
 {
   if (materialName != m_materialName)
   {
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "Color.h"
+#include "mdl/MaterialName.h"
 
 #include "kdl/reflection_decl.h"
 
@@ -39,7 +40,7 @@ public:
   static const std::string NoMaterialName;
 
 private:
-  std::string m_materialName;
+  MaterialName m_materialName;
 
   vm::vec2f m_offset = vm::vec2f{0, 0};
   vm::vec2f m_scale = vm::vec2f{1, 1};
@@ -53,7 +54,9 @@ private:
 
 public:
   explicit BrushFaceAttributes(std::string_view materialName);
+  explicit BrushFaceAttributes(MaterialName materialName);
   BrushFaceAttributes(std::string_view materialName, const BrushFaceAttributes& other);
+  BrushFaceAttributes(MaterialName materialName, const BrushFaceAttributes& other);
 
   kdl_reflect_decl(
     BrushFaceAttributes,
@@ -67,6 +70,7 @@ public:
     m_color);
 
   const std::string& materialName() const;
+  const MaterialName& internedMaterialName() const;
 
   const vm::vec2f& offset() const;
   float xOffset() const;
@@ -90,6 +94,7 @@ public:
   bool valid() const;
 
   bool setMaterialName(const std::string& materialName);
+  bool setMaterialName(const MaterialName& materialName);
   bool setOffset(const vm::vec2f& offset);
   bool setXOffset(float xOffset);
   bool setYOffset(float yOffset);
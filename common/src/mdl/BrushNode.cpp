@@ -128,6 +128,8 @@ void BrushNode::updateFaceTags(const size_t faceIndex, TagManager& tagManager)
 
 void BrushNode::setFaceMaterial(const size_t faceIndex, Material* material)
 {
+  // the revision is kept because only the material name is serialized, and it doesn't
+  // change here
   m_brush.face(faceIndex).setMaterial(material);
 
   invalidateIssues();
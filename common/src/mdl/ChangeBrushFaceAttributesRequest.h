@@ -20,6 +20,7 @@
 #pragma once
 
 #include "Color.h"
+#include "mdl/MaterialName.h"
 
 #include <optional>
 #include <string>
@@ -65,7 +66,7 @@ public:
   };
 
 private:
-  std::string m_materialName;
+  MaterialName m_materialName;
   float m_xOffset = 0.0f;
   float m_yOffset = 0.0f;
   float m_rotation = 0.0f;
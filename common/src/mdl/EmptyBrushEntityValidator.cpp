@@ -38,6 +38,7 @@ const auto Type = freeIssueType();
 EmptyBrushEntityValidator::EmptyBrushEntityValidator()
   : Validator{Type, "Empty brush entity"}
 {
+  markThreadSafe();
   addQuickFix(makeDeleteNodesQuickFix());
 }
 
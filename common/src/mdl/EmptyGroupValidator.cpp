@@ -36,6 +36,7 @@ const auto Type = freeIssueType();
 EmptyGroupValidator::EmptyGroupValidator()
   : Validator{Type, "Empty group"}
 {
+  markThreadSafe();
   addQuickFix(makeDeleteNodesQuickFix());
 }
 
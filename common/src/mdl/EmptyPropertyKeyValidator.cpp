@@ -36,6 +36,7 @@ const auto Type = freeIssueType();
 EmptyPropertyKeyValidator::EmptyPropertyKeyValidator()
   : Validator{Type, "Empty property name"}
 {
+  markThreadSafe();
   addQuickFix(makeRemoveEntityPropertiesQuickFix(Type));
 }
 
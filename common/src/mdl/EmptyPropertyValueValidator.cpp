@@ -37,6 +37,7 @@ const auto Type = freeIssueType();
 EmptyPropertyValueValidator::EmptyPropertyValueValidator()
   : Validator{Type, "Empty property value"}
 {
+  markThreadSafe();
   addQuickFix(makeRemoveEntityPropertiesQuickFix(Type));
 }
 
@@ -21,6 +21,7 @@
 
 #include "mdl/MaterialCollection.h"
 #include "mdl/Texture.h"
+#include "mdl/TriangleBvh.h"
 #include "render/IndexRangeMap.h"
 #include "render/MaterialIndexRangeMap.h"
 #include "render/MaterialIndexRangeRenderer.h"
@@ -30,7 +31,6 @@
 
 #include "vm/bbox.h"
 #include "vm/bbox_io.h" // IWYU pragma: keep
-#include "vm/intersection.h"
 
 #include <fmt/format.h>
 
@@ -78,6 +78,8 @@ std::ostream& operator<<(std::ostream& lhs, const Orientation rhs)
 }
 
 
+kdl_reflect_impl(EntityModelMemoryStats);
+
 // EntityModelFrame
 
 kdl_reflect_impl(EntityModelFrame);
@@ -87,10 +89,15 @@ EntityModelFrame::EntityModelFrame(
   : m_index{index}
   , m_name{std::move(name)}
   , m_bounds{bounds}
-  , m_spacialTree{16.0f}
 {
 }
 
+EntityModelFrame::EntityModelFrame(EntityModelFrame&& other) noexcept = default;
+EntityModelFrame& EntityModelFrame::operator=(EntityModelFrame&& other) noexcept =
+  default;
+
+EntityModelFrame::~EntityModelFrame() = default;
+
 size_t EntityModelFrame::index() const
 {
   return m_index;
@@ -116,24 +123,11 @@ const vm::bbox3f& EntityModelFrame::bounds() const
   return m_bounds;
 }
 
-std::optional<float> EntityModelFrame::intersect(const vm::ray3f& ray) const
+namespace
 {
-  auto closestDistance = std::optional<float>{};
-
-  const auto candidates = m_spacialTree.find_intersectors(ray);
-  for (const auto triNum : candidates)
-  {
-    const auto& p1 = m_tris[triNum * 3 + 0];
-    const auto& p2 = m_tris[triNum * 3 + 1];
-    const auto& p3 = m_tris[triNum * 3 + 2];
-    closestDistance =
-      vm::safe_min(closestDistance, vm::intersect_ray_triangle(ray, p1, p2, p3));
-  }
-
-  return closestDistance;
-}
 
-void EntityModelFrame::addToSpacialTree(
+void addTriangles(
+  std::vector<vm::vec3f>& tris,
   const std::vector<EntityModelVertex>& vertices,
   const render::PrimType primType,
   const size_t index,
@@ -148,45 +142,23 @@ void EntityModelFrame::addToSpacialTree(
     break;
   case render::PrimType::Triangles: {
     assert(count % 3 == 0);
-    m_tris.reserve(m_tris.size() + count);
     for (size_t i = 0; i < count; i += 3)
     {
-      auto bounds = vm::bbox3f::builder{};
-      const auto& p1 = render::getVertexComponent<0>(vertices[index + i + 0]);
-      const auto& p2 = render::getVertexComponent<0>(vertices[index + i + 1]);
-      const auto& p3 = render::getVertexComponent<0>(vertices[index + i + 2]);
-      bounds.add(p1);
-      bounds.add(p2);
-      bounds.add(p3);
-
-      const auto triIndex = m_tris.size() / 3u;
-      m_tris.push_back(p1);
-      m_tris.push_back(p2);
-      m_tris.push_back(p3);
-      m_spacialTree.insert(bounds.bounds(), triIndex);
+      tris.push_back(render::getVertexComponent<0>(vertices[index + i + 0]));
+      tris.push_back(render::getVertexComponent<0>(vertices[index + i + 1]));
+      tris.push_back(render::getVertexComponent<0>(vertices[index + i + 2]));
     }
     break;
   }
   case render::PrimType::Polygon:
   case render::PrimType::TriangleFan: {
     assert(count > 2);
-    m_tris.reserve(m_tris.size() + (count - 2) * 3);
-
     const auto& p1 = render::getVertexComponent<0>(vertices[index]);
     for (size_t i = 1; i < count - 1; ++i)
     {
-      auto bounds = vm::bbox3f::builder{};
-      const auto& p2 = render::getVertexComponent<0>(vertices[index + i]);
-      const auto& p3 = render::getVertexComponent<0>(vertices[index + i + 1]);
-      bounds.add(p1);
-      bounds.add(p2);
-      bounds.add(p3);
-
-      const auto triIndex = m_tris.size() / 3u;
-      m_tris.push_back(p1);
-      m_tris.push_back(p2);
-      m_tris.push_back(p3);
-      m_spacialTree.insert(bounds.bounds(), triIndex);
+      tris.push_back(p1);
+      tris.push_back(render::getVertexComponent<0>(vertices[index + i]));
+      tris.push_back(render::getVertexComponent<0>(vertices[index + i + 1]));
     }
     break;
   }
@@ -194,31 +166,22 @@ void EntityModelFrame::addToSpacialTree(
   case render::PrimType::QuadStrip:
   case render::PrimType::TriangleStrip: {
     assert(count > 2);
-    m_tris.reserve(m_tris.size() + (count - 2) * 3);
     for (size_t i = 0; i < count - 2; ++i)
     {
-      auto bounds = vm::bbox3f::builder{};
       const auto& p1 = render::getVertexComponent<0>(vertices[index + i + 0]);
       const auto& p2 = render::getVertexComponent<0>(vertices[index + i + 1]);
       const auto& p3 = render::getVertexComponent<0>(vertices[index + i + 2]);
-      bounds.add(p1);
-      bounds.add(p2);
-      bounds.add(p3);
-
-      const auto triIndex = m_tris.size() / 3u;
+      tris.push_back(p1);
       if (i % 2 == 0)
       {
-        m_tris.push_back(p1);
-        m_tris.push_back(p2);
-        m_tris.push_back(p3);
+        tris.push_back(p2);
+        tris.push_back(p3);
       }
       else
       {
-        m_tris.push_back(p1);
-        m_tris.push_back(p3);
-        m_tris.push_back(p2);
+        tris.push_back(p3);
+        tris.push_back(p2);
       }
-      m_spacialTree.insert(bounds.bounds(), triIndex);
     }
     break;
   }
@@ -226,6 +189,68 @@ void EntityModelFrame::addToSpacialTree(
   }
 }
 
+} // namespace
+
+std::optional<float> EntityModelFrame::intersect(const vm::ray3f& ray) const
+{
+  if (!m_pickData)
+  {
+    auto tris = std::vector<vm::vec3f>{};
+    for (const auto& primitives : m_pickPrimitives)
+    {
+      addTriangles(
+        tris,
+        *primitives.vertices,
+        primitives.primType,
+        primitives.index,
+        primitives.count);
+    }
+    m_pickData = std::make_unique<TriangleBvh>(std::move(tris));
+  }
+
+  m_lastPickTime = Clock::now();
+  return m_pickData->intersect(ray);
+}
+
+void EntityModelFrame::addPrimitives(
+  const std::vector<EntityModelVertex>& vertices,
+  const render::PrimType primType,
+  const size_t index,
+  const size_t count)
+{
+  m_pickPrimitives.push_back(PickPrimitives{&vertices, primType, index, count});
+  m_pickData.reset();
+}
+
+void EntityModelFrame::removePrimitives(const std::vector<EntityModelVertex>& vertices)
+{
+  std::erase_if(m_pickPrimitives, [&](const auto& primitives) {
+    return primitives.vertices == &vertices;
+  });
+  m_pickData.reset();
+}
+
+bool EntityModelFrame::hasPickData() const
+{
+  return m_pickData != nullptr;
+}
+
+size_t EntityModelFrame::pickDataSize() const
+{
+  return m_pickData ? m_pickData->memoryUsage() : 0;
+}
+
+size_t EntityModelFrame::releasePickData(const Clock::time_point unusedSince) const
+{
+  if (m_pickData && m_lastPickTime < unusedSince)
+  {
+    const auto size = m_pickData->memoryUsage();
+    m_pickData.reset();
+    return size;
+  }
+  return 0;
+}
+
 // EntityModelData::Mesh
 
 /**
@@ -252,6 +277,8 @@ public:
   virtual ~EntityModelMesh() = default;
 
 public:
+  const std::vector<EntityModelVertex>& vertices() const { return m_vertices; }
+
   /**
    * Returns a renderer that renders this mesh with the given material.
    *
@@ -309,7 +336,7 @@ public:
   {
     m_indices.forEachPrimitive(
       [&](const render::PrimType primType, const size_t index, const size_t count) {
-        frame.addToSpacialTree(m_vertices, primType, index, count);
+        frame.addPrimitives(m_vertices, primType, index, count);
       });
   }
 
@@ -355,7 +382,7 @@ public:
                                  const render::PrimType primType,
                                  const size_t index,
                                  const size_t count) {
-      frame.addToSpacialTree(m_vertices, primType, index, count);
+      frame.addPrimitives(m_vertices, primType, index, count);
     });
   }
 
@@ -387,6 +414,19 @@ const std::string& EntityModelSurface::name() const
   return m_name;
 }
 
+size_t EntityModelSurface::vertexBytes() const
+{
+  auto result = size_t(0);
+  for (const auto& mesh : m_meshes)
+  {
+    if (mesh)
+    {
+      result += mesh->vertices().capacity() * sizeof(EntityModelVertex);
+    }
+  }
+  return result;
+}
+
 void EntityModelSurface::upload(const bool glContextAvailable)
 {
   for (auto& material : m_skins->materials())
@@ -415,6 +455,7 @@ void EntityModelSurface::addMesh(
   render::IndexRangeMap indices)
 {
   assert(frame.index() < frameCount());
+  removeMesh(frame);
   m_meshes[frame.index()] = std::make_unique<EntityModelIndexedMesh>(
     frame, std::move(vertices), std::move(indices));
 }
@@ -425,10 +466,20 @@ void EntityModelSurface::addMesh(
   render::MaterialIndexRangeMap indices)
 {
   assert(frame.index() < frameCount());
+  removeMesh(frame);
   m_meshes[frame.index()] = std::make_unique<EntityModelMaterialMesh>(
     frame, std::move(vertices), std::move(indices));
 }
 
+void EntityModelSurface::removeMesh(EntityModelFrame& frame)
+{
+  if (auto& mesh = m_meshes[frame.index()])
+  {
+    frame.removePrimitives(mesh->vertices());
+    mesh.reset();
+  }
+}
+
 void EntityModelSurface::setSkins(std::vector<Material> skins)
 {
   m_skins = std::make_unique<MaterialCollection>(std::move(skins));
@@ -515,6 +566,39 @@ vm::bbox3f EntityModelData::bounds(const size_t frameIndex) const
   return frameIndex < m_frames.size() ? m_frames[frameIndex].bounds() : vm::bbox3f{8.0f};
 }
 
+EntityModelMemoryStats EntityModelData::memoryStats() const
+{
+  auto result = EntityModelMemoryStats{};
+  result.frameCount = m_frames.size();
+
+  for (const auto& frame : m_frames)
+  {
+    if (frame.hasPickData())
+    {
+      ++result.framesWithPickData;
+      result.pickDataBytes += frame.pickDataSize();
+    }
+  }
+
+  for (const auto& surface : m_surfaces)
+  {
+    result.vertexBytes += surface.vertexBytes();
+  }
+
+  return result;
+}
+
+size_t EntityModelData::releasePickData(
+  const std::chrono::steady_clock::time_point unusedSince) const
+{
+  auto result = size_t(0);
+  for (const auto& frame : m_frames)
+  {
+    result += frame.releasePickData(unusedSince);
+  }
+  return result;
+}
+
 void EntityModelData::upload(const bool glContextAvailable)
 {
   for (auto& surface : m_surfaces)
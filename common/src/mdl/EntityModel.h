@@ -21,23 +21,18 @@ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
 
 #include "mdl/EntityModelDataResource.h"
 #include "mdl/EntityModel_Forward.h"
-#include "octree.h"
 
 #include "kdl/reflection_decl.h"
 
 #include "vm/bbox.h"
+#include "vm/ray.h"
 
+#include <chrono>
 #include <memory>
 #include <optional>
 #include <string>
 #include <vector>
 
-namespace tb
-{
-template <typename T, typename U>
-class octree;
-}
-
 namespace tb::render
 {
 enum class PrimType;
@@ -51,6 +46,7 @@ namespace tb::mdl
 {
 class Material;
 class MaterialCollection;
+class TriangleBvh;
 
 enum class PitchType
 {
@@ -82,23 +78,54 @@ enum class Orientation
 
 std::ostream& operator<<(std::ostream& lhs, Orientation rhs);
 
+/**
+ * Memory used by an entity model, see EntityModelData::memoryStats.
+ */
+struct EntityModelMemoryStats
+{
+  size_t frameCount = 0;
+  size_t framesWithPickData = 0;
+  size_t vertexBytes = 0;
+  size_t pickDataBytes = 0;
+
+  kdl_reflect_decl(
+    EntityModelMemoryStats, frameCount, framesWithPickData, vertexBytes, pickDataBytes);
+};
+
 /**
  * One frame of the model. Since frames are loaded on demand, each frame has two possible
  * states: loaded and unloaded. These states are modeled as subclasses of this class.
+ *
+ * The data structure used for hit testing is only built when the frame is first
+ * intersected with a ray, since most frames of animated models are never picked. It can
+ * be released again if the frame was not picked for a while.
  */
 class EntityModelFrame
 {
 private:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * A range of primitives of one of the meshes of this frame. The vertices are owned by
+   * the mesh.
+   */
+  struct PickPrimitives
+  {
+    const std::vector<EntityModelVertex>* vertices;
+    render::PrimType primType;
+    size_t index;
+    size_t count;
+  };
+
   size_t m_index;
   std::string m_name;
   vm::bbox3f m_bounds;
   size_t m_skinOffset = 0;
 
   // For hit testing
-  std::vector<vm::vec3f> m_tris;
-  using TriNum = size_t;
-  using SpacialTree = octree<float, TriNum>;
-  SpacialTree m_spacialTree;
+  std::vector<PickPrimitives> m_pickPrimitives;
+  mutable std::unique_ptr<TriangleBvh> m_pickData;
+  mutable Clock::time_point m_lastPickTime;
 
   kdl_reflect_decl(EntityModelFrame, m_index, m_name, m_bounds, m_skinOffset);
 
@@ -110,6 +137,11 @@ public:
    */
   explicit EntityModelFrame(size_t index, std::string name, const vm::bbox3f& bounds);
 
+  EntityModelFrame(EntityModelFrame&& other) noexcept;
+  EntityModelFrame& operator=(EntityModelFrame&& other) noexcept;
+
+  ~EntityModelFrame();
+
   /**
    * Returns the index of this frame.
    *
@@ -143,6 +175,7 @@ public:
 
   /**
    * Intersects this frame with the given ray and returns the point of intersection.
+   * Builds the data structure for hit testing if necessary.
    *
    * @param ray the ray to intersect
    * @return the distance to the point of intersection or nullopt if the given ray does
@@ -151,7 +184,8 @@ public:
   std::optional<float> intersect(const vm::ray3f& ray) const;
 
   /**
-   * Adds the given primitives to the spacial tree for this frame.
+   * Registers the given primitives for hit testing. The given vertices are referenced
+   * by this frame, so they must outlive it or be removed by calling removePrimitives.
    *
    * @param vertices the vertices
    * @param primType the primitive type
@@ -159,11 +193,34 @@ public:
    * array
    * @param count the number of vertices that make up the primitive(s)
    */
-  void addToSpacialTree(
+  void addPrimitives(
     const std::vector<EntityModelVertex>& vertices,
     render::PrimType primType,
     size_t index,
     size_t count);
+
+  /**
+   * Removes all primitives that reference the given vertices.
+   */
+  void removePrimitives(const std::vector<EntityModelVertex>& vertices);
+
+  /**
+   * Indicates whether the data structure for hit testing has been built.
+   */
+  bool hasPickData() const;
+
+  /**
+   * Returns the number of bytes occupied by the data structure for hit testing.
+   */
+  size_t pickDataSize() const;
+
+  /**
+   * Releases the data structure for hit testing if this frame was not intersected since
+   * the given time. It will be rebuilt on the next call to intersect.
+   *
+   * @return the number of bytes released
+   */
+  size_t releasePickData(Clock::time_point unusedSince) const;
 };
 
 class EntityModelMesh;
@@ -205,6 +262,11 @@ public:
    */
   const std::string& name() const;
 
+  /**
+   * Returns the number of bytes occupied by the vertices of all meshes of this surface.
+   */
+  size_t vertexBytes() const;
+
   /**
    * Uploads the skin materials of this surface for rendering.
    */
@@ -279,6 +341,9 @@ public:
 
   std::unique_ptr<render::MaterialIndexRangeRenderer> buildRenderer(
     size_t skinIndex, size_t frameIndex) const;
+
+private:
+  void removeMesh(EntityModelFrame& frame);
 };
 
 /**
@@ -331,6 +396,20 @@ public:
    */
   vm::bbox3f bounds(size_t frameIndex) const;
 
+  /**
+   * Returns the memory used by the meshes of this model and by the data structures for
+   * hit testing that have been built for its frames.
+   */
+  EntityModelMemoryStats memoryStats() const;
+
+  /**
+   * Releases the data structures for hit testing of all frames that were not intersected
+   * since the given time.
+   *
+   * @return the number of bytes released
+   */
+  size_t releasePickData(std::chrono::steady_clock::time_point unusedSince) const;
+
   /**
    * Prepares this model for rendering by uploading its skin materials.
    */
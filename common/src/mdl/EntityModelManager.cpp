@@ -32,6 +32,7 @@
 #include "mdl/Resource.h"
 #include "render/MaterialIndexRangeRenderer.h"
 
+#include "kdl/overload.h"
 #include "kdl/range_to_vector.h"
 #include "kdl/result.h"
 
@@ -215,9 +216,31 @@ Result<EntityModel> EntityModelManager::loadModel(
   return Error{"Game is not set"};
 }
 
+size_t EntityModelManager::releasePickData(
+  const std::chrono::steady_clock::time_point unusedSince) const
+{
+  auto result = size_t(0);
+  for (const auto& [path, model] : m_models)
+  {
+    // don't call model.data() because that would request unloaded models to be loaded
+    result += std::visit(
+      kdl::overload(
+        [&](const ResourceLoaded<EntityModelData>& state) {
+          return state.resource.releasePickData(unusedSince);
+        },
+        [&](const ResourceReady<EntityModelData>& state) {
+          return state.resource.releasePickData(unusedSince);
+        },
+        [](const auto&) { return size_t(0); }),
+      model.dataResource().state());
+  }
+  return result;
+}
+
 void EntityModelManager::prepare(render::VboManager& vboManager)
 {
   prepareRenderers(vboManager);
+  releaseColdPickData();
 }
 
 void EntityModelManager::prepareRenderers(render::VboManager& vboManager)
@@ -228,4 +251,20 @@ void EntityModelManager::prepareRenderers(render::VboManager& vboManager)
   }
   m_unpreparedRenderers.clear();
 }
+
+void EntityModelManager::releaseColdPickData()
+{
+  using namespace std::chrono_literals;
+
+  // prepare is called for every rendered frame, so only check from time to time
+  const auto now = std::chrono::steady_clock::now();
+  if (now - m_lastPickDataRelease > 10s)
+  {
+    m_lastPickDataRelease = now;
+    if (const auto released = releasePickData(now - 1min); released > 0)
+    {
+      m_logger.debug() << "Released " << released << " bytes of entity model pick data";
+    }
+  }
+}
 } // namespace tb::mdl
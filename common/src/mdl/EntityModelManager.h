@@ -25,6 +25,7 @@
 
 #include "kdl/path_hash.h"
 
+#include <chrono>
 #include <filesystem>
 #include <memory>
 #include <unordered_map>
@@ -69,6 +70,8 @@ private:
 
   mutable std::vector<render::MaterialRenderer*> m_unpreparedRenderers;
 
+  std::chrono::steady_clock::time_point m_lastPickDataRelease;
+
 public:
   EntityModelManager(CreateEntityModelDataResource createResource, Logger& logger);
   ~EntityModelManager();
@@ -91,10 +94,19 @@ private:
   Result<EntityModel> loadModel(const std::filesystem::path& path) const;
 
 public:
+  /**
+   * Releases the hit testing data of all model frames that were not picked since the
+   * given time.
+   *
+   * @return the number of bytes released
+   */
+  size_t releasePickData(std::chrono::steady_clock::time_point unusedSince) const;
+
   void prepare(render::VboManager& vboManager);
 
 private:
   void prepareRenderers(render::VboManager& vboManager);
+  void releaseColdPickData();
 };
 
 } // namespace tb::mdl
@@ -108,6 +108,7 @@ public: // loading and writing map files
     Logger& logger) const = 0;
   virtual Result<void> writeMap(
     WorldNode& world, const std::filesystem::path& path) const = 0;
+  virtual void writeMapToStream(WorldNode& world, std::ostream& stream) const = 0;
   virtual Result<void> exportMap(
     WorldNode& world, const io::ExportOptions& options) const = 0;
 
@@ -244,15 +244,8 @@ Result<std::unique_ptr<WorldNode>> GameImpl::loadMap(
 Result<void> GameImpl::writeMap(
   WorldNode& world, const std::filesystem::path& path, const bool exporting) const
 {
-  return io::Disk::withOutputStream(path, [&](auto& stream) {
-    const auto mapFormatName = formatName(world.mapFormat());
-    stream << "// Game: " << config().name << "\n"
-           << "// Format: " << mapFormatName << "\n";
-
-    auto writer = io::NodeWriter{world, stream};
-    writer.setExporting(exporting);
-    writer.writeMap();
-  });
+  return io::Disk::withOutputStream(
+    path, [&](auto& stream) { writeMapToStream(world, stream, exporting); });
 }
 
 Result<void> GameImpl::writeMap(WorldNode& world, const std::filesystem::path& path) const
@@ -260,6 +253,23 @@ Result<void> GameImpl::writeMap(WorldNode& world, const std::filesystem::path& p
   return writeMap(world, path, false);
 }
 
+void GameImpl::writeMapToStream(
+  WorldNode& world, std::ostream& stream, const bool exporting) const
+{
+  const auto mapFormatName = formatName(world.mapFormat());
+  stream << "// Game: " << config().name << "\n"
+         << "// Format: " << mapFormatName << "\n";
+
+  auto writer = io::NodeWriter{world, stream};
+  writer.setExporting(exporting);
+  writer.writeMap();
+}
+
+void GameImpl::writeMapToStream(WorldNode& world, std::ostream& stream) const
+{
+  writeMapToStream(world, stream, false);
+}
+
 Result<void> GameImpl::exportMap(WorldNode& world, const io::ExportOptions& options) const
 {
   return std::visit(
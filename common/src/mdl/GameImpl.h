@@ -77,6 +77,8 @@ public: // implement Game interface
     WorldNode& world, const std::filesystem::path& path, bool exporting) const;
   Result<void> writeMap(
     WorldNode& world, const std::filesystem::path& path) const override;
+  void writeMapToStream(WorldNode& world, std::ostream& stream, bool exporting) const;
+  void writeMapToStream(WorldNode& world, std::ostream& stream) const override;
   Result<void> exportMap(
     WorldNode& world, const io::ExportOptions& options) const override;
 
@@ -69,6 +69,7 @@ IssueQuickFix makeResetUVScaleQuickFix()
 InvalidUVScaleValidator::InvalidUVScaleValidator()
   : Validator{Type, "Invalid UV scale"}
 {
+  markThreadSafe();
   addQuickFix(makeResetUVScaleQuickFix());
 }
 
@@ -36,6 +36,7 @@ const auto Type = freeIssueType();
 LinkSourceValidator::LinkSourceValidator()
   : Validator{Type, "Missing entity link source"}
 {
+  markThreadSafe();
   addQuickFix(makeRemoveEntityPropertiesQuickFix(Type));
 }
 
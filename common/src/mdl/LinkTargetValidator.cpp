@@ -52,6 +52,7 @@ void validateInternal(
 LinkTargetValidator::LinkTargetValidator()
   : Validator{Type, "Missing entity link target"}
 {
+  markThreadSafe();
   addQuickFix(makeRemoveEntityPropertiesQuickFix(Type));
 }
 
@@ -38,6 +38,7 @@ LongPropertyKeyValidator::LongPropertyKeyValidator(const size_t maxLength)
   : Validator{Type, "Long entity property keys"}
   , m_maxLength{maxLength}
 {
+  markThreadSafe();
   addQuickFix(makeRemoveEntityPropertiesQuickFix(Type));
 }
 
@@ -59,6 +59,7 @@ LongPropertyValueValidator::LongPropertyValueValidator(const size_t maxLength)
   : Validator{Type, "Long entity property value"}
   , m_maxLength{maxLength}
 {
+  markThreadSafe();
   addQuickFix(makeRemoveEntityPropertiesQuickFix(Type));
   addQuickFix(makeTruncatePropertyValueQuickFix(m_maxLength));
 }
@@ -45,13 +45,19 @@ MaterialManager::MaterialManager(Logger& logger)
 
 MaterialManager::~MaterialManager() = default;
 
+void MaterialManager::setTextureCache(std::shared_ptr<io::TextureCache> textureCache)
+{
+  m_textureCache = std::move(textureCache);
+}
+
 void MaterialManager::reload(
   const io::FileSystem& fs,
   const mdl::MaterialConfig& materialConfig,
   const CreateTextureResource& createResource)
 {
   clear();
-  io::loadMaterialCollections(fs, materialConfig, createResource, m_logger)
+  io::loadMaterialCollections(
+    fs, materialConfig, createResource, m_textureCache, m_logger)
     | kdl::transform([&](auto materialCollections) {
         for (auto& collection : materialCollections)
         {
@@ -92,8 +98,10 @@ void MaterialManager::clear()
 
 const Material* MaterialManager::material(const std::string& name) const
 {
-  auto it = m_materialsByName.find(kdl::str_to_lower(name));
-  return it != m_materialsByName.end() ? it->second : nullptr;
+  // don't intern the names of lookups, only the lower case names of the materials are
+  // interned and a name that was never interned cannot match any of them
+  const auto lowerName = MaterialName::find(kdl::str_to_lower(name));
+  return lowerName ? material(*lowerName) : nullptr;
 }
 
 Material* MaterialManager::material(const std::string& name)
@@ -101,6 +109,17 @@ Material* MaterialManager::material(const std::string& name)
   return const_cast<Material*>(const_cast<const MaterialManager*>(this)->material(name));
 }
 
+const Material* MaterialManager::material(const MaterialName& name) const
+{
+  auto it = m_materialsByName.find(name.lower());
+  return it != m_materialsByName.end() ? it->second : nullptr;
+}
+
+Material* MaterialManager::material(const MaterialName& name)
+{
+  return const_cast<Material*>(const_cast<const MaterialManager*>(this)->material(name));
+}
+
 const std::vector<const Material*> MaterialManager::findMaterialsByTextureResourceId(
   const std::vector<ResourceId>& textureResourceIds) const
 {
@@ -130,7 +149,7 @@ void MaterialManager::updateMaterials()
   {
     for (auto& material : collection.materials())
     {
-      const auto key = kdl::str_to_lower(material.name());
+      const auto key = MaterialName{material.name()}.lower();
 
       auto mIt = m_materialsByName.find(key);
       if (mIt != m_materialsByName.end())
@@ -20,9 +20,11 @@
 #pragma once
 
 #include "mdl/MaterialCollection.h"
+#include "mdl/MaterialName.h"
 #include "mdl/TextureResource.h"
 
 #include <filesystem>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -34,6 +36,7 @@ class Logger;
 namespace io
 {
 class FileSystem;
+class TextureCache;
 } // namespace io
 
 namespace mdl
@@ -51,16 +54,24 @@ class MaterialManager
 {
 private:
   Logger& m_logger;
+  std::shared_ptr<io::TextureCache> m_textureCache;
 
   std::vector<MaterialCollection> m_collections;
 
-  std::unordered_map<std::string, Material*> m_materialsByName;
+  // keyed by the lower case material names
+  std::unordered_map<MaterialName, Material*> m_materialsByName;
   std::vector<const Material*> m_materials;
 
 public:
   explicit MaterialManager(Logger& logger);
   ~MaterialManager();
 
+  /**
+   * Sets the cache that is used to look up decoded textures when materials are loaded.
+   * Pass nullptr to always decode the textures.
+   */
+  void setTextureCache(std::shared_ptr<io::TextureCache> textureCache);
+
   void reload(
     const io::FileSystem& fs,
     const mdl::MaterialConfig& materialConfig,
@@ -78,6 +89,9 @@ public:
   const Material* material(const std::string& name) const;
   Material* material(const std::string& name);
 
+  const Material* material(const MaterialName& name) const;
+  Material* material(const MaterialName& name);
+
   const std::vector<const Material*> findMaterialsByTextureResourceId(
     const std::vector<ResourceId>& textureResourceIds) const;
 
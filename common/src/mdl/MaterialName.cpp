@@ -0,0 +1,173 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MaterialName.h"
+
+#include "kdl/string_format.h"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+
+namespace tb::mdl
+{
+
+struct MaterialName::Entry
+{
+  std::string name;
+  const Entry* lower = nullptr;
+};
+
+namespace
+{
+
+/**
+ * The interned names are distributed over several independently locked shards because
+ * the faces of a map are parsed concurrently. Entries are never removed.
+ */
+template <typename Entry>
+struct Shard
+{
+  std::mutex mutex;
+  std::unordered_map<std::string_view, std::unique_ptr<Entry>> entries;
+};
+
+constexpr size_t ShardCount = 16;
+
+template <typename Entry>
+Shard<Entry>& shardFor(const std::string_view name)
+{
+  static auto shards = std::array<Shard<Entry>, ShardCount>{};
+  return shards[std::hash<std::string_view>{}(name) % ShardCount];
+}
+
+auto internedNameCount = std::atomic<size_t>{0};
+auto internedNameBytes = std::atomic<size_t>{0};
+
+} // namespace
+
+const MaterialName::Entry* MaterialName::intern(const std::string_view name)
+{
+  auto& shard = shardFor<Entry>(name);
+
+  {
+    const auto lock = std::lock_guard{shard.mutex};
+    if (const auto it = shard.entries.find(name); it != shard.entries.end())
+    {
+      return it->second.get();
+    }
+  }
+
+  // intern the lower case name first so that no two shards are locked at once
+  const auto lowerName = kdl::str_to_lower(name);
+  const auto* lower = lowerName != name ? intern(lowerName) : nullptr;
+
+  const auto lock = std::lock_guard{shard.mutex};
+  if (const auto it = shard.entries.find(name); it != shard.entries.end())
+  {
+    // another thread interned the name in the meantime
+    return it->second.get();
+  }
+
+  auto entry = std::make_unique<Entry>(Entry{std::string{name}, lower});
+  if (!entry->lower)
+  {
+    entry->lower = entry.get();
+  }
+
+  const auto* result = entry.get();
+  shard.entries.emplace(std::string_view{result->name}, std::move(entry));
+
+  internedNameCount += 1;
+  internedNameBytes += sizeof(Entry) + result->name.capacity() + 1;
+
+  return result;
+}
+
+std::optional<MaterialName> MaterialName::find(const std::string_view name)
+{
+  auto& shard = shardFor<Entry>(name);
+
+  const auto lock = std::lock_guard{shard.mutex};
+  if (const auto it = shard.entries.find(name); it != shard.entries.end())
+  {
+    return MaterialName{it->second.get()};
+  }
+  return std::nullopt;
+}
+
+MaterialName::MaterialName()
+  : MaterialName{std::string_view{}}
+{
+}
+
+MaterialName::MaterialName(const std::string_view name)
+  : m_entry{intern(name)}
+{
+}
+
+MaterialName::MaterialName(const Entry* entry)
+  : m_entry{entry}
+{
+}
+
+const std::string& MaterialName::str() const
+{
+  return m_entry->name;
+}
+
+bool MaterialName::empty() const
+{
+  return m_entry->name.empty();
+}
+
+MaterialName MaterialName::lower() const
+{
+  return MaterialName{m_entry->lower};
+}
+
+bool operator==(const MaterialName& lhs, const MaterialName& rhs)
+{
+  return lhs.m_entry == rhs.m_entry;
+}
+
+bool operator!=(const MaterialName& lhs, const MaterialName& rhs)
+{
+  return !(lhs == rhs);
+}
+
+std::ostream& operator<<(std::ostream& lhs, const MaterialName& rhs)
+{
+  return lhs << rhs.str();
+}
+
+size_t MaterialName::internedCount()
+{
+  return internedNameCount;
+}
+
+size_t MaterialName::internedBytes()
+{
+  return internedNameBytes;
+}
+
+} // namespace tb::mdl
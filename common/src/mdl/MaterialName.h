@@ -0,0 +1,98 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <functional>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace tb::mdl
+{
+
+/**
+ * A handle to an interned material name.
+ *
+ * Every distinct name is stored only once for the lifetime of the process, so copying,
+ * comparing and hashing handles only involves a pointer. This allows the faces of a map
+ * to share the storage of their material names, of which there are usually few.
+ *
+ * Material names are matched case insensitively when looking up materials, so every
+ * handle also refers to the handle of its lower case name.
+ *
+ * Handles can be created concurrently.
+ */
+class MaterialName
+{
+private:
+  struct Entry;
+  const Entry* m_entry;
+
+public:
+  /**
+   * Creates a handle to the empty name.
+   */
+  MaterialName();
+
+  explicit MaterialName(std::string_view name);
+
+  const std::string& str() const;
+  bool empty() const;
+
+  /**
+   * Returns a handle to the lower case variant of this name.
+   */
+  MaterialName lower() const;
+
+  /**
+   * Returns a handle to the given name if it has been interned already, and
+   * std::nullopt otherwise. Unlike the constructor, this never interns the name.
+   */
+  static std::optional<MaterialName> find(std::string_view name);
+
+  friend bool operator==(const MaterialName& lhs, const MaterialName& rhs);
+  friend bool operator!=(const MaterialName& lhs, const MaterialName& rhs);
+  friend std::ostream& operator<<(std::ostream& lhs, const MaterialName& rhs);
+
+  /**
+   * The number of interned names and the number of bytes they occupy.
+   */
+  static size_t internedCount();
+  static size_t internedBytes();
+
+private:
+  explicit MaterialName(const Entry* entry);
+
+  static const Entry* intern(std::string_view name);
+
+  friend struct std::hash<MaterialName>;
+};
+
+} // namespace tb::mdl
+
+template <>
+struct std::hash<tb::mdl::MaterialName>
+{
+  std::size_t operator()(const tb::mdl::MaterialName& materialName) const noexcept
+  {
+    return std::hash<const void*>{}(materialName.m_entry);
+  }
+};
@@ -37,6 +37,7 @@ const auto Type = freeIssueType();
 MissingClassnameValidator::MissingClassnameValidator()
   : Validator{Type, "Missing entity classname"}
 {
+  markThreadSafe();
   addQuickFix(makeDeleteNodesQuickFix());
 }
 
@@ -37,6 +37,7 @@ const auto Type = freeIssueType();
 MissingDefinitionValidator::MissingDefinitionValidator()
   : Validator{Type, "Missing entity definition"}
 {
+  markThreadSafe();
   addQuickFix(makeDeleteNodesQuickFix());
 }
 
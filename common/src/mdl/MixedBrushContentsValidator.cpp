@@ -37,6 +37,7 @@ const auto Type = freeIssueType();
 MixedBrushContentsValidator::MixedBrushContentsValidator()
   : Validator{Type, "Mixed brush content flags"}
 {
+  markThreadSafe();
 }
 
 void MixedBrushContentsValidator::doValidate(
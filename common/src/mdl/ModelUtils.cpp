@@ -23,10 +23,15 @@
 #include "mdl/BrushFace.h"
 #include "mdl/BrushFaceHandle.h"
 #include "mdl/EditorContext.h"
+#include "mdl/NodeContents.h"
 #include "mdl/NodeQueries.h"
+#include "mdl/UVCoordSystem.h"
 
+#include "kdl/overload.h"
 #include "kdl/vector_utils.h"
 
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace tb::mdl
@@ -161,6 +166,30 @@ std::map<Node*, std::vector<Node*>> parentChildrenMap(const std::vector<Node*>&
   return result;
 }
 
+/**
+ * Maps every object in the node tree of the given world to those of the given brushes
+ * whose bounds intersect the object's bounds. An object can only touch or be contained
+ * in a brush if their bounds intersect, so the objects that are missing from the
+ * returned map do not need to be tested against any brush.
+ */
+static std::unordered_map<const Node*, std::vector<const BrushNode*>> findCandidates(
+  const WorldNode& world, const std::vector<BrushNode*>& brushes)
+{
+  auto result = std::unordered_map<const Node*, std::vector<const BrushNode*>>{};
+  for (const auto* brush : brushes)
+  {
+    const auto& bounds = brush->physicalBounds();
+    for (const auto* node : world.nodeTree().find_intersectors(bounds))
+    {
+      if (bounds.intersects(node->physicalBounds()))
+      {
+        result[node].push_back(brush);
+      }
+    }
+  }
+  return result;
+}
+
 /**
  * Recursively collect brushes and entities from the given vector of node trees such that
  * the returned nodes match the given predicate. A matching brush is only returned if it
@@ -168,6 +197,10 @@ std::map<Node*, std::vector<Node*>> parentChildrenMap(const std::vector<Node*>&
  * brush in the given vector of brushes such that the predicate evaluates to true for that
  * pair of node and brush.
  *
+ * The objects below a world node are looked up in the world's node tree first, and the
+ * predicate is only evaluated for those brushes whose bounds intersect an object's
+ * bounds.
+ *
  * The given predicate must be a function that maps a node and a brush to true or false.
  */
 template <typename P>
@@ -178,8 +211,16 @@ static std::vector<Node*> collectMatchingNodes(
 {
   auto result = std::vector<Node*>{};
 
-  const auto collectIfMatching = [&](auto* node) {
-    for (const auto* brush : brushes)
+  const auto allBrushes = std::vector<const BrushNode*>{brushes.begin(), brushes.end()};
+  const auto queryBrushes =
+    std::unordered_set<const BrushNode*>{brushes.begin(), brushes.end()};
+  const auto noBrushes = std::vector<const BrushNode*>{};
+  const std::unordered_map<const Node*, std::vector<const BrushNode*>>* candidates =
+    nullptr;
+
+  const auto collectIfMatching = [&](auto* node,
+                                     const std::vector<const BrushNode*>& brushesToTest) {
+    for (const auto* brush : brushesToTest)
     {
       if (predicate(node, brush))
       {
@@ -189,10 +230,26 @@ static std::vector<Node*> collectMatchingNodes(
     }
   };
 
+  const auto collectObjectIfMatching = [&](auto* node) {
+    if (!candidates)
+    {
+      collectIfMatching(node, allBrushes);
+    }
+    else if (const auto it = candidates->find(node); it != candidates->end())
+    {
+      collectIfMatching(node, it->second);
+    }
+  };
+
   for (auto* node : nodes)
   {
     node->accept(kdl::overload(
-      [](auto&& thisLambda, WorldNode* world) { world->visitChildren(thisLambda); },
+      [&](auto&& thisLambda, WorldNode* world) {
+        const auto worldCandidates = findCandidates(*world, brushes);
+        candidates = &worldCandidates;
+        world->visitChildren(thisLambda);
+        candidates = nullptr;
+      },
       [](auto&& thisLambda, LayerNode* layer) { layer->visitChildren(thisLambda); },
       [&](auto&& thisLambda, GroupNode* group) {
         if (group->opened() || group->hasOpenedDescendant())
@@ -201,7 +258,7 @@ static std::vector<Node*> collectMatchingNodes(
         }
         else
         {
-          collectIfMatching(group);
+          collectIfMatching(group, allBrushes);
         }
       },
       [&](auto&& thisLambda, EntityNode* entity) {
@@ -211,19 +268,19 @@ static std::vector<Node*> collectMatchingNodes(
         }
         else
         {
-          collectIfMatching(entity);
+          collectObjectIfMatching(entity);
         }
       },
       [&](BrushNode* brush) {
         // if `brush` is one of the search query nodes, don't count it as touching
-        if (!kdl::vec_contains(brushes, brush))
+        if (queryBrushes.count(brush) == 0)
         {
-          collectIfMatching(brush);
+          collectObjectIfMatching(brush);
         }
       },
       [&](PatchNode* patch) {
         // if `patch` is one of the search query nodes, don't count it as touching
-        collectIfMatching(patch);
+        collectObjectIfMatching(patch);
       }));
   }
 
@@ -380,4 +437,102 @@ std::vector<EntityNode*> filterEntityNodes(const std::vector<Node*>& nodes)
   return result;
 }
 
+namespace
+{
+
+size_t estimateMemorySize(const std::string& str)
+{
+  return str.capacity() > sizeof(std::string) ? str.capacity() : 0u;
+}
+
+size_t estimateMemorySize(const Layer& layer)
+{
+  return sizeof(Layer) + estimateMemorySize(layer.name());
+}
+
+size_t estimateMemorySize(const Group& group)
+{
+  return sizeof(Group) + estimateMemorySize(group.name());
+}
+
+size_t estimateMemorySize(const Entity& entity)
+{
+  auto result = sizeof(Entity);
+  for (const auto& property : entity.properties())
+  {
+    result += sizeof(EntityProperty) + estimateMemorySize(property.key())
+              + estimateMemorySize(property.value());
+  }
+  for (const auto& key : entity.protectedProperties())
+  {
+    result += sizeof(std::string) + estimateMemorySize(key);
+  }
+  return result;
+}
+
+size_t estimateMemorySize(const Brush& brush)
+{
+  // material names are interned and therefore not accounted for
+  auto result = sizeof(Brush) + brush.faceCount() * sizeof(BrushFace)
+                + brush.colors().size() * (sizeof(vm::vec3) + sizeof(Color));
+
+  // the geometry and the UV coordinate systems are shared by copies of a brush, so their
+  // memory is split evenly among the owners to avoid counting it once per copy
+  const auto geometrySize =
+    sizeof(BrushGeometry) + brush.vertexCount() * sizeof(BrushVertex)
+    + brush.edgeCount() * (sizeof(BrushEdge) + 2u * sizeof(BrushHalfEdge))
+    + brush.faceCount() * sizeof(BrushFaceGeometry);
+  result += geometrySize / brush.geometryShareCount();
+
+  for (const auto& face : brush.faces())
+  {
+    result += sizeof(UVCoordSystem) / face.uvCoordSystemShareCount();
+  }
+
+  return result;
+}
+
+size_t estimateMemorySize(const BezierPatch& patch)
+{
+  return sizeof(BezierPatch) + patch.controlPoints().size() * sizeof(BezierPatch::Point)
+         + estimateMemorySize(patch.materialName());
+}
+
+} // namespace
+
+size_t estimateMemorySize(const Node& node)
+{
+  auto result = size_t(0);
+  node.accept(kdl::overload(
+    [&](auto&& thisLambda, const WorldNode* world) {
+      result += sizeof(WorldNode) + estimateMemorySize(world->entity());
+      world->visitChildren(thisLambda);
+    },
+    [&](auto&& thisLambda, const LayerNode* layer) {
+      result += sizeof(LayerNode) + estimateMemorySize(layer->layer());
+      layer->visitChildren(thisLambda);
+    },
+    [&](auto&& thisLambda, const GroupNode* group) {
+      result += sizeof(GroupNode) + estimateMemorySize(group->group());
+      group->visitChildren(thisLambda);
+    },
+    [&](auto&& thisLambda, const EntityNode* entity) {
+      result += sizeof(EntityNode) + estimateMemorySize(entity->entity());
+      entity->visitChildren(thisLambda);
+    },
+    [&](const BrushNode* brush) {
+      result += sizeof(BrushNode) + estimateMemorySize(brush->brush());
+    },
+    [&](const PatchNode* patch) {
+      result += sizeof(PatchNode) + estimateMemorySize(patch->patch());
+    }));
+  return result;
+}
+
+size_t estimateMemorySize(const NodeContents& contents)
+{
+  return std::visit(
+    [](const auto& x) -> size_t { return estimateMemorySize(x); }, contents.get());
+}
+
 } // namespace tb::mdl
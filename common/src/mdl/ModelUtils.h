@@ -36,6 +36,7 @@ class BrushNode;
 class EntityNode;
 class LayerNode;
 class EditorContext;
+class NodeContents;
 
 HitType::Type nodeHitType();
 
@@ -80,4 +81,16 @@ vm::bbox3d computePhysicalBounds(
 std::vector<BrushNode*> filterBrushNodes(const std::vector<Node*>& nodes);
 std::vector<EntityNode*> filterEntityNodes(const std::vector<Node*>& nodes);
 
+/**
+ * Returns an estimate of the memory in bytes that is held by the given node and its
+ * descendants. The estimate accounts for the node contents and the brush geometry, but
+ * not for shared assets such as materials or entity models.
+ */
+size_t estimateMemorySize(const Node& node);
+
+/**
+ * Returns an estimate of the memory in bytes that is held by the given node contents.
+ */
+size_t estimateMemorySize(const NodeContents& contents);
+
 } // namespace tb::mdl
@@ -25,10 +25,12 @@
 #include "mdl/Issue.h"
 #include "mdl/Validator.h"
 
+#include "kdl/parallel.h"
 #include "kdl/range_utils.h"
 #include "kdl/reflection_impl.h"
 #include "kdl/vector_utils.h"
 
+#include <atomic>
 #include <cassert>
 #include <iterator>
 #include <string>
@@ -39,7 +41,10 @@ namespace tb::mdl
 
 kdl_reflect_impl(NodePath);
 
-Node::Node() = default;
+Node::Node()
+  : m_revision{nextRevision()}
+{
+}
 
 Node::~Node()
 {
@@ -475,6 +480,7 @@ void Node::nodeWillChange()
 
 void Node::nodeDidChange()
 {
+  updateRevision();
   if (m_parent)
   {
     m_parent->childDidChange(this);
@@ -804,6 +810,22 @@ bool Node::containsLine(const size_t lineNumber) const
   return lineNumber >= m_lineNumber && lineNumber < m_lineNumber + m_lineCount;
 }
 
+size_t Node::revision() const
+{
+  return m_revision;
+}
+
+void Node::updateRevision()
+{
+  m_revision = nextRevision();
+}
+
+size_t Node::nextRevision()
+{
+  static auto revision = std::atomic<size_t>{0};
+  return ++revision;
+}
+
 std::vector<const Issue*> Node::issues(const std::vector<const Validator*>& validators)
 {
   validateIssues(validators);
@@ -840,6 +862,37 @@ void Node::validateIssues(const std::vector<const Validator*>& validators)
   }
 }
 
+void Node::validateIssues(
+  const std::vector<Node*>& nodes, const std::vector<const Validator*>& validators)
+{
+  constexpr auto BatchSize = size_t(256);
+
+  const auto invalidNodes =
+    kdl::vec_filter(nodes, [](const auto* node) { return !node->m_issuesValid; });
+
+  const auto threadSafeValidators = kdl::vec_filter(
+    validators, [](const auto* validator) { return validator->threadSafe(); });
+  const auto otherValidators = kdl::vec_filter(
+    validators, [](const auto* validator) { return !validator->threadSafe(); });
+
+  kdl::parallel_for(invalidNodes.size(), BatchSize, [&](const auto i) {
+    auto* node = invalidNodes[i];
+    for (const auto* validator : threadSafeValidators)
+    {
+      validator->validate(*node, node->m_issues);
+    }
+  });
+
+  for (auto* node : invalidNodes)
+  {
+    for (const auto* validator : otherValidators)
+    {
+      validator->validate(*node, node->m_issues);
+    }
+    node->m_issuesValid = true;
+  }
+}
+
 void Node::invalidateIssues() const
 {
   m_issues.clear();
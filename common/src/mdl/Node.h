@@ -74,6 +74,8 @@ private:
   mutable size_t m_lineNumber = 0;
   mutable size_t m_lineCount = 0;
 
+  size_t m_revision;
+
   mutable std::vector<std::unique_ptr<Issue>> m_issues;
   mutable bool m_issuesValid = false;
   IssueType m_hiddenIssues = 0;
@@ -348,9 +350,36 @@ public: // file position
   void setFilePosition(size_t lineNumber, size_t lineCount) const;
   bool containsLine(size_t lineNumber) const;
 
+public: // revision
+  /**
+   * Returns a number that identifies the current contents of this node. The revision
+   * changes whenever this node changes, and no two nodes ever share a revision, even if
+   * one of them has been deleted.
+   */
+  size_t revision() const;
+
+protected:
+  /**
+   * Assigns a new revision to this node. This is done automatically when this node
+   * notifies its parent of a change, but subclasses must call this if they change in
+   * other ways.
+   */
+  void updateRevision();
+
+private:
+  static size_t nextRevision();
+
 public: // issue management
   std::vector<const Issue*> issues(const std::vector<const Validator*>& validators);
 
+  /**
+   * Validates the issues of all given nodes whose issues are not valid. The thread safe
+   * validators run on worker threads, processing the nodes in batches, while the
+   * remaining validators run on the calling thread afterwards.
+   */
+  static void validateIssues(
+    const std::vector<Node*>& nodes, const std::vector<const Validator*>& validators);
+
   bool issueHidden(IssueType type) const;
   void setIssueHidden(IssueType type, bool hidden);
 
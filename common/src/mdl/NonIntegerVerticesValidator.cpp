@@ -43,6 +43,7 @@ IssueQuickFix makeSnapVerticesQuickFix()
 NonIntegerVerticesValidator::NonIntegerVerticesValidator()
   : Validator{Type, "Non-integer vertices"}
 {
+  markThreadSafe();
   addQuickFix(makeSnapVerticesQuickFix());
 }
 
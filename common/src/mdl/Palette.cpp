@@ -30,15 +30,188 @@
 #include "kdl/reflection_impl.h"
 #include "kdl/string_format.h"
 
+#include <cstdint>
 #include <cstring>
 #include <ostream>
 #include <string>
 
+#if defined(__x86_64__) || defined(_M_X64)
+#define TB_PALETTE_AVX2 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define TB_TARGET_AVX2
+#else
+#define TB_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
 namespace tb::mdl
 {
 
 kdl_reflect_impl(PaletteData);
 
+namespace
+{
+
+struct ConversionResult
+{
+  uint64_t colorSum[3] = {0, 0, 0};
+  unsigned char andAlpha = 0xFF;
+};
+
+/**
+ * Converts the given indices to RGBA pixels using the given palette. Instead of summing
+ * the color channels of every pixel, the palette indices are counted, and the channel
+ * sums and the bitwise AND of the alpha channel are computed from the used palette
+ * entries afterwards.
+ */
+void convertScalar(
+  const unsigned char* indices,
+  const size_t count,
+  const unsigned char* paletteData,
+  unsigned char* rgbaData,
+  ConversionResult& result)
+{
+  uint32_t histogram[256] = {};
+  for (size_t i = 0; i < count; ++i)
+  {
+    const auto index = indices[i];
+    std::memcpy(rgbaData + i * 4, paletteData + size_t(index) * 4, 4);
+    ++histogram[index];
+  }
+
+  for (size_t index = 0; index < 256; ++index)
+  {
+    if (const auto n = histogram[index])
+    {
+      const auto* color = paletteData + index * 4;
+      result.colorSum[0] += uint64_t(n) * color[0];
+      result.colorSum[1] += uint64_t(n) * color[1];
+      result.colorSum[2] += uint64_t(n) * color[2];
+      result.andAlpha = static_cast<unsigned char>(result.andAlpha & color[3]);
+    }
+  }
+}
+
+#ifdef TB_PALETTE_AVX2
+
+bool hasAvx2()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7)
+  {
+    return false;
+  }
+
+  // the OS must save the AVX registers on context switches
+  __cpuid(info, 1);
+  const auto osxsave = (info[2] & (1 << 27)) != 0;
+  if (!osxsave || (_xgetbv(0) & 0x6) != 0x6)
+  {
+    return false;
+  }
+
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  return __builtin_cpu_supports("avx2");
+#endif
+}
+
+/**
+ * Converts eight pixels per iteration by gathering their palette entries. The color
+ * channels are summed with SAD instructions so that the accumulators cannot overflow.
+ * Returns the number of pixels converted, the remainder is left to the caller.
+ */
+TB_TARGET_AVX2 size_t convertAvx2(
+  const unsigned char* indices,
+  const size_t count,
+  const unsigned char* paletteData,
+  unsigned char* rgbaData,
+  ConversionResult& result)
+{
+  const auto* palette = reinterpret_cast<const int*>(paletteData);
+  const auto zero = _mm256_setzero_si256();
+  const auto redMask = _mm256_set1_epi32(0x000000FF);
+  const auto greenMask = _mm256_set1_epi32(0x0000FF00);
+  const auto blueMask = _mm256_set1_epi32(0x00FF0000);
+
+  auto redSum = zero;
+  auto greenSum = zero;
+  auto blueSum = zero;
+  auto andPixels = _mm256_set1_epi32(-1);
+
+  const auto blockCount = count / 8;
+  for (size_t i = 0; i < blockCount; ++i)
+  {
+    const auto packedIndices =
+      _mm_loadl_epi64(reinterpret_cast<const __m128i*>(indices + i * 8));
+    const auto pixels =
+      _mm256_i32gather_epi32(palette, _mm256_cvtepu8_epi32(packedIndices), 4);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(rgbaData + i * 32), pixels);
+
+    redSum = _mm256_add_epi64(
+      redSum, _mm256_sad_epu8(_mm256_and_si256(pixels, redMask), zero));
+    greenSum = _mm256_add_epi64(
+      greenSum, _mm256_sad_epu8(_mm256_and_si256(pixels, greenMask), zero));
+    blueSum = _mm256_add_epi64(
+      blueSum, _mm256_sad_epu8(_mm256_and_si256(pixels, blueMask), zero));
+    andPixels = _mm256_and_si256(andPixels, pixels);
+  }
+
+  alignas(32) uint64_t sums[3][4];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(sums[0]), redSum);
+  _mm256_store_si256(reinterpret_cast<__m256i*>(sums[1]), greenSum);
+  _mm256_store_si256(reinterpret_cast<__m256i*>(sums[2]), blueSum);
+
+  alignas(32) uint32_t andValues[8];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(andValues), andPixels);
+
+  for (size_t c = 0; c < 3; ++c)
+  {
+    result.colorSum[c] += sums[c][0] + sums[c][1] + sums[c][2] + sums[c][3];
+  }
+  for (const auto andValue : andValues)
+  {
+    result.andAlpha = static_cast<unsigned char>(result.andAlpha & (andValue >> 24));
+  }
+
+  return blockCount * 8;
+}
+
+#endif
+
+ConversionResult convert(
+  const unsigned char* indices,
+  const size_t count,
+  const unsigned char* paletteData,
+  unsigned char* rgbaData)
+{
+  auto result = ConversionResult{};
+  auto converted = size_t(0);
+
+#ifdef TB_PALETTE_AVX2
+  static const auto useAvx2 = hasAvx2();
+  if (useAvx2)
+  {
+    converted = convertAvx2(indices, count, paletteData, rgbaData, result);
+  }
+#endif
+
+  convertScalar(
+    indices + converted,
+    count - converted,
+    paletteData,
+    rgbaData + converted * 4,
+    result);
+  return result;
+}
+
+} // namespace
+
 std::ostream& operator<<(std::ostream& lhs, const PaletteColorFormat rhs)
 {
   switch (rhs)
@@ -60,6 +233,11 @@ Palette::Palette(std::shared_ptr<PaletteData> data)
 {
 }
 
+const PaletteData& Palette::data() const
+{
+  return *m_data;
+}
+
 bool Palette::indexedToRgba(
   io::Reader& reader,
   const size_t pixelCount,
@@ -67,49 +245,42 @@ bool Palette::indexedToRgba(
   const PaletteTransparency transparency,
   Color& averageColor) const
 {
+  const auto position = reader.position();
+  // throws if the reader doesn't have enough data
+  reader.seekForward(pixelCount);
+
+  // doesn't copy the data if the reader is backed by a memory buffer
+  const auto indexReader = reader.subReaderFromBegin(position, pixelCount).buffer();
+  return indexedToRgba(
+    {reinterpret_cast<const unsigned char*>(indexReader.begin()), pixelCount},
+    rgbaImage,
+    transparency,
+    averageColor);
+}
+
+bool Palette::indexedToRgba(
+  const std::span<const unsigned char> indices,
+  TextureBuffer& rgbaImage,
+  const PaletteTransparency transparency,
+  Color& averageColor) const
+{
+  const auto pixelCount = indices.size();
   ensure(rgbaImage.size() == 4 * pixelCount, "incorrect destination buffer size");
 
   const unsigned char* paletteData = (transparency == PaletteTransparency::Opaque)
                                        ? m_data->opaqueData.data()
                                        : m_data->index255TransparentData.data();
 
-  // Write rgba pixels
-  auto* const rgbaData = rgbaImage.data();
-  for (size_t i = 0; i < pixelCount; ++i)
-  {
-    const int index = reader.readInt<unsigned char>();
+  const auto result = convert(indices.data(), pixelCount, paletteData, rgbaImage.data());
 
-    std::memcpy(rgbaData + (i * 4), &paletteData[index * 4], 4);
-  }
-
-  // Check average color
-  uint32_t colorSum[3] = {0, 0, 0};
-  for (size_t i = 0; i < pixelCount; ++i)
-  {
-    colorSum[0] += uint32_t(rgbaData[(i * 4) + 0]);
-    colorSum[1] += uint32_t(rgbaData[(i * 4) + 1]);
-    colorSum[2] += uint32_t(rgbaData[(i * 4) + 2]);
-  }
   averageColor = Color{
-    float(colorSum[0]) / (255.0f * float(pixelCount)),
-    float(colorSum[1]) / (255.0f * float(pixelCount)),
-    float(colorSum[2]) / (255.0f * float(pixelCount)),
+    float(result.colorSum[0]) / (255.0f * float(pixelCount)),
+    float(result.colorSum[1]) / (255.0f * float(pixelCount)),
+    float(result.colorSum[2]) / (255.0f * float(pixelCount)),
     1.0f};
 
-  // Check for transparency
-  auto hasTransparency = false;
-  if (transparency == PaletteTransparency::Index255Transparent)
-  {
-    // Take the bitwise AND of the alpha channel of all pixels
-    unsigned char andAlpha = 0xFF;
-    for (size_t i = 0; i < pixelCount; ++i)
-    {
-      andAlpha = static_cast<unsigned char>(andAlpha & rgbaData[4 * i + 3]);
-    }
-    hasTransparency = (andAlpha != 0xFF);
-  }
-
-  return hasTransparency;
+  return transparency == PaletteTransparency::Index255Transparent
+         && result.andAlpha != 0xFF;
 }
 
 bool operator==(const Palette& lhs, const Palette& rhs)
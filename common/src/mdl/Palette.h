@@ -28,6 +28,7 @@
 #include <filesystem>
 #include <iosfwd>
 #include <memory>
+#include <span>
 #include <vector>
 
 namespace tb::io
@@ -76,6 +77,8 @@ private:
 public:
   explicit Palette(std::shared_ptr<PaletteData> m_data);
 
+  const PaletteData& data() const;
+
   /**
    * Reads `pixelCount` bytes from `reader` where each byte is a palette index,
    * and writes `pixelCount` * 4 bytes to `rgbaImage` using the palette to convert
@@ -101,6 +104,28 @@ public:
     PaletteTransparency transparency,
     Color& averageColor) const;
 
+  /**
+   * Converts the given palette indices to RGBA and writes the pixels to `rgbaImage`.
+   * The average color and the transparency are computed in the same pass over the
+   * pixels.
+   *
+   * Must not be called if `initialized()` is false.
+   *
+   * @param indices the palette indices, one byte per pixel
+   * @param rgbaImage the destination buffer, size must be exactly `indices.size()` * 4
+   * bytes
+   * @param transparency controls whether or not the palette contains a transparent index
+   * @param averageColor output parameter for the average color of the generated pixel
+   * buffer
+   * @return true if the given index buffer did contain a transparent index, unless the
+   * transparency parameter indicates that the image is opaque
+   */
+  bool indexedToRgba(
+    std::span<const unsigned char> indices,
+    TextureBuffer& rgbaImage,
+    PaletteTransparency transparency,
+    Color& averageColor) const;
+
   friend bool operator==(const Palette& lhs, const Palette& rhs);
   friend bool operator!=(const Palette& lhs, const Palette& rhs);
   friend std::ostream& operator<<(std::ostream& lhs, const Palette& rhs);
@@ -64,6 +64,7 @@ IssueQuickFix makeMoveBrushesToWorldQuickFix()
 PointEntityWithBrushesValidator::PointEntityWithBrushesValidator()
   : Validator{Type, "Point entity with brushes"}
 {
+  markThreadSafe();
   addQuickFix(makeMoveBrushesToWorldQuickFix());
 }
 
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "kdl/intrusive_circular_list.h"
+#include "kdl/pool_allocated.h"
 
 #include "vm/bbox.h"
 #include "vm/plane.h"
@@ -79,6 +80,7 @@ struct Polyhedron_GetVertexLink
  */
 template <typename T, typename FP, typename VP>
 class Polyhedron_Vertex
+  : public kdl::pool_allocated<Polyhedron_Vertex<T, FP, VP>>
 {
 private:
   friend class Polyhedron<T, FP, VP>;
@@ -234,6 +236,7 @@ struct Polyhedron_GetEdgeLink
  */
 template <typename T, typename FP, typename VP>
 class Polyhedron_Edge
+  : public kdl::pool_allocated<Polyhedron_Edge<T, FP, VP>>
 {
 private:
   friend class Polyhedron<T, FP, VP>;
@@ -550,6 +553,7 @@ struct Polyhedron_GetHalfEdgeLink
  */
 template <typename T, typename FP, typename VP>
 class Polyhedron_HalfEdge
+  : public kdl::pool_allocated<Polyhedron_HalfEdge<T, FP, VP>>
 {
 private:
   friend class Polyhedron<T, FP, VP>;
@@ -775,6 +779,7 @@ struct Polyhedron_GetFaceLink
  */
 template <typename T, typename FP, typename VP>
 class Polyhedron_Face
+  : public kdl::pool_allocated<Polyhedron_Face<T, FP, VP>>
 {
 private:
   friend class Polyhedron<T, FP, VP>;
@@ -1128,6 +1133,13 @@ template <typename T, typename FP, typename VP>
 using Polyhedron_FaceList = kdl::
   intrusive_circular_list<Polyhedron_Face<T, FP, VP>, Polyhedron_GetFaceLink<T, FP, VP>>;
 
+/**
+ * A convex polyhedron made up of vertices, edges, half edges and faces.
+ *
+ * The topology elements are allocated from thread local pools (see kdl::pool_allocated)
+ * because polyhedra are created, copied and destroyed in large numbers, and every one of
+ * them consists of dozens of small objects.
+ */
 template <typename T, typename FP, typename VP>
 class Polyhedron
 {
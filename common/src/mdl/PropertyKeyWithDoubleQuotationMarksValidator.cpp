@@ -40,6 +40,7 @@ PropertyKeyWithDoubleQuotationMarksValidator::
   PropertyKeyWithDoubleQuotationMarksValidator()
   : Validator{Type, "Invalid entity property keys"}
 {
+  markThreadSafe();
   addQuickFix(makeRemoveEntityPropertiesQuickFix(Type));
   addQuickFix(makeTransformEntityPropertiesQuickFix(
     Type,
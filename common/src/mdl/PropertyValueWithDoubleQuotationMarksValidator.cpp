@@ -40,6 +40,7 @@ PropertyValueWithDoubleQuotationMarksValidator::
   PropertyValueWithDoubleQuotationMarksValidator()
   : Validator{Type, "Invalid entity property values"}
 {
+  markThreadSafe();
   addQuickFix(makeRemoveEntityPropertiesQuickFix(Type));
   addQuickFix(makeTransformEntityPropertiesQuickFix(
     Type,
@@ -76,7 +76,17 @@ public:
   Result<T>&& get() { return std::move(m_result); }
 };
 
+/**
+ * A task returns nullptr if it was cancelled before it started.
+ */
 using Task = std::function<std::unique_ptr<TaskResult>()>;
+
+/**
+ * Runs the given task and returns a future for its result. A task runner can decline a
+ * task by returning an invalid future, e.g. if its queue is full. In that case, the
+ * resource remains unloaded and loading will be triggered again when it is processed
+ * the next time.
+ */
 using TaskRunner = std::function<std::future<std::unique_ptr<TaskResult>>(Task)>;
 
 template <typename T>
@@ -92,6 +102,10 @@ struct ResourceLoading
 {
   std::future<std::unique_ptr<TaskResult>> future;
 
+  // The loading task only holds a weak reference to this token. If the resource is
+  // dropped before the task has started, the token expires and the task is skipped.
+  std::shared_ptr<bool> cancellationToken;
+
   kdl_reflect_inline_empty(ResourceLoading);
 };
 
@@ -154,10 +168,24 @@ namespace detail
 template <typename T>
 ResourceState<T> triggerLoading(ResourceUnloaded<T> state, TaskRunner taskRunner)
 {
-  auto future = taskRunner([loader = std::move(state.loader)]() {
-    return std::make_unique<LoaderTaskResult<T>>(loader());
-  });
-  return ResourceLoading<T>{std::move(future)};
+  auto cancellationToken = std::make_shared<bool>(true);
+  auto future = taskRunner(
+    [loader = state.loader,
+     weakToken = std::weak_ptr{cancellationToken}]() -> std::unique_ptr<TaskResult> {
+      if (weakToken.expired())
+      {
+        return nullptr;
+      }
+      return std::make_unique<LoaderTaskResult<T>>(loader());
+    });
+
+  if (!future.valid())
+  {
+    // the task runner declined the task, try again later
+    return state;
+  }
+
+  return ResourceLoading<T>{std::move(future), std::move(cancellationToken)};
 }
 
 template <typename T>
@@ -235,6 +263,7 @@ class Resource
 private:
   ResourceId m_id;
   ResourceState<T> m_state;
+  mutable bool m_requested = false;
 
   kdl_reflect_inline(Resource, m_state);
 
@@ -255,8 +284,15 @@ public:
 
   const ResourceState<T>& state() const { return m_state; }
 
+  /**
+   * Indicates whether anyone tried to access this resource before it was loaded. Such
+   * resources are in use, e.g. because they are visible, and should be loaded first.
+   */
+  bool isRequested() const { return m_requested; }
+
   const T* get() const
   {
+    m_requested = true;
     return std::visit(
       kdl::overload(
         [](const ResourceLoaded<T>& state) -> const T* { return &state.resource; },
@@ -267,6 +303,7 @@ public:
 
   T* get()
   {
+    m_requested = true;
     return std::visit(
       kdl::overload(
         [](ResourceLoaded<T>& state) -> T* { return &state.resource; },
@@ -277,6 +314,11 @@ public:
 
   bool isDropped() const { return std::holds_alternative<ResourceDropped>(m_state); }
 
+  bool needsLoading() const
+  {
+    return std::holds_alternative<ResourceUnloaded<T>>(m_state);
+  }
+
   bool needsProcessing() const
   {
     return !std::holds_alternative<ResourceReady<T>>(m_state)
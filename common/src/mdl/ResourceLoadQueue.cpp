@@ -0,0 +1,188 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ResourceLoadQueue.h"
+
+#include "kdl/reflection_impl.h"
+
+#include <algorithm>
+#include <exception>
+#include <optional>
+
+namespace tb::mdl
+{
+
+kdl_reflect_impl(ResourceLoadQueueStats);
+
+size_t ResourceLoadQueue::defaultThreadCount()
+{
+  // loading is mostly bound by IO and decoding, more threads don't help much
+  return std::clamp(size_t(std::thread::hardware_concurrency()), size_t(1), size_t(8));
+}
+
+ResourceLoadQueue::ResourceLoadQueue(
+  const size_t threadCount, const size_t maxQueuedTasks)
+  : m_maxQueuedTasks{std::max(maxQueuedTasks, size_t(1))}
+{
+  const auto actualThreadCount = std::max(threadCount, size_t(1));
+  m_threads.reserve(actualThreadCount);
+  for (size_t i = 0; i < actualThreadCount; ++i)
+  {
+    m_threads.emplace_back([&]() { runWorker(); });
+  }
+}
+
+ResourceLoadQueue::~ResourceLoadQueue()
+{
+  {
+    const auto lock = std::lock_guard{m_mutex};
+    m_stopped = true;
+    m_queue.clear();
+  }
+  m_condition.notify_all();
+
+  for (auto& thread : m_threads)
+  {
+    thread.join();
+  }
+}
+
+std::future<std::unique_ptr<TaskResult>> ResourceLoadQueue::run(Task task)
+{
+  auto future = std::future<std::unique_ptr<TaskResult>>{};
+
+  {
+    const auto lock = std::lock_guard{m_mutex};
+    if (m_stopped || m_queue.size() >= m_maxQueuedTasks)
+    {
+      ++m_declinedTasks;
+      return future;
+    }
+
+    auto& queuedTask = m_queue.emplace_back(QueuedTask{
+      std::move(task),
+      std::promise<std::unique_ptr<TaskResult>>{},
+      std::chrono::steady_clock::now()});
+    future = queuedTask.promise.get_future();
+  }
+
+  m_condition.notify_one();
+  return future;
+}
+
+TaskRunner ResourceLoadQueue::taskRunner()
+{
+  return [&](auto task) { return run(std::move(task)); };
+}
+
+void ResourceLoadQueue::waitForTasks()
+{
+  auto lock = std::unique_lock{m_mutex};
+  m_idleCondition.wait(lock, [&]() { return m_queue.empty() && m_runningTasks == 0; });
+}
+
+ResourceLoadQueueStats ResourceLoadQueue::stats() const
+{
+  using namespace std::chrono;
+
+  const auto lock = std::lock_guard{m_mutex};
+  const auto averageLatency = m_completedTasks > 0
+                                ? m_totalLatency / static_cast<steady_clock::rep>(m_completedTasks)
+                                : steady_clock::duration{0};
+
+  return {
+    m_queue.size(),
+    m_runningTasks,
+    m_completedTasks,
+    m_cancelledTasks,
+    m_declinedTasks,
+    duration_cast<milliseconds>(averageLatency),
+    duration_cast<milliseconds>(m_maxLatency),
+  };
+}
+
+void ResourceLoadQueue::runWorker()
+{
+  while (true)
+  {
+    auto queuedTask = [&]() -> std::optional<QueuedTask> {
+      auto lock = std::unique_lock{m_mutex};
+      m_condition.wait(lock, [&]() { return m_stopped || !m_queue.empty(); });
+      if (m_stopped)
+      {
+        return std::nullopt;
+      }
+
+      auto result = std::move(m_queue.front());
+      m_queue.pop_front();
+      ++m_runningTasks;
+      return result;
+    }();
+
+    if (!queuedTask)
+    {
+      return;
+    }
+
+    auto taskResult = std::unique_ptr<TaskResult>{};
+    auto exception = std::exception_ptr{};
+    try
+    {
+      taskResult = queuedTask->task();
+    }
+    catch (...)
+    {
+      exception = std::current_exception();
+    }
+
+    const auto latency = std::chrono::steady_clock::now() - queuedTask->queueTime;
+    const auto cancelled = !taskResult && !exception;
+
+    {
+      const auto lock = std::lock_guard{m_mutex};
+      --m_runningTasks;
+      if (cancelled)
+      {
+        ++m_cancelledTasks;
+      }
+      else
+      {
+        ++m_completedTasks;
+        m_totalLatency += latency;
+        m_maxLatency = std::max(m_maxLatency, latency);
+      }
+
+      if (m_queue.empty() && m_runningTasks == 0)
+      {
+        m_idleCondition.notify_all();
+      }
+    }
+
+    if (exception)
+    {
+      queuedTask->promise.set_exception(std::move(exception));
+    }
+    else if (!cancelled)
+    {
+      queuedTask->promise.set_value(std::move(taskResult));
+    }
+  }
+}
+
+} // namespace tb::mdl
@@ -0,0 +1,143 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Macros.h"
+#include "mdl/Resource.h"
+
+#include "kdl/reflection_decl.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tb::mdl
+{
+
+struct ResourceLoadQueueStats
+{
+  /** The number of tasks that are waiting to be run. */
+  size_t queuedTasks = 0;
+  /** The number of tasks that are currently being run. */
+  size_t runningTasks = 0;
+  /** The number of tasks that have finished loading their resource. */
+  size_t completedTasks = 0;
+  /** The number of tasks that were skipped because their resource was dropped. */
+  size_t cancelledTasks = 0;
+  /** The number of tasks that were declined because the queue was full. */
+  size_t declinedTasks = 0;
+
+  /** The average time from queueing a task until its resource was loaded. */
+  std::chrono::milliseconds averageLatency = std::chrono::milliseconds{0};
+  /** The maximum time from queueing a task until its resource was loaded. */
+  std::chrono::milliseconds maxLatency = std::chrono::milliseconds{0};
+
+  kdl_reflect_decl(
+    ResourceLoadQueueStats,
+    queuedTasks,
+    runningTasks,
+    completedTasks,
+    cancelledTasks,
+    declinedTasks,
+    averageLatency,
+    maxLatency);
+};
+
+/**
+ * Runs resource loading tasks on a fixed number of worker threads.
+ *
+ * The number of queued tasks is bounded. If the queue is full, new tasks are declined by
+ * returning an invalid future, and the affected resources are retried when the resource
+ * manager processes them the next time. Since the resource manager triggers loading for
+ * requested resources first, these resources are also loaded first.
+ */
+class ResourceLoadQueue
+{
+private:
+  struct QueuedTask
+  {
+    Task task;
+    std::promise<std::unique_ptr<TaskResult>> promise;
+    std::chrono::steady_clock::time_point queueTime;
+  };
+
+  size_t m_maxQueuedTasks;
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::condition_variable m_idleCondition;
+  std::deque<QueuedTask> m_queue;
+  bool m_stopped = false;
+
+  size_t m_runningTasks = 0;
+  size_t m_completedTasks = 0;
+  size_t m_cancelledTasks = 0;
+  size_t m_declinedTasks = 0;
+  std::chrono::steady_clock::duration m_totalLatency = {};
+  std::chrono::steady_clock::duration m_maxLatency = {};
+
+  std::vector<std::thread> m_threads;
+
+public:
+  static size_t defaultThreadCount();
+  static constexpr size_t DefaultMaxQueuedTasks = 256;
+
+  explicit ResourceLoadQueue(
+    size_t threadCount = defaultThreadCount(),
+    size_t maxQueuedTasks = DefaultMaxQueuedTasks);
+
+  /**
+   * Discards all queued tasks and waits for the running tasks to finish.
+   */
+  ~ResourceLoadQueue();
+
+  deleteCopyAndMove(ResourceLoadQueue);
+
+  /**
+   * Queues the given task. Returns an invalid future if the queue is full.
+   */
+  std::future<std::unique_ptr<TaskResult>> run(Task task);
+
+  /**
+   * Returns a task runner that queues tasks in this queue.
+   */
+  TaskRunner taskRunner();
+
+  /**
+   * Waits until all queued and running tasks have finished.
+   *
+   * Loading tasks reference objects they don't own, e.g. the game's file system. Call
+   * this before such an object is destroyed or replaced. Tasks of dropped resources are
+   * skipped, so drop the affected resources first to keep the wait short.
+   */
+  void waitForTasks();
+
+  ResourceLoadQueueStats stats() const;
+
+private:
+  void runWorker();
+};
+
+} // namespace tb::mdl
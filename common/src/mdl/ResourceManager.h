@@ -25,6 +25,7 @@
 #include "kdl/reflection_impl.h"
 #include "kdl/vector_utils.h"
 
+#include <algorithm>
 #include <chrono>
 #include <memory>
 #include <vector>
@@ -42,6 +43,8 @@ public:
   virtual long useCount() const = 0;
 
   virtual bool isDropped() const = 0;
+  virtual bool isRequested() const = 0;
+  virtual bool needsLoading() const = 0;
   virtual bool needsProcessing() const = 0;
 
   virtual void drop() = 0;
@@ -65,6 +68,8 @@ public:
   const ResourceId& id() const override { return m_resource->id(); }
   long useCount() const override { return m_resource.use_count(); }
   bool isDropped() const override { return m_resource->isDropped(); }
+  bool isRequested() const override { return m_resource->isRequested(); }
+  bool needsLoading() const override { return m_resource->needsLoading(); }
   bool needsProcessing() const override { return m_resource->needsProcessing(); }
   void drop() override { m_resource->drop(); }
   bool process(TaskRunner taskRunner, const ProcessContext& processContext) override
@@ -120,6 +125,14 @@ public:
       }}
               : std::function{[]() { return true; }};
 
+    // Resources that were requested before they were loaded are in use and should be
+    // loaded first. The task runner may decline tasks once its queue is full, so the
+    // order in which loading is triggered determines the loading order.
+    std::stable_partition(
+      m_resources.begin(), m_resources.end(), [](const auto& resourceWrapper) {
+        return resourceWrapper->isRequested() && resourceWrapper->needsLoading();
+      });
+
     auto result = std::vector<ResourceId>{};
 
     for (auto it = m_resources.begin(); it != m_resources.end() && checkTimeout();)
@@ -0,0 +1,210 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TriangleBvh.h"
+
+#include "vm/intersection.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <limits>
+
+namespace tb::mdl
+{
+namespace
+{
+
+constexpr size_t MaxLeafSize = 4;
+
+/**
+ * Returns the distance at which the given ray enters the given box or nullopt if the ray
+ * misses it. The inverse direction is precomputed by the caller. Comparisons with NaN,
+ * which occur if the ray runs within one of the slab planes, are ignored.
+ */
+std::optional<float> intersectBounds(
+  const vm::bbox3f& bounds, const vm::vec3f& origin, const vm::vec3f& inverseDirection)
+{
+  auto tMin = 0.0f;
+  auto tMax = std::numeric_limits<float>::max();
+  for (size_t i = 0; i < 3; ++i)
+  {
+    const auto t1 = (bounds.min[i] - origin[i]) * inverseDirection[i];
+    const auto t2 = (bounds.max[i] - origin[i]) * inverseDirection[i];
+    const auto tNear = std::min(t1, t2);
+    const auto tFar = std::max(t1, t2);
+    if (tNear > tMin)
+    {
+      tMin = tNear;
+    }
+    if (tFar < tMax)
+    {
+      tMax = tFar;
+    }
+  }
+
+  return tMin <= tMax ? std::optional{tMin} : std::nullopt;
+}
+
+} // namespace
+
+struct TriangleBvh::BuildTriangle
+{
+  vm::bbox3f bounds;
+  vm::vec3f center;
+  size_t index;
+};
+
+TriangleBvh::TriangleBvh(std::vector<vm::vec3f> vertices)
+{
+  assert(vertices.size() % 3 == 0);
+
+  const auto triangleCount = vertices.size() / 3;
+  if (triangleCount == 0)
+  {
+    return;
+  }
+
+  auto triangles = std::vector<BuildTriangle>{};
+  triangles.reserve(triangleCount);
+  for (size_t i = 0; i < triangleCount; ++i)
+  {
+    const auto bounds = vm::bbox3f::merge_all(
+      vertices.begin() + std::ptrdiff_t(3 * i),
+      vertices.begin() + std::ptrdiff_t(3 * i + 3));
+    triangles.push_back(BuildTriangle{bounds, bounds.center(), i});
+  }
+
+  // a binary tree with at most MaxLeafSize triangles per leaf has fewer than
+  // 2 * triangleCount nodes
+  m_nodes.reserve(2 * triangleCount);
+  build(triangles, 0, triangleCount);
+  m_nodes.shrink_to_fit();
+
+  m_vertices.reserve(vertices.size());
+  for (const auto& triangle : triangles)
+  {
+    m_vertices.push_back(vertices[3 * triangle.index + 0]);
+    m_vertices.push_back(vertices[3 * triangle.index + 1]);
+    m_vertices.push_back(vertices[3 * triangle.index + 2]);
+  }
+}
+
+size_t TriangleBvh::triangleCount() const
+{
+  return m_vertices.size() / 3;
+}
+
+size_t TriangleBvh::memoryUsage() const
+{
+  return m_nodes.capacity() * sizeof(Node) + m_vertices.capacity() * sizeof(vm::vec3f);
+}
+
+std::optional<float> TriangleBvh::intersect(const vm::ray3f& ray) const
+{
+  if (m_nodes.empty())
+  {
+    return std::nullopt;
+  }
+
+  const auto inverseDirection = vm::vec3f{
+    1.0f / ray.direction.x(), 1.0f / ray.direction.y(), 1.0f / ray.direction.z()};
+
+  auto closestDistance = std::optional<float>{};
+
+  // the tree is balanced, so its depth is logarithmic in the number of triangles
+  auto stack = std::array<uint32_t, 64>{};
+  auto stackSize = size_t(0);
+  stack[stackSize++] = 0;
+
+  while (stackSize > 0)
+  {
+    const auto nodeIndex = stack[--stackSize];
+    const auto& node = m_nodes[nodeIndex];
+
+    const auto distance = intersectBounds(node.bounds, ray.origin, inverseDirection);
+    if (!distance || (closestDistance && *distance > *closestDistance))
+    {
+      continue;
+    }
+
+    if (node.count > 0)
+    {
+      for (size_t i = node.offset; i < node.offset + node.count; ++i)
+      {
+        closestDistance = vm::safe_min(
+          closestDistance,
+          vm::intersect_ray_triangle(
+            ray, m_vertices[3 * i + 0], m_vertices[3 * i + 1], m_vertices[3 * i + 2]));
+      }
+    }
+    else
+    {
+      assert(stackSize + 2 <= stack.size());
+      stack[stackSize++] = node.offset;
+      stack[stackSize++] = nodeIndex + 1;
+    }
+  }
+
+  return closestDistance;
+}
+
+void TriangleBvh::build(
+  std::vector<BuildTriangle>& triangles, const size_t begin, const size_t end)
+{
+  const auto nodeIndex = m_nodes.size();
+
+  auto bounds = triangles[begin].bounds;
+  auto centerBounds = vm::bbox3f{triangles[begin].center, triangles[begin].center};
+  for (size_t i = begin + 1; i < end; ++i)
+  {
+    bounds = vm::merge(bounds, triangles[i].bounds);
+    centerBounds = vm::merge(centerBounds, triangles[i].center);
+  }
+
+  m_nodes.push_back(Node{bounds});
+
+  if (end - begin <= MaxLeafSize)
+  {
+    m_nodes[nodeIndex].offset = uint32_t(begin);
+    m_nodes[nodeIndex].count = uint32_t(end - begin);
+    return;
+  }
+
+  const auto size = centerBounds.size();
+  const auto axis = size.x() >= size.y() && size.x() >= size.z() ? size_t(0)
+                    : size.y() >= size.z()                       ? size_t(1)
+                                                                 : size_t(2);
+
+  // splitting at the median keeps the tree balanced even if the centers coincide
+  const auto mid = begin + (end - begin) / 2;
+  std::nth_element(
+    triangles.begin() + std::ptrdiff_t(begin),
+    triangles.begin() + std::ptrdiff_t(mid),
+    triangles.begin() + std::ptrdiff_t(end),
+    [&](const auto& lhs, const auto& rhs) {
+      return lhs.center[axis] < rhs.center[axis];
+    });
+
+  build(triangles, begin, mid);
+  m_nodes[nodeIndex].offset = uint32_t(m_nodes.size());
+  build(triangles, mid, end);
+}
+
+} // namespace tb::mdl
@@ -0,0 +1,83 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "vm/bbox.h"
+#include "vm/ray.h"
+#include "vm/vec.h"
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace tb::mdl
+{
+
+/**
+ * A bounding volume hierarchy for ray intersection tests against a static set of
+ * triangles.
+ *
+ * The nodes are stored in a flat array in depth first order, so that the left child of
+ * an inner node immediately follows it. The triangles are reordered so that the
+ * triangles of every leaf are stored consecutively. The tree is built by splitting the
+ * triangles at the median of their centers along the longest axis of the node.
+ */
+class TriangleBvh
+{
+private:
+  struct Node
+  {
+    vm::bbox3f bounds;
+    // the index of the first triangle of a leaf, or the index of the right child
+    uint32_t offset = 0;
+    // the number of triangles of a leaf, or 0 for inner nodes
+    uint32_t count = 0;
+  };
+
+  std::vector<Node> m_nodes;
+  // three vertices per triangle
+  std::vector<vm::vec3f> m_vertices;
+
+public:
+  /**
+   * Builds a tree for the given triangles. The number of given vertices must be a
+   * multiple of 3.
+   */
+  explicit TriangleBvh(std::vector<vm::vec3f> vertices);
+
+  size_t triangleCount() const;
+
+  /**
+   * Returns the number of bytes occupied by the nodes and the triangles.
+   */
+  size_t memoryUsage() const;
+
+  /**
+   * Returns the distance to the closest triangle hit by the given ray, or nullopt if the
+   * ray does not hit any triangle.
+   */
+  std::optional<float> intersect(const vm::ray3f& ray) const;
+
+private:
+  struct BuildTriangle;
+  void build(std::vector<BuildTriangle>& triangles, size_t begin, size_t end);
+};
+
+} // namespace tb::mdl
@@ -51,6 +51,11 @@ std::vector<const IssueQuickFix*> Validator::quickFixes() const
   });
 }
 
+bool Validator::threadSafe() const
+{
+  return m_threadSafe;
+}
+
 void Validator::validate(Node& node, std::vector<std::unique_ptr<Issue>>& issues) const
 {
   node.accept(kdl::overload(
@@ -73,6 +78,11 @@ void Validator::addQuickFix(IssueQuickFix quickFix)
   m_quickFixes.push_back(std::move(quickFix));
 }
 
+void Validator::markThreadSafe()
+{
+  m_threadSafe = true;
+}
+
 void Validator::doValidate(
   WorldNode& worldNode, std::vector<std::unique_ptr<Issue>>& issues) const
 {
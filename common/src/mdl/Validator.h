@@ -44,6 +44,7 @@ private:
   IssueType m_type;
   std::string m_description;
   std::vector<IssueQuickFix> m_quickFixes;
+  bool m_threadSafe = false;
 
 public:
   virtual ~Validator();
@@ -52,11 +53,19 @@ public:
   const std::string& description() const;
   std::vector<const IssueQuickFix*> quickFixes() const;
 
+  /**
+   * Indicates whether this validator can validate different nodes concurrently. This is
+   * the case if it only reads the state of the node passed to it and the state of other
+   * nodes that is not computed lazily.
+   */
+  bool threadSafe() const;
+
   void validate(Node& node, std::vector<std::unique_ptr<Issue>>& issues) const;
 
 protected:
   Validator(IssueType type, std::string description);
   void addQuickFix(IssueQuickFix quickFix);
+  void markThreadSafe();
 
 private:
   virtual void doValidate(
@@ -20,6 +20,7 @@
 #include "WorldNode.h"
 
 #include "Ensure.h"
+#include "io/NodeSerializationCache.h"
 #include "mdl/BrushFace.h"
 #include "mdl/BrushNode.h"
 #include "mdl/EntityNode.h"
@@ -27,6 +28,7 @@
 #include "mdl/GroupNode.h"
 #include "mdl/LayerNode.h"
 #include "mdl/PatchNode.h"
+#include "mdl/PickResult.h"
 #include "mdl/TagVisitor.h"
 #include "mdl/Validator.h"
 #include "mdl/ValidatorRegistry.h"
@@ -36,7 +38,10 @@
 #include "kdl/vector_utils.h"
 
 #include "vm/bbox_io.h" // IWYU pragma: keep
+#include "vm/intersection.h"
 
+#include <limits>
+#include <optional>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -53,6 +58,7 @@ WorldNode::WorldNode(
   , m_validatorRegistry{std::make_unique<ValidatorRegistry>()}
   , m_nodeTree{std::make_unique<NodeTree>(256.0)}
   , m_updateNodeTree{true}
+  , m_serializationCache{std::make_unique<io::NodeSerializationCache>()}
 {
   entity.addOrUpdateProperty(
     EntityPropertyKeys::Classname, EntityPropertyValues::WorldspawnClassname);
@@ -86,6 +92,11 @@ const WorldNode::NodeTree& WorldNode::nodeTree() const
   return *m_nodeTree;
 }
 
+io::NodeSerializationCache& WorldNode::serializationCache() const
+{
+  return *m_serializationCache;
+}
+
 LayerNode* WorldNode::defaultLayer()
 {
   ensure(m_defaultLayer != nullptr, "defaultLayer is null");
@@ -250,6 +261,34 @@ void WorldNode::rebuildNodeTree()
   }
 }
 
+void WorldNode::pickClosest(
+  const EditorContext& editorContext,
+  const vm::ray3d& ray,
+  const HitFilter& hitFilter,
+  PickResult& pickResult)
+{
+  auto closestDistance = std::numeric_limits<double>::max();
+  m_nodeTree->visit_intersectors_front_to_back(
+    ray, [&](Node* node) -> std::optional<double> {
+      const auto& bounds = node->physicalBounds();
+      const auto distance = bounds.contains(ray.origin)
+                              ? std::optional{0.0}
+                              : vm::intersect_ray_bbox(ray, bounds);
+      if (!distance || *distance > closestDistance)
+      {
+        return std::nullopt;
+      }
+
+      node->pick(editorContext, ray, pickResult);
+      if (const auto& hit = pickResult.first(hitFilter); hit.isMatch())
+      {
+        closestDistance = hit.distance();
+        return closestDistance;
+      }
+      return std::nullopt;
+    });
+}
+
 void WorldNode::invalidateAllIssues()
 {
   accept([](auto&& thisLambda, Node* node) {
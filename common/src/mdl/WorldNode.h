@@ -22,6 +22,7 @@
 #include "Macros.h"
 #include "mdl/EntityNodeBase.h"
 #include "mdl/EntityProperties.h"
+#include "mdl/HitFilter.h"
 #include "mdl/IdType.h"
 #include "mdl/MapFormat.h"
 #include "mdl/Node.h"
@@ -31,6 +32,11 @@
 #include <string>
 #include <vector>
 
+namespace tb::io
+{
+class NodeSerializationCache;
+} // namespace tb::io
+
 namespace tb::mdl
 {
 class EntityNodeIndex;
@@ -53,6 +59,8 @@ private:
   std::unique_ptr<NodeTree> m_nodeTree;
   bool m_updateNodeTree;
 
+  std::unique_ptr<io::NodeSerializationCache> m_serializationCache;
+
   IdType m_nextPersistentId = 1;
 
 public:
@@ -71,6 +79,13 @@ public:
 
   const NodeTree& nodeTree() const;
 
+  /**
+   * Returns the cache for the serialized text of the brushes and patches of this world.
+   * The cache is not part of the state of this world, so it can be modified through a
+   * const reference.
+   */
+  io::NodeSerializationCache& serializationCache() const;
+
 public: // layer management
   LayerNode* defaultLayer();
 
@@ -135,6 +150,22 @@ public: // node tree bulk updating
   void enableNodeTreeUpdates();
   void rebuildNodeTree();
 
+public: // picking
+  /**
+   * Like pick, but only picks as many nodes as are needed to find the closest hit that
+   * matches the given filter. The nodes are visited in front to back order using the node
+   * tree, and nodes that are farther away than the closest matching hit are skipped.
+   *
+   * Afterwards, the given pick result contains the closest matching hit and any other
+   * hits that are closer to the ray origin, but it may lack hits farther away. Use this
+   * when only the first matching hit is of interest.
+   */
+  void pickClosest(
+    const EditorContext& editorContext,
+    const vm::ray3d& ray,
+    const HitFilter& hitFilter,
+    PickResult& pickResult);
+
 private:
   void invalidateAllIssues();
 
@@ -35,7 +35,9 @@
 #include <cassert>
 #include <cmath>
 #include <cstdint>
+#include <limits>
 #include <optional>
+#include <queue>
 #include <unordered_map>
 #include <variant>
 #include <vector>
@@ -551,6 +553,79 @@ public:
     }
   }
 
+  /**
+   * Visits the data items in this tree whose nodes are hit by the given ray in front to
+   * back order, that is, in the order of the distances at which the ray enters the nodes.
+   *
+   * The visitor is called with every data item and returns the distance of the hit that
+   * it found for that item, if any. Once a hit has been found, the traversal stops before
+   * visiting a node that the ray enters farther away than the closest hit. This requires
+   * that every hit of a data item lies within the item's bounding box.
+   *
+   * @tparam V the visitor type
+   * @param ray the ray to test
+   * @param visitor the visitor to call with every data item, must return std::optional<T>
+   */
+  template <typename V>
+  void visit_intersectors_front_to_back(const vm::ray<T, 3>& ray, const V& visitor) const
+  {
+    struct queue_entry
+    {
+      T distance;
+      const node* tree_node;
+    };
+
+    const auto compare = [](const queue_entry& lhs, const queue_entry& rhs) {
+      return lhs.distance > rhs.distance;
+    };
+    auto queue =
+      std::priority_queue<queue_entry, std::vector<queue_entry>, decltype(compare)>{
+        compare};
+
+    const auto push = [&](const node& n) {
+      if (is_inner_node(n) || !get_data(n).empty())
+      {
+        const auto bounds = get_address(n).to_bounds(m_min_size);
+        if (bounds.contains(ray.origin))
+        {
+          queue.push({T(0), &n});
+        }
+        else if (const auto distance = vm::intersect_ray_bbox(ray, bounds))
+        {
+          queue.push({*distance, &n});
+        }
+      }
+    };
+
+    if (m_root)
+    {
+      push(*m_root);
+    }
+
+    auto closest_distance = std::numeric_limits<T>::max();
+    while (!queue.empty() && queue.top().distance <= closest_distance)
+    {
+      const auto& n = *queue.top().tree_node;
+      queue.pop();
+
+      for (const auto& data : get_data(n))
+      {
+        if (const auto distance = visitor(data))
+        {
+          closest_distance = std::min(closest_distance, *distance);
+        }
+      }
+
+      if (const auto* inner = std::get_if<inner_node>(&n))
+      {
+        for (const auto& child : inner->children)
+        {
+          push(child);
+        }
+      }
+    }
+  }
+
   /**
    * Finds every data item in this tree whose bounding box intersects with the given bbox
    * and returns a list of those items.
@@ -630,6 +705,53 @@ public:
     }
   }
 
+  /**
+   * Finds every data item in this tree that is stored in a node whose bounds satisfy the
+   * given predicate and returns a list of those items.
+   *
+   * @tparam P the predicate type
+   * @param predicate the predicate to apply to the node bounds
+   * @return a list containing all found data items
+   */
+  template <typename P>
+  std::vector<U> find_if(const P& predicate) const
+  {
+    auto result = std::vector<U>{};
+    find_if(predicate, std::back_inserter(result));
+    return result;
+  }
+
+  /**
+   * Finds every data item in this tree that is stored in a node whose bounds satisfy the
+   * given predicate and appends it to the given output iterator.
+   *
+   * The children of a node are only visited if the predicate holds for the node's bounds,
+   * so the predicate must return true for every box that might contain an item of
+   * interest. This allows for queries with regions that are not boxes or rays, and the
+   * caller has to test the returned items individually.
+   *
+   * @tparam P the predicate type
+   * @tparam O the output iterator type
+   * @param predicate the predicate to apply to the node bounds
+   * @param out the output iterator to append to
+   */
+  template <typename P, typename O>
+  void find_if(const P& predicate, O out) const
+  {
+    if (m_root)
+    {
+      visit_node_if(
+        *m_root,
+        [&](const auto& node) {
+          const auto& data = get_data(node);
+          std::copy(data.begin(), data.end(), out);
+        },
+        [&](const auto& node) {
+          return predicate(get_address(node).to_bounds(m_min_size));
+        });
+    }
+  }
+
   kdl_reflect_inline(octree, m_root, m_min_size, m_node_address_for_data);
 
 private:
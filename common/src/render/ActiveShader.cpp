@@ -36,4 +36,9 @@ ActiveShader::~ActiveShader()
   m_program.deactivate(m_shaderManager);
 }
 
+void ActiveShader::applyFrameUniforms(const FrameUniforms& frameUniforms)
+{
+  m_program.applyFrameUniforms(frameUniforms);
+}
+
 } // namespace tb::render
@@ -22,9 +22,11 @@
 #include "render/ShaderProgram.h"
 
 #include <string>
+#include <type_traits>
 
 namespace tb::render
 {
+struct FrameUniforms;
 struct ShaderConfig;
 class ShaderManager;
 
@@ -43,6 +45,14 @@ public:
   {
     m_program.set(name, value);
   }
+
+  template <class T>
+  void set(const Uniform<T>& uniform, const std::type_identity_t<T>& value)
+  {
+    m_program.set(uniform, value);
+  }
+
+  void applyFrameUniforms(const FrameUniforms& frameUniforms);
 };
 
 } // namespace tb::render
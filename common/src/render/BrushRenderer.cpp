@@ -29,8 +29,10 @@
 #include "mdl/TagAttribute.h"
 #include "render/BrushRendererArrays.h"
 #include "render/BrushRendererBrushCache.h"
+#include "render/Camera.h"
 #include "render/RenderContext.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <vector>
@@ -165,6 +167,16 @@ BrushRenderer::Filter::RenderSettings BrushRenderer::NoFilter::markFaces(
   return {FaceRenderPolicy::RenderMarked, EdgeRenderPolicy::RenderAll};
 }
 
+// Chunk
+
+BrushRenderer::Chunk::Chunk()
+  : vertexArray{std::make_shared<BrushVertexArray>()}
+  , edgeIndices{std::make_shared<BrushIndexArray>()}
+  , transparentFaces{std::make_shared<MaterialToBrushIndicesMap>()}
+  , opaqueFaces{std::make_shared<MaterialToBrushIndicesMap>()}
+{
+}
+
 // BrushRenderer
 
 BrushRenderer::BrushRenderer()
@@ -184,8 +196,9 @@ void BrushRenderer::invalidate()
   m_invalidBrushes = m_allBrushes;
 
   assert(m_brushInfo.empty());
-  assert(m_transparentFaces->empty());
-  assert(m_opaqueFaces->empty());
+  assert(std::all_of(m_chunks.begin(), m_chunks.end(), [](const auto& entry) {
+    return entry.second->transparentFaces->empty() && entry.second->opaqueFaces->empty();
+  }));
 }
 
 void BrushRenderer::invalidateMaterials(
@@ -232,16 +245,26 @@ void BrushRenderer::clear()
   m_brushInfo.clear();
   m_allBrushes.clear();
   m_invalidBrushes.clear();
+  m_chunks.clear();
+}
 
-  m_vertexArray = std::make_shared<BrushVertexArray>();
-  m_edgeIndices = std::make_shared<BrushIndexArray>();
-  m_transparentFaces = std::make_shared<MaterialToBrushIndicesMap>();
-  m_opaqueFaces = std::make_shared<MaterialToBrushIndicesMap>();
+void BrushRenderer::setChunkSize(const double chunkSize)
+{
+  assert(chunkSize >= 0.0);
+  if (chunkSize != m_chunkSize)
+  {
+    // chunks are only created when brushes are validated, so all brushes must go
+    invalidate();
+    m_chunks.clear();
+    m_chunkSize = chunkSize;
+  }
+}
 
-  m_opaqueFaceRenderer = FaceRenderer{m_vertexArray, m_opaqueFaces, m_faceColor};
-  m_transparentFaceRenderer =
-    FaceRenderer{m_vertexArray, m_transparentFaces, m_faceColor};
-  m_edgeRenderer = IndexedEdgeRenderer{m_vertexArray, m_edgeIndices};
+size_t BrushRenderer::chunkCount() const
+{
+  return size_t(std::count_if(m_chunks.begin(), m_chunks.end(), [](const auto& entry) {
+    return entry.second->brushCount > 0;
+  }));
 }
 
 void BrushRenderer::setFaceColor(const Color& faceColor)
@@ -325,13 +348,21 @@ void BrushRenderer::renderOpaque(RenderContext& renderContext, RenderBatch& rend
     {
       validate();
     }
-    if (renderContext.showFaces())
-    {
-      renderOpaqueFaces(renderBatch);
-    }
-    if (renderContext.showEdges() || m_showEdges)
+
+    for (auto& [key, chunk] : m_chunks)
     {
-      renderEdges(renderBatch);
+      // the brushes are only counted in this pass
+      if (renderContext.intersectsFrustum(chunk->bounds, chunk->brushCount))
+      {
+        if (renderContext.showFaces())
+        {
+          renderOpaqueFaces(*chunk, renderBatch);
+        }
+        if (renderContext.showEdges() || m_showEdges)
+        {
+          renderEdges(*chunk, renderBatch);
+        }
+      }
     }
   }
 }
@@ -347,35 +378,41 @@ void BrushRenderer::renderTransparent(
     }
     if (renderContext.showFaces())
     {
-      renderTransparentFaces(renderBatch);
+      for (auto& [key, chunk] : m_chunks)
+      {
+        if (renderContext.camera().intersectsFrustum(chunk->bounds))
+        {
+          renderTransparentFaces(*chunk, renderBatch);
+        }
+      }
     }
   }
 }
 
-void BrushRenderer::renderOpaqueFaces(RenderBatch& renderBatch)
+void BrushRenderer::renderOpaqueFaces(Chunk& chunk, RenderBatch& renderBatch)
 {
-  m_opaqueFaceRenderer.setGrayscale(m_grayscale);
-  m_opaqueFaceRenderer.setTint(m_tint);
-  m_opaqueFaceRenderer.setTintColor(m_tintColor);
-  m_opaqueFaceRenderer.render(renderBatch);
+  chunk.opaqueFaceRenderer.setGrayscale(m_grayscale);
+  chunk.opaqueFaceRenderer.setTint(m_tint);
+  chunk.opaqueFaceRenderer.setTintColor(m_tintColor);
+  chunk.opaqueFaceRenderer.render(renderBatch);
 }
 
-void BrushRenderer::renderTransparentFaces(RenderBatch& renderBatch)
+void BrushRenderer::renderTransparentFaces(Chunk& chunk, RenderBatch& renderBatch)
 {
-  m_transparentFaceRenderer.setGrayscale(m_grayscale);
-  m_transparentFaceRenderer.setTint(m_tint);
-  m_transparentFaceRenderer.setTintColor(m_tintColor);
-  m_transparentFaceRenderer.setAlpha(m_transparencyAlpha);
-  m_transparentFaceRenderer.render(renderBatch);
+  chunk.transparentFaceRenderer.setGrayscale(m_grayscale);
+  chunk.transparentFaceRenderer.setTint(m_tint);
+  chunk.transparentFaceRenderer.setTintColor(m_tintColor);
+  chunk.transparentFaceRenderer.setAlpha(m_transparencyAlpha);
+  chunk.transparentFaceRenderer.render(renderBatch);
 }
 
-void BrushRenderer::renderEdges(RenderBatch& renderBatch)
+void BrushRenderer::renderEdges(Chunk& chunk, RenderBatch& renderBatch)
 {
   if (m_showOccludedEdges)
   {
-    m_edgeRenderer.renderOnTop(renderBatch, m_occludedEdgeColor);
+    chunk.edgeRenderer.renderOnTop(renderBatch, m_occludedEdgeColor);
   }
-  m_edgeRenderer.render(renderBatch, m_edgeColor);
+  chunk.edgeRenderer.render(renderBatch, m_edgeColor);
 }
 
 void BrushRenderer::validate()
@@ -389,10 +426,36 @@ void BrushRenderer::validate()
   m_invalidBrushes.clear();
   assert(valid());
 
-  m_opaqueFaceRenderer = FaceRenderer{m_vertexArray, m_opaqueFaces, m_faceColor};
-  m_transparentFaceRenderer =
-    FaceRenderer{m_vertexArray, m_transparentFaces, m_faceColor};
-  m_edgeRenderer = IndexedEdgeRenderer{m_vertexArray, m_edgeIndices};
+  for (auto it = m_chunks.begin(); it != m_chunks.end();)
+  {
+    auto& chunk = *it->second;
+    if (chunk.brushCount == 0)
+    {
+      it = m_chunks.erase(it);
+      continue;
+    }
+
+    chunk.opaqueFaceRenderer =
+      FaceRenderer{chunk.vertexArray, chunk.opaqueFaces, m_faceColor};
+    chunk.transparentFaceRenderer =
+      FaceRenderer{chunk.vertexArray, chunk.transparentFaces, m_faceColor};
+    chunk.edgeRenderer = IndexedEdgeRenderer{chunk.vertexArray, chunk.edgeIndices};
+    ++it;
+  }
+}
+
+BrushRenderer::Chunk& BrushRenderer::chunkFor(const mdl::BrushNode& brushNode)
+{
+  const auto key = m_chunkSize > 0.0
+                     ? vm::floor(brushNode.logicalBounds().center() / m_chunkSize)
+                     : vm::vec3d{0, 0, 0};
+
+  auto& chunk = m_chunks[key];
+  if (!chunk)
+  {
+    chunk = std::make_unique<Chunk>();
+  }
+  return *chunk;
 }
 
 static size_t triIndicesCountForPolygon(const size_t vertexCount)
@@ -540,7 +603,14 @@ void BrushRenderer::validateBrush(const mdl::BrushNode& brushNode)
     return;
   }
 
+  auto& chunk = chunkFor(brushNode);
+  const auto brushBounds = vm::bbox3f{brushNode.logicalBounds()};
+  chunk.bounds =
+    chunk.brushCount == 0 ? brushBounds : vm::merge(chunk.bounds, brushBounds);
+  ++chunk.brushCount;
+
   BrushInfo& info = m_brushInfo[&brushNode];
+  info.chunk = &chunk;
 
   // collect vertices
   auto& brushCache = brushNode.brushRendererBrushCache();
@@ -548,9 +618,9 @@ void BrushRenderer::validateBrush(const mdl::BrushNode& brushNode)
   const auto& cachedVertices = brushCache.cachedVertices();
   ensure(!cachedVertices.empty(), "Brush must have cached vertices");
 
-  assert(m_vertexArray != nullptr);
+  assert(chunk.vertexArray != nullptr);
   auto [vertBlock, dest] =
-    m_vertexArray->getPointerToInsertVerticesAt(cachedVertices.size());
+    chunk.vertexArray->getPointerToInsertVerticesAt(cachedVertices.size());
   std::memcpy(dest, cachedVertices.data(), cachedVertices.size() * sizeof(*dest));
   info.vertexHolderKey = vertBlock;
 
@@ -562,7 +632,7 @@ void BrushRenderer::validateBrush(const mdl::BrushNode& brushNode)
     if (edgeIndexCount > 0)
     {
       auto [key, insertDest] =
-        m_edgeIndices->getPointerToInsertElementsAt(edgeIndexCount);
+        chunk.edgeIndices->getPointerToInsertElementsAt(edgeIndexCount);
       info.edgeIndicesKey = key;
       getMarkedEdgeIndices(brushNode, edgePolicy, brushVerticesStartIndex, insertDest);
     }
@@ -615,7 +685,7 @@ void BrushRenderer::validateBrush(const mdl::BrushNode& brushNode)
 
     if (transparentIndexCount > 0)
     {
-      auto& faceVboMap = *m_transparentFaces;
+      auto& faceVboMap = *chunk.transparentFaces;
       auto& holderPtr = faceVboMap[material];
       if (holderPtr == nullptr)
       {
@@ -650,7 +720,7 @@ void BrushRenderer::validateBrush(const mdl::BrushNode& brushNode)
 
     if (opaqueIndexCount > 0)
     {
-      auto& faceVboMap = *m_opaqueFaces;
+      auto& faceVboMap = *chunk.opaqueFaces;
       auto& holderPtr = faceVboMap[material];
       if (holderPtr == nullptr)
       {
@@ -722,39 +792,42 @@ void BrushRenderer::removeBrushFromVbo(const mdl::BrushNode& brushNode)
   }
 
   const auto& info = it->second;
+  auto& chunk = *info.chunk;
 
   // update Vbo's
-  m_vertexArray->deleteVerticesWithKey(info.vertexHolderKey);
+  chunk.vertexArray->deleteVerticesWithKey(info.vertexHolderKey);
   if (info.edgeIndicesKey != nullptr)
   {
-    m_edgeIndices->zeroElementsWithKey(info.edgeIndicesKey);
+    chunk.edgeIndices->zeroElementsWithKey(info.edgeIndicesKey);
   }
 
   for (const auto& [material, opaqueKey] : info.opaqueFaceIndicesKeys)
   {
-    auto faceIndexHolder = m_opaqueFaces->at(material);
+    auto faceIndexHolder = chunk.opaqueFaces->at(material);
     faceIndexHolder->zeroElementsWithKey(opaqueKey);
 
     if (!faceIndexHolder->hasValidIndices())
     {
       // There are no indices left to render for this material, so delete the <Material,
       // BrushIndexArray> entry from the map
-      m_opaqueFaces->erase(material);
+      chunk.opaqueFaces->erase(material);
     }
   }
   for (const auto& [material, transparentKey] : info.transparentFaceIndicesKeys)
   {
-    auto faceIndexHolder = m_transparentFaces->at(material);
+    auto faceIndexHolder = chunk.transparentFaces->at(material);
     faceIndexHolder->zeroElementsWithKey(transparentKey);
 
     if (!faceIndexHolder->hasValidIndices())
     {
       // There are no indices left to render for this material, so delete the <Material,
       // BrushIndexArray> entry from the map
-      m_transparentFaces->erase(material);
+      chunk.transparentFaces->erase(material);
     }
   }
 
+  --chunk.brushCount;
+
   m_brushInfo.erase(it);
 }
 
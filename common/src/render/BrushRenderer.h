@@ -26,6 +26,10 @@
 #include "render/EdgeRenderer.h"
 #include "render/FaceRenderer.h"
 
+#include "vm/bbox.h"
+#include "vm/vec.h"
+
+#include <map>
 #include <memory>
 #include <tuple>
 #include <unordered_map>
@@ -119,8 +123,38 @@ public:
 private:
   std::unique_ptr<Filter> m_filter;
 
+  using MaterialToBrushIndicesMap =
+    std::unordered_map<const mdl::Material*, std::shared_ptr<BrushIndexArray>>;
+
+  /**
+   * A spatial cell of brushes. Every chunk owns its vertex and index arrays, so that
+   * changing a brush only re-uploads the arrays of the chunk that contains it, and so
+   * that chunks outside of the view frustum can be skipped when rendering.
+   */
+  struct Chunk
+  {
+    std::shared_ptr<BrushVertexArray> vertexArray;
+    std::shared_ptr<BrushIndexArray> edgeIndices;
+    std::shared_ptr<MaterialToBrushIndicesMap> transparentFaces;
+    std::shared_ptr<MaterialToBrushIndicesMap> opaqueFaces;
+
+    FaceRenderer opaqueFaceRenderer;
+    FaceRenderer transparentFaceRenderer;
+    IndexedEdgeRenderer edgeRenderer;
+
+    /**
+     * The union of the bounds of the brushes in this chunk. The bounds only grow while
+     * the chunk contains any brushes, so they might be larger than necessary.
+     */
+    vm::bbox3f bounds;
+    size_t brushCount = 0;
+
+    Chunk();
+  };
+
   struct BrushInfo
   {
+    Chunk* chunk;
     AllocationTracker::Block* vertexHolderKey;
     AllocationTracker::Block* edgeIndicesKey;
     std::vector<std::pair<const mdl::Material*, AllocationTracker::Block*>>
@@ -143,17 +177,12 @@ private:
   std::unordered_set<const mdl::BrushNode*> m_allBrushes;
   std::unordered_set<const mdl::BrushNode*> m_invalidBrushes;
 
-  std::shared_ptr<BrushVertexArray> m_vertexArray;
-  std::shared_ptr<BrushIndexArray> m_edgeIndices;
-
-  using MaterialToBrushIndicesMap =
-    std::unordered_map<const mdl::Material*, std::shared_ptr<BrushIndexArray>>;
-  std::shared_ptr<MaterialToBrushIndicesMap> m_transparentFaces;
-  std::shared_ptr<MaterialToBrushIndicesMap> m_opaqueFaces;
-
-  FaceRenderer m_opaqueFaceRenderer;
-  FaceRenderer m_transparentFaceRenderer;
-  IndexedEdgeRenderer m_edgeRenderer;
+  /**
+   * The edge length of the cubic cells that brushes are grouped into, or 0 if all
+   * brushes are kept in a single chunk.
+   */
+  double m_chunkSize = 0.0;
+  std::map<vm::vec3d, std::unique_ptr<Chunk>> m_chunks;
 
   Color m_faceColor;
   bool m_showEdges = false;
@@ -193,9 +222,9 @@ public:
    * Until a brush is invalidated, we don't re-evaluate the Filter, and don't check the
    * Brush object for modification.
    *
-   * Additionally, calling `invalidate()` guarantees the m_brushInfo, m_transparentFaces,
-   * and m_opaqueFaces maps will be empty, so the BrushRenderer will not have any
-   * lingering Material* pointers.
+   * Additionally, calling `invalidate()` guarantees the m_brushInfo map and the
+   * transparent and opaque face maps of every chunk will be empty, so the BrushRenderer
+   * will not have any lingering Material* pointers.
    */
   void invalidate();
   void invalidateMaterials(const std::vector<const mdl::Material*>& materials);
@@ -203,6 +232,20 @@ public:
   void invalidateMaterial(const mdl::Material& material);
   bool valid() const;
 
+  /**
+   * Partitions the brushes into cubic cells with the given edge length. Pass 0 to keep
+   * all brushes in a single chunk, which is the default.
+   *
+   * Chunking pays off for renderers that hold many brushes spread over a large area,
+   * such as the renderer for the unselected world brushes.
+   */
+  void setChunkSize(double chunkSize);
+
+  /**
+   * Returns the number of chunks that currently contain brushes.
+   */
+  size_t chunkCount() const;
+
   /**
    * Sets the color to render faces with no material with.
    */
@@ -276,9 +319,9 @@ public: // rendering
   void renderTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
 
 private:
-  void renderOpaqueFaces(RenderBatch& renderBatch);
-  void renderTransparentFaces(RenderBatch& renderBatch);
-  void renderEdges(RenderBatch& renderBatch);
+  void renderOpaqueFaces(Chunk& chunk, RenderBatch& renderBatch);
+  void renderTransparentFaces(Chunk& chunk, RenderBatch& renderBatch);
+  void renderEdges(Chunk& chunk, RenderBatch& renderBatch);
 
 public:
   /**
@@ -290,6 +333,7 @@ private:
   bool shouldDrawFaceInTransparentPass(
     const mdl::BrushNode& brushNode, const mdl::BrushFace& face) const;
   void validateBrush(const mdl::BrushNode& brushNode);
+  Chunk& chunkFor(const mdl::BrushNode& brushNode);
 
 public:
   /**
@@ -187,6 +187,29 @@ void Camera::frustumPlanes(
   doComputeFrustumPlanes(top, right, bottom, left);
 }
 
+bool Camera::intersectsFrustum(const vm::bbox3f& bounds) const
+{
+  if (!m_valid)
+  {
+    validateMatrices();
+  }
+
+  for (const auto& plane : m_frustumPlanes)
+  {
+    // the corner of the box that is furthest behind the plane
+    const auto corner = vm::vec3f{
+      plane.normal.x() > 0.0f ? bounds.min.x() : bounds.max.x(),
+      plane.normal.y() > 0.0f ? bounds.min.y() : bounds.max.y(),
+      plane.normal.z() > 0.0f ? bounds.min.z() : bounds.max.z(),
+    };
+    if (plane.point_distance(corner) > 0.0f)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
 vm::ray3f Camera::viewRay() const
 {
   return {m_position, m_direction};
@@ -493,6 +516,8 @@ void Camera::validateMatrices() const
   m_matrix = m_projectionMatrix * m_viewMatrix;
 
   m_inverseMatrix = *vm::invert(m_matrix);
+  doComputeFrustumPlanes(
+    m_frustumPlanes[0], m_frustumPlanes[1], m_frustumPlanes[2], m_frustumPlanes[3]);
   m_valid = true;
 }
 
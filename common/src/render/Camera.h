@@ -23,12 +23,14 @@
 
 #include "kdl/reflection_decl.h"
 
+#include "vm/bbox.h"
 #include "vm/mat.h"
 #include "vm/plane.h"
 #include "vm/ray.h"
 #include "vm/segment.h"
 #include "vm/vec.h"
 
+#include <array>
 #include <optional>
 
 namespace tb
@@ -89,6 +91,7 @@ private:
   mutable vm::mat4x4f m_viewMatrix;
   mutable vm::mat4x4f m_matrix;
   mutable vm::mat4x4f m_inverseMatrix;
+  mutable std::array<vm::plane3f, 4> m_frustumPlanes;
 
 protected:
   enum class ProjectionType
@@ -127,6 +130,16 @@ public:
     vm::plane3f& bottomPlane,
     vm::plane3f& leftPlane) const;
 
+  /**
+   * Checks whether the given bounding box intersects the view frustum or is contained in
+   * it. Only the side planes of the frustum are considered, so objects beyond the far
+   * plane are not rejected.
+   *
+   * The test is conservative: it may report a box that is just outside of a corner of
+   * the frustum as visible, but it never rejects a box that is actually visible.
+   */
+  bool intersectsFrustum(const vm::bbox3f& bounds) const;
+
   vm::ray3f viewRay() const;
   vm::ray3f pickRay(float x, float y) const;
   vm::ray3f pickRay(const vm::vec3f& point) const;
@@ -19,8 +19,6 @@
 
 #include "EdgeRenderer.h"
 
-#include "PreferenceManager.h"
-#include "Preferences.h"
 #include "render/ActiveShader.h"
 #include "render/BrushRendererArrays.h"
 #include "render/PrimType.h"
@@ -28,6 +26,7 @@
 #include "render/RenderContext.h"
 #include "render/RenderUtils.h"
 #include "render/Shaders.h"
+#include "render/Uniforms.h"
 
 namespace tb::render
 {
@@ -88,18 +87,13 @@ void EdgeRenderer::RenderBase::renderEdges(RenderContext& renderContext)
 
   {
     auto shader = ActiveShader{renderContext.shaderManager(), Shaders::EdgeShader};
-    shader.set("ShowSoftMapBounds", !renderContext.softMapBounds().is_empty());
-    shader.set("SoftMapBoundsMin", renderContext.softMapBounds().min);
-    shader.set("SoftMapBoundsMax", renderContext.softMapBounds().max);
+    const auto& frameUniforms = renderContext.frameUniforms();
+    shader.applyFrameUniforms(frameUniforms);
+    // NOTE: heavier tint than FaceRenderer, since these are lines
     shader.set(
-      "SoftMapBoundsColor",
-      vm::vec4f{
-        pref(Preferences::SoftMapBoundsColor).r(),
-        pref(Preferences::SoftMapBoundsColor).g(),
-        pref(Preferences::SoftMapBoundsColor).b(),
-        0.33f}); // NOTE: heavier tint than FaceRenderer, since these are lines
-    shader.set("UseUniformColor", m_params.useColor);
-    shader.set("Color", m_params.color);
+      Uniforms::SoftMapBoundsColor, vm::vec4f{frameUniforms.softMapBoundsColor, 0.33f});
+    shader.set(Uniforms::UseUniformColor, m_params.useColor);
+    shader.set(Uniforms::Color, m_params.color);
     doRenderVertices(renderContext);
   }
 
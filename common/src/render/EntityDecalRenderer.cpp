@@ -36,6 +36,7 @@
 
 #include "kdl/memory_utils.h"
 #include "kdl/overload.h"
+#include "kdl/vector_set.h"
 
 #include "vm/intersection.h"
 
@@ -143,6 +144,7 @@ std::vector<Vertex> createDecalBrushFace(
 
 EntityDecalRenderer::EntityDecalRenderer(std::weak_ptr<ui::MapDocument> document)
   : m_document{std::move(document)}
+  , m_entityTree{256.0}
 {
   clear();
 }
@@ -151,13 +153,19 @@ void EntityDecalRenderer::invalidate()
 {
   for (auto& [ent, data] : m_entities)
   {
-    invalidateDecalData(data);
+    invalidateDecalData(ent, data);
   }
+
+  // every decal has been invalidated already
+  m_changedBrushes.clear();
 }
 
 void EntityDecalRenderer::clear()
 {
   m_entities.clear();
+  m_entityTree.clear();
+  m_brushDependents.clear();
+  m_changedBrushes.clear();
   m_vertexArray = std::make_shared<BrushVertexArray>();
   m_faces = std::make_shared<MaterialToBrushIndicesMap>();
   m_faceRenderer = FaceRenderer{m_vertexArray, m_faces, m_faceColor};
@@ -185,6 +193,40 @@ void EntityDecalRenderer::removeNode(mdl::Node* node)
     [](mdl::PatchNode*) {}));
 }
 
+void EntityDecalRenderer::validate()
+{
+  invalidateChangedBrushes();
+
+  // update any invalidated entities if required
+  for (auto& [ent, data] : m_entities)
+  {
+    validateDecalData(ent, data);
+  }
+}
+
+std::vector<const mdl::EntityNode*> EntityDecalRenderer::findEntities(
+  const vm::bbox3d& bounds) const
+{
+  return m_entityTree.find_intersectors(bounds);
+}
+
+std::vector<const mdl::BrushNode*> EntityDecalRenderer::decalBrushes(
+  const mdl::EntityNode* entityNode) const
+{
+  const auto it = m_entities.find(entityNode);
+  return it != m_entities.end() && it->second.validated
+           ? it->second.brushes
+           : std::vector<const mdl::BrushNode*>{};
+}
+
+std::vector<const mdl::EntityNode*> EntityDecalRenderer::brushDependents(
+  const mdl::BrushNode* brushNode) const
+{
+  const auto it = m_brushDependents.find(brushNode);
+  return it != m_brushDependents.end() ? it->second
+                                       : std::vector<const mdl::EntityNode*>{};
+}
+
 void EntityDecalRenderer::updateEntity(const mdl::EntityNode* entityNode)
 {
   // if the entity isn't visible, don't create decal geometry for it
@@ -200,7 +242,8 @@ void EntityDecalRenderer::updateEntity(const mdl::EntityNode* entityNode)
   if (isTracking && spec)
   {
     // entity is being tracked and has a decal specification, invalidate it
-    invalidateDecalData(entity->second);
+    invalidateDecalData(entityNode, entity->second);
+    m_entityTree.update(entityNode->physicalBounds(), entityNode);
   }
   else if (isTracking)
   {
@@ -211,6 +254,7 @@ void EntityDecalRenderer::updateEntity(const mdl::EntityNode* entityNode)
   {
     // entity is not being tracked and has a decal specification, start tracking it
     m_entities.insert({entityNode, EntityDecalData{}});
+    m_entityTree.insert(entityNode->physicalBounds(), entityNode);
   }
 }
 
@@ -219,60 +263,78 @@ void EntityDecalRenderer::removeEntity(const mdl::EntityNode* entityNode)
   if (const auto it = m_entities.find(entityNode); it != std::end(m_entities))
   {
     // make sure the entity data is cleaned up
-    invalidateDecalData(it->second);
+    invalidateDecalData(entityNode, it->second);
+    m_entityTree.remove(entityNode);
     m_entities.erase(it);
   }
 }
 
 void EntityDecalRenderer::updateBrush(const mdl::BrushNode* brushNode)
 {
-  // invalidate any entities that intersect this brush or are tracking this brush
-  for (auto& [ent, data] : m_entities)
-  {
-    // skip entities that are going to be recomputed anyway
-    if (!data.validated)
-    {
-      continue;
-    }
+  // defer the invalidation so that changing many brushes at once invalidates every
+  // affected entity only once
+  m_changedBrushes.insert(brushNode);
+}
 
-    // if the brush is not visible, then it doesn't (currently) intersect
-    const auto& editorContext = kdl::mem_lock(m_document)->editorContext();
-    const auto intersects =
-      editorContext.visible(brushNode) && brushNode->intersects(ent);
-    const auto tracked = std::find(data.brushes.begin(), data.brushes.end(), brushNode)
-                         != data.brushes.end();
-
-    // if this brush is tracked by this entity or intersects, we'll need to
-    // recalculate the geometry
-    if (intersects || tracked)
+void EntityDecalRenderer::removeBrush(const mdl::BrushNode* brushNode)
+{
+  m_changedBrushes.erase(brushNode);
+
+  // invalidate any entities that are tracking this brush, this removes them from the
+  // brush's dependents
+  if (const auto it = m_brushDependents.find(brushNode); it != m_brushDependents.end())
+  {
+    const auto dependents = it->second;
+    for (const auto* entityNode : dependents)
     {
-      invalidateDecalData(data);
+      invalidateDecalData(entityNode, m_entities.at(entityNode));
     }
+    m_brushDependents.erase(brushNode);
   }
 }
 
-void EntityDecalRenderer::removeBrush(const mdl::BrushNode* brushNode)
+void EntityDecalRenderer::invalidateChangedBrushes()
 {
-  // invalidate any entities that are tracking this brush
-  for (auto& [ent, data] : m_entities)
+  if (m_changedBrushes.empty())
+  {
+    return;
+  }
+
+  const auto& editorContext = kdl::mem_lock(m_document)->editorContext();
+
+  // collect the entities that intersect a changed brush or are tracking one
+  auto affectedEntities = kdl::vector_set<const mdl::EntityNode*>{};
+  for (const auto* brushNode : m_changedBrushes)
   {
-    // skip entities that are going to be recomputed anyway
-    if (!data.validated)
+    if (const auto it = m_brushDependents.find(brushNode); it != m_brushDependents.end())
     {
-      continue;
+      affectedEntities.insert(it->second.begin(), it->second.end());
     }
 
-    // if this brush is tracked by this entity, remove it and recalculate
-    const auto tracked = std::find(data.brushes.begin(), data.brushes.end(), brushNode)
-                         != data.brushes.end();
-    if (tracked)
+    // if the brush is not visible, then it doesn't (currently) intersect
+    if (editorContext.visible(brushNode))
     {
-      invalidateDecalData(data);
+      for (const auto* entityNode :
+           m_entityTree.find_intersectors(brushNode->physicalBounds()))
+      {
+        // skip entities that are going to be recomputed anyway
+        if (m_entities.at(entityNode).validated && brushNode->intersects(entityNode))
+        {
+          affectedEntities.insert(entityNode);
+        }
+      }
     }
   }
+  m_changedBrushes.clear();
+
+  for (const auto* entityNode : affectedEntities)
+  {
+    invalidateDecalData(entityNode, m_entities.at(entityNode));
+  }
 }
 
-void EntityDecalRenderer::invalidateDecalData(EntityDecalData& data) const
+void EntityDecalRenderer::invalidateDecalData(
+  const mdl::EntityNode* entityNode, EntityDecalData& data)
 {
   // do nothing if the brush data is already marked as invalidated
   if (!data.validated)
@@ -282,6 +344,21 @@ void EntityDecalRenderer::invalidateDecalData(EntityDecalData& data) const
 
   data.validated = false;
 
+  // the brushes will be collected again on validation
+  for (const auto* brushNode : data.brushes)
+  {
+    if (const auto it = m_brushDependents.find(brushNode); it != m_brushDependents.end())
+    {
+      auto& dependents = it->second;
+      dependents.erase(
+        std::remove(dependents.begin(), dependents.end(), entityNode), dependents.end());
+      if (dependents.empty())
+      {
+        m_brushDependents.erase(it);
+      }
+    }
+  }
+
   // if the material doesn't exist, do nothing
   // also do nothing if the VBO storage fields are null, but it shouldn't happen
   if (!data.material || !data.vertexHolderKey || !data.faceIndicesKey)
@@ -306,7 +383,7 @@ void EntityDecalRenderer::invalidateDecalData(EntityDecalData& data) const
 }
 
 void EntityDecalRenderer::validateDecalData(
-  const mdl::EntityNode* entityNode, EntityDecalData& data) const
+  const mdl::EntityNode* entityNode, EntityDecalData& data)
 {
   if (data.validated)
   {
@@ -333,6 +410,7 @@ void EntityDecalRenderer::validateDecalData(
     if (brushNode && editorContext.visible(brushNode))
     {
       data.brushes.push_back(brushNode);
+      m_brushDependents[brushNode].push_back(entityNode);
     }
   }
 
@@ -418,12 +496,7 @@ void EntityDecalRenderer::validateDecalData(
 
 void EntityDecalRenderer::render(RenderContext&, RenderBatch& renderBatch)
 {
-  // update any invalidated entities if required
-  for (auto& [ent, data] : m_entities)
-  {
-    validateDecalData(ent, data);
-  }
-
+  validate();
   m_faceRenderer.render(renderBatch);
 }
 
@@ -20,14 +20,18 @@
 #pragma once
 
 #include "Color.h"
+#include "octree.h"
 #include "render/AllocationTracker.h"
 #include "render/EdgeRenderer.h"
 #include "render/FaceRenderer.h"
 #include "render/GLVertexType.h"
 #include "render/Renderable.h"
 
+#include "vm/bbox.h"
+
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace tb::mdl
@@ -67,10 +71,23 @@ private:
 
   using EntityWithDependenciesMap =
     std::unordered_map<const mdl::EntityNode*, EntityDecalData>;
+  using EntityTree = octree<double, const mdl::EntityNode*>;
+  using BrushToEntitiesMap =
+    std::unordered_map<const mdl::BrushNode*, std::vector<const mdl::EntityNode*>>;
 
   std::weak_ptr<ui::MapDocument> m_document;
   EntityWithDependenciesMap m_entities;
 
+  /* indexes the tracked entities by their physical bounds */
+  EntityTree m_entityTree;
+
+  /* maps a brush to the entities whose validated decal geometry was created from it */
+  BrushToEntitiesMap m_brushDependents;
+
+  /* brushes that have changed since the decals were last invalidated, these are processed
+   * in one batch before rendering */
+  std::unordered_set<const mdl::BrushNode*> m_changedBrushes;
+
   using Vertex = render::GLVertexTypes::P3NT2C4::Vertex;
   using MaterialToBrushIndicesMap =
     std::unordered_map<const mdl::Material*, std::shared_ptr<BrushIndexArray>>;
@@ -103,15 +120,48 @@ public:
    */
   void removeNode(mdl::Node* node);
 
+  /**
+   * Processes the changed brushes and recomputes the decal geometry of all invalidated
+   * entities. This is done before rendering.
+   */
+  void validate();
+
+  /**
+   * Returns the tracked entities whose bounds intersect the given bounds. Exposed for
+   * testing.
+   */
+  std::vector<const mdl::EntityNode*> findEntities(const vm::bbox3d& bounds) const;
+
+  /**
+   * Returns the brushes that the decal geometry of the given entity was created from, or
+   * an empty vector if the entity is not tracked or its decal is invalid. Exposed for
+   * testing.
+   */
+  std::vector<const mdl::BrushNode*> decalBrushes(const mdl::EntityNode* entityNode) const;
+
+  /**
+   * Returns the entities whose decal geometry was created from the given brush. Exposed
+   * for testing.
+   */
+  std::vector<const mdl::EntityNode*> brushDependents(
+    const mdl::BrushNode* brushNode) const;
+
 private:
   void updateEntity(const mdl::EntityNode* entityNode);
   void removeEntity(const mdl::EntityNode* entityNode);
   void updateBrush(const mdl::BrushNode* brushNode);
   void removeBrush(const mdl::BrushNode* brushNode);
 
-  void invalidateDecalData(EntityDecalData& data) const;
+  /**
+   * Invalidates the decals of all entities that intersect any of the changed brushes or
+   * that were created from any of them. Every affected entity is invalidated only once,
+   * no matter how many of the changed brushes it depends on.
+   */
+  void invalidateChangedBrushes();
+
+  void invalidateDecalData(const mdl::EntityNode* entityNode, EntityDecalData& data);
 
-  void validateDecalData(const mdl::EntityNode* entityNode, EntityDecalData& data) const;
+  void validateDecalData(const mdl::EntityNode* entityNode, EntityDecalData& data);
 
 public: // rendering
   void render(RenderContext& renderContext, RenderBatch& renderBatch);
@@ -20,8 +20,6 @@
 #include "EntityModelRenderer.h"
 
 #include "Logger.h"
-#include "PreferenceManager.h"
-#include "Preferences.h"
 #include "mdl/AssetUtils.h"
 #include "mdl/EditorContext.h"
 #include "mdl/Entity.h"
@@ -29,13 +27,16 @@
 #include "mdl/EntityModelManager.h"
 #include "mdl/EntityNode.h"
 #include "render/ActiveShader.h"
-#include "render/Camera.h"
 #include "render/MaterialIndexRangeRenderer.h"
 #include "render/RenderBatch.h"
 #include "render/RenderContext.h"
 #include "render/RenderUtils.h"
 #include "render/Shaders.h"
+#include "render/ShaderManager.h"
 #include "render/Transformation.h"
+#include "render/Uniforms.h"
+#include "render/Vbo.h"
+#include "render/VboManager.h"
 
 #include "vm/mat.h"
 
@@ -57,6 +58,11 @@ EntityModelRenderer::EntityModelRenderer(
 EntityModelRenderer::~EntityModelRenderer()
 {
   clear();
+
+  if (m_instanceVbo)
+  {
+    m_vboManager->destroyVbo(m_instanceVbo);
+  }
 }
 
 void EntityModelRenderer::addEntity(const mdl::EntityNode* entityNode)
@@ -113,6 +119,7 @@ void EntityModelRenderer::updateEntity(const mdl::EntityNode* entityNode)
 void EntityModelRenderer::clear()
 {
   m_entities.clear();
+  m_instanceGroups.clear();
 }
 
 bool EntityModelRenderer::applyTinting() const
@@ -153,71 +160,206 @@ void EntityModelRenderer::render(RenderBatch& renderBatch)
 void EntityModelRenderer::doPrepareVertices(VboManager& vboManager)
 {
   m_entityModelManager.prepare(vboManager);
+
+  if (!glSupportsInstancing())
+  {
+    return;
+  }
+
+  const auto requiredCapacity = m_entities.size() * sizeof(vm::mat4x4f);
+  if (!m_instanceVbo || m_instanceVbo->capacity() < requiredCapacity)
+  {
+    if (m_instanceVbo)
+    {
+      m_vboManager->destroyVbo(m_instanceVbo);
+      m_instanceVbo = nullptr;
+    }
+
+    if (requiredCapacity > 0)
+    {
+      // grow geometrically to avoid reallocating whenever an entity is added
+      m_vboManager = &vboManager;
+      m_instanceVbo = vboManager.allocateVbo(
+        VboType::ArrayBuffer, requiredCapacity * 3 / 2, VboUsage::DynamicDraw);
+    }
+  }
 }
 
 void EntityModelRenderer::doRender(RenderContext& renderContext)
 {
   if (!m_entities.empty())
   {
-    auto& prefs = PreferenceManager::instance();
-
     glAssert(glEnable(GL_TEXTURE_2D));
     glAssert(glActiveTexture(GL_TEXTURE0));
 
-    auto shader = ActiveShader{renderContext.shaderManager(), Shaders::EntityModelShader};
-    shader.set("Brightness", prefs.get(Preferences::Brightness));
-    shader.set("ApplyTinting", m_applyTinting);
-    shader.set("TintColor", m_tintColor);
-    shader.set("GrayScale", false);
-    shader.set("Material", 0);
-    shader.set("ShowSoftMapBounds", !renderContext.softMapBounds().is_empty());
-    shader.set("SoftMapBoundsMin", renderContext.softMapBounds().min);
-    shader.set("SoftMapBoundsMax", renderContext.softMapBounds().max);
-    shader.set(
-      "SoftMapBoundsColor",
-      vm::vec4f{
-        prefs.get(Preferences::SoftMapBoundsColor).r(),
-        prefs.get(Preferences::SoftMapBoundsColor).g(),
-        prefs.get(Preferences::SoftMapBoundsColor).b(),
-        0.1f});
-
-    shader.set("CameraPosition", renderContext.camera().position());
-    shader.set("CameraDirection", renderContext.camera().direction());
-    shader.set("CameraRight", renderContext.camera().right());
-    shader.set("CameraUp", renderContext.camera().up());
-    shader.set("ViewMatrix", renderContext.camera().viewMatrix());
-
-    const auto& propertyConfig = m_entities.begin()->first->entityPropertyConfig();
-    const auto& defaultModelScaleExpression = propertyConfig.defaultModelScaleExpression;
-
-    for (const auto& [entityNode, renderer] : m_entities)
+    collectInstanceGroups(renderContext);
+
+    if (
+      m_instanceVbo
+      && m_instanceVbo->capacity()
+           >= m_instanceTransformations.size() * sizeof(vm::mat4x4f))
+    {
+      renderInstanced(renderContext);
+    }
+    else
+    {
+      renderSingle(renderContext);
+    }
+
+    m_instanceTransformations.clear();
+    for (auto it = m_instanceGroups.begin(); it != m_instanceGroups.end();)
     {
-      if (!m_showHiddenEntities && !m_editorContext.visible(entityNode))
+      // drop groups that were not used in this frame, their renderers may be gone
+      if (it->second.transformations.empty())
       {
-        continue;
+        it = m_instanceGroups.erase(it);
       }
-
-      const auto* model = entityNode->entity().model();
-      const auto* modelData = model ? model->data() : nullptr;
-      if (!modelData)
+      else
       {
-        continue;
+        it->second.transformations.clear();
+        ++it;
       }
+    }
+  }
+}
+
+void EntityModelRenderer::collectInstanceGroups(RenderContext& renderContext)
+{
+  const auto& propertyConfig = m_entities.begin()->first->entityPropertyConfig();
+  const auto& defaultModelScaleExpression = propertyConfig.defaultModelScaleExpression;
+
+  for (const auto& [entityNode, renderer] : m_entities)
+  {
+    if (!m_showHiddenEntities && !m_editorContext.visible(entityNode))
+    {
+      continue;
+    }
+
+    const auto* model = entityNode->entity().model();
+    const auto* modelData = model ? model->data() : nullptr;
+    if (
+      !modelData
+      || !renderContext.intersectsFrustum(vm::bbox3f{entityNode->physicalBounds()}))
+    {
+      continue;
+    }
+
+    auto& group = m_instanceGroups[renderer];
+    group.orientation = modelData->orientation();
+    group.transformations.emplace_back(
+      entityNode->entity().modelTransformation(defaultModelScaleExpression));
+  }
+
+  for (const auto& [renderer, group] : m_instanceGroups)
+  {
+    m_instanceTransformations.insert(
+      m_instanceTransformations.end(),
+      group.transformations.begin(),
+      group.transformations.end());
+  }
+}
+
+void EntityModelRenderer::renderInstanced(RenderContext& renderContext)
+{
+  if (m_instanceTransformations.empty())
+  {
+    return;
+  }
+
+  auto shader =
+    ActiveShader{renderContext.shaderManager(), Shaders::EntityModelInstancedShader};
+  setupShader(shader, renderContext);
+
+  m_instanceVbo->writeBuffer(0, m_instanceTransformations);
+
+  auto* program = renderContext.shaderManager().currentProgram();
+  const auto location = GLuint(program->findAttributeLocation("InstanceModelMatrix"));
+
+  // a mat4 attribute occupies four consecutive locations, one for each column
+  for (GLuint column = 0; column < 4; ++column)
+  {
+    glAssert(glEnableVertexAttribArray(location + column));
+    glSetVertexAttribDivisor(location + column, 1);
+  }
+
+  auto drawCalls = size_t(0);
+  auto offset = size_t(0);
+  for (const auto& [renderer, group] : m_instanceGroups)
+  {
+    if (group.transformations.empty())
+    {
+      continue;
+    }
+
+    m_instanceVbo->bind();
+    for (GLuint column = 0; column < 4; ++column)
+    {
+      glAssert(glVertexAttribPointer(
+        location + column,
+        4,
+        GL_FLOAT,
+        GL_FALSE,
+        GLsizei(sizeof(vm::mat4x4f)),
+        reinterpret_cast<GLvoid*>(offset + column * sizeof(vm::vec4f))));
+    }
+    m_instanceVbo->unbind();
+
+    shader.set(Uniforms::Orientation, static_cast<int>(group.orientation));
+
+    auto renderFunc = DefaultMaterialRenderFunc{
+      renderContext.minFilterMode(), renderContext.magFilterMode()};
+    drawCalls += renderer->renderInstances(renderFunc, group.transformations.size());
+
+    offset += group.transformations.size() * sizeof(vm::mat4x4f);
+  }
 
-      shader.set("Orientation", static_cast<int>(modelData->orientation()));
+  for (GLuint column = 0; column < 4; ++column)
+  {
+    glSetVertexAttribDivisor(location + column, 0);
+    glAssert(glDisableVertexAttribArray(location + column));
+  }
+
+  renderContext.countEntityModelDraws(drawCalls, m_instanceTransformations.size());
+}
 
-      const auto transformation = vm::mat4x4f{
-        entityNode->entity().modelTransformation(defaultModelScaleExpression)};
+void EntityModelRenderer::renderSingle(RenderContext& renderContext)
+{
+  auto shader = ActiveShader{renderContext.shaderManager(), Shaders::EntityModelShader};
+  setupShader(shader, renderContext);
+
+  auto drawCalls = size_t(0);
+  for (const auto& [renderer, group] : m_instanceGroups)
+  {
+    shader.set(Uniforms::Orientation, static_cast<int>(group.orientation));
+
+    for (const auto& transformation : group.transformations)
+    {
       const auto multMatrix =
         MultiplyModelMatrix{renderContext.transformation(), transformation};
 
-      shader.set("ModelMatrix", transformation);
+      shader.set(Uniforms::ModelMatrix, transformation);
 
       auto renderFunc = DefaultMaterialRenderFunc{
         renderContext.minFilterMode(), renderContext.magFilterMode()};
-      renderer->render(renderFunc);
+      drawCalls += renderer->renderInstances(renderFunc, 1);
     }
   }
+
+  renderContext.countEntityModelDraws(drawCalls, m_instanceTransformations.size());
+}
+
+void EntityModelRenderer::setupShader(
+  ActiveShader& shader, RenderContext& renderContext) const
+{
+  const auto& frameUniforms = renderContext.frameUniforms();
+
+  shader.applyFrameUniforms(frameUniforms);
+  shader.set(Uniforms::ApplyTinting, m_applyTinting);
+  shader.set(Uniforms::TintColor, m_tintColor);
+  shader.set(Uniforms::GrayScale, false);
+  shader.set(Uniforms::Material, 0);
+  shader.set(
+    Uniforms::SoftMapBoundsColor, vm::vec4f{frameUniforms.softMapBoundsColor, 0.1f});
 }
 
 } // namespace tb::render
@@ -22,7 +22,10 @@
 #include "Color.h"
 #include "render/Renderable.h"
 
+#include "vm/mat.h"
+
 #include <unordered_map>
+#include <vector>
 
 namespace tb
 {
@@ -34,17 +37,36 @@ namespace tb::mdl
 class EditorContext;
 class EntityModelManager;
 class EntityNode;
+enum class Orientation;
 } // namespace tb::mdl
 
 namespace tb::render
 {
+class ActiveShader;
 class RenderBatch;
 struct ShaderConfig;
 class MaterialRenderer;
-
+class Vbo;
+class VboManager;
+
+/**
+ * Renders the models of entities.
+ *
+ * Entities that share a model, frame and skin share a material renderer. If the GL
+ * context supports instanced rendering, the visible entities are grouped by their
+ * material renderer and each group is drawn with instanced draw calls, reading the model
+ * matrices of the entities from an instance buffer. Otherwise, every entity is drawn
+ * separately.
+ */
 class EntityModelRenderer : public DirectRenderable
 {
 private:
+  struct InstanceGroup
+  {
+    mdl::Orientation orientation;
+    std::vector<vm::mat4x4f> transformations;
+  };
+
   Logger& m_logger;
 
   mdl::EntityModelManager& m_entityModelManager;
@@ -52,6 +74,13 @@ private:
 
   std::unordered_map<const mdl::EntityNode*, MaterialRenderer*> m_entities;
 
+  VboManager* m_vboManager = nullptr;
+  Vbo* m_instanceVbo = nullptr;
+
+  // reused across frames to avoid allocations
+  std::unordered_map<MaterialRenderer*, InstanceGroup> m_instanceGroups;
+  std::vector<vm::mat4x4f> m_instanceTransformations;
+
   bool m_applyTinting = false;
   Color m_tintColor;
 
@@ -109,6 +138,11 @@ public:
 private:
   void doPrepareVertices(VboManager& vboManager) override;
   void doRender(RenderContext& renderContext) override;
+
+  void collectInstanceGroups(RenderContext& renderContext);
+  void renderInstanced(RenderContext& renderContext);
+  void renderSingle(RenderContext& renderContext);
+  void setupShader(ActiveShader& shader, RenderContext& renderContext) const;
 };
 
 } // namespace tb::render
@@ -293,8 +293,9 @@ void EntityRenderer::renderClassnames(
       if (m_showHiddenEntities || m_editorContext.visible(entity))
       {
         if (
-          !entity->containingGroup()
-          || entity->containingGroup() == m_editorContext.currentGroup())
+          (!entity->containingGroup()
+           || entity->containingGroup() == m_editorContext.currentGroup())
+          && renderContext.camera().intersectsFrustum(vm::bbox3f{entity->logicalBounds()}))
         {
           if (m_showOccludedOverlays)
           {
@@ -326,7 +327,10 @@ void EntityRenderer::renderAngles(RenderContext& renderContext, RenderBatch& ren
 
     for (const auto* entityNode : m_entities)
     {
-      if (!m_showHiddenEntities && !m_editorContext.visible(entityNode))
+      if (
+        (!m_showHiddenEntities && !m_editorContext.visible(entityNode))
+        || !renderContext.camera().intersectsFrustum(
+          vm::bbox3f{entityNode->logicalBounds()}))
       {
         continue;
       }
@@ -0,0 +1,61 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FrameUniforms.h"
+
+#include "PreferenceManager.h"
+#include "Preferences.h"
+#include "render/Camera.h"
+
+#include <atomic>
+
+namespace tb::render
+{
+namespace
+{
+
+size_t nextFrameUniformsId()
+{
+  static auto nextId = std::atomic<size_t>{1};
+  return nextId++;
+}
+
+} // namespace
+
+FrameUniforms makeFrameUniforms(const Camera& camera, const vm::bbox3f& softMapBounds)
+{
+  auto& prefs = PreferenceManager::instance();
+
+  return FrameUniforms{
+    nextFrameUniformsId(),
+    camera.viewMatrix(),
+    camera.position(),
+    camera.direction(),
+    camera.right(),
+    camera.up(),
+    !softMapBounds.is_empty(),
+    softMapBounds.min,
+    softMapBounds.max,
+    prefs.get(Preferences::SoftMapBoundsColor).xyz(),
+    prefs.get(Preferences::Brightness),
+    prefs.get(Preferences::GridAlpha),
+  };
+}
+
+} // namespace tb::render
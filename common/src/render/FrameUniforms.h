@@ -0,0 +1,61 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "vm/bbox.h"
+#include "vm/mat.h"
+#include "vm/vec.h"
+
+namespace tb::render
+{
+class Camera;
+
+/**
+ * The uniforms that are shared by the map renderers and that only change once per frame:
+ * The camera, the soft map bounds and some global preferences.
+ *
+ * A shader program uploads these values only if it has not seen a frame uniforms
+ * instance with the same ID before, see ShaderProgram::applyFrameUniforms. Every call to
+ * makeFrameUniforms returns an instance with a new ID.
+ */
+struct FrameUniforms
+{
+  size_t id = 0;
+
+  vm::mat4x4f viewMatrix;
+  vm::vec3f cameraPosition;
+  vm::vec3f cameraDirection;
+  vm::vec3f cameraRight;
+  vm::vec3f cameraUp;
+
+  bool showSoftMapBounds = false;
+  vm::vec3f softMapBoundsMin;
+  vm::vec3f softMapBoundsMax;
+
+  // not uploaded since the renderers use different alpha values
+  vm::vec3f softMapBoundsColor;
+
+  float brightness = 1.0f;
+  float gridAlpha = 1.0f;
+};
+
+FrameUniforms makeFrameUniforms(const Camera& camera, const vm::bbox3f& softMapBounds);
+
+} // namespace tb::render
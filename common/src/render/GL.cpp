@@ -141,4 +141,35 @@ std::string glGetEnumName(const GLenum enum_)
     return "Unknown OpenGL enum";
   }
 }
+
+bool glSupportsInstancing()
+{
+  return GLEW_VERSION_3_3 || (GLEW_ARB_instanced_arrays && GLEW_ARB_draw_instanced);
+}
+
+void glSetVertexAttribDivisor(const GLuint index, const GLuint divisor)
+{
+  if (GLEW_VERSION_3_3)
+  {
+    glAssert(glVertexAttribDivisor(index, divisor));
+  }
+  else
+  {
+    glAssert(glVertexAttribDivisorARB(index, divisor));
+  }
+}
+
+void glDrawArraysInstances(
+  const GLenum mode, const GLint first, const GLsizei count, const GLsizei instanceCount)
+{
+  if (GLEW_VERSION_3_3)
+  {
+    glAssert(glDrawArraysInstanced(mode, first, count, instanceCount));
+  }
+  else
+  {
+    glAssert(glDrawArraysInstancedARB(mode, first, count, instanceCount));
+  }
+}
+
 } // namespace tb
@@ -36,6 +36,25 @@ std::string glGetErrorMessage(GLenum code);
 GLenum glGetEnum(const std::string& name);
 std::string glGetEnumName(GLenum _enum);
 
+/**
+ * Returns true if the current context supports instanced rendering with per instance
+ * vertex attributes, either through OpenGL 3.3 or through the ARB_instanced_arrays and
+ * ARB_draw_instanced extensions.
+ */
+bool glSupportsInstancing();
+
+/**
+ * Sets the divisor of the given generic vertex attribute. Must only be called if
+ * glSupportsInstancing() returns true.
+ */
+void glSetVertexAttribDivisor(GLuint index, GLuint divisor);
+
+/**
+ * Draws the given number of instances of the given range of vertices. Must only be called
+ * if glSupportsInstancing() returns true.
+ */
+void glDrawArraysInstances(GLenum mode, GLint first, GLsizei count, GLsizei instanceCount);
+
 // #define GL_DEBUG 1
 // #define GL_LOG 1
 
@@ -181,6 +181,27 @@ void IndexRangeMap::render(VertexArray& vertexArray) const
   }
 }
 
+size_t IndexRangeMap::renderInstances(
+  VertexArray& vertexArray, const size_t instanceCount) const
+{
+  auto drawCalls = size_t(0);
+  for (const auto& primType : PrimTypeValues)
+  {
+    const auto& indicesAndCounts = m_data->get(primType);
+    if (!indicesAndCounts.empty())
+    {
+      const auto primCount = static_cast<GLsizei>(indicesAndCounts.size());
+      drawCalls += vertexArray.renderInstances(
+        primType,
+        indicesAndCounts.indices,
+        indicesAndCounts.counts,
+        primCount,
+        static_cast<GLsizei>(instanceCount));
+    }
+  }
+  return drawCalls;
+}
+
 void IndexRangeMap::forEachPrimitive(
   std::function<void(PrimType, size_t, size_t)> func) const
 {
@@ -56,6 +56,13 @@ namespace tb::render
 namespace
 {
 
+/**
+ * The edge length of the cells that the unselected and locked brushes are partitioned
+ * into. Editing a brush re-uploads the vertices and indices of its cell, and cells
+ * outside of the view frustum are skipped.
+ */
+constexpr auto BrushChunkSize = 1024.0;
+
 class SelectedBrushRendererFilter : public BrushRenderer::DefaultFilter
 {
 public:
@@ -357,6 +364,7 @@ void MapRenderer::setupDefaultRenderer(ObjectRenderer& renderer)
 
   renderer.setBrushFaceColor(pref(Preferences::FaceColor));
   renderer.setBrushEdgeColor(pref(Preferences::EdgeColor));
+  renderer.setBrushChunkSize(BrushChunkSize);
 }
 
 void MapRenderer::setupSelectionRenderer(ObjectRenderer& renderer)
@@ -403,6 +411,7 @@ void MapRenderer::setupLockedRenderer(ObjectRenderer& renderer)
 
   renderer.setBrushFaceColor(pref(Preferences::FaceColor));
   renderer.setBrushEdgeColor(pref(Preferences::LockedEdgeColor));
+  renderer.setBrushChunkSize(BrushChunkSize);
 }
 
 static bool selected(const mdl::Node* node)
@@ -140,6 +140,19 @@ void MaterialIndexRangeMap::render(VertexArray& vertexArray, MaterialRenderFunc&
   }
 }
 
+size_t MaterialIndexRangeMap::renderInstances(
+  VertexArray& vertexArray, MaterialRenderFunc& func, const size_t instanceCount)
+{
+  auto drawCalls = size_t(0);
+  for (const auto& [material, indexArray] : *m_data)
+  {
+    func.before(material);
+    drawCalls += indexArray.renderInstances(vertexArray, instanceCount);
+    func.after(material);
+  }
+  return drawCalls;
+}
+
 void MaterialIndexRangeMap::forEachPrimitive(
   std::function<void(const Material*, PrimType, size_t, size_t)> func) const
 {
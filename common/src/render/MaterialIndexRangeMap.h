@@ -175,6 +175,19 @@ public:
    */
   void render(VertexArray& vertexArray, MaterialRenderFunc& func);
 
+  /**
+   * Renders the given number of instances of the primitives stored in this index range
+   * map using the vertices in the given vertex array, calling the given render function
+   * around each material as described above.
+   *
+   * @param vertexArray the vertex array to render with
+   * @param func the render function to use
+   * @param instanceCount the number of instances to render
+   * @return the number of draw calls issued
+   */
+  size_t renderInstances(
+    VertexArray& vertexArray, MaterialRenderFunc& func, size_t instanceCount);
+
   /**
    * Invokes the given function for each primitive stored in this map.
    *
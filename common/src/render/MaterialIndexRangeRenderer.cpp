@@ -63,6 +63,18 @@ void MaterialIndexRangeRenderer::render(MaterialRenderFunc& func)
   }
 }
 
+size_t MaterialIndexRangeRenderer::renderInstances(
+  MaterialRenderFunc& func, const size_t instanceCount)
+{
+  auto drawCalls = size_t(0);
+  if (m_vertexArray.setup())
+  {
+    drawCalls = m_indexRange.renderInstances(m_vertexArray, func, instanceCount);
+    m_vertexArray.cleanup();
+  }
+  return drawCalls;
+}
+
 MultiMaterialIndexRangeRenderer::MultiMaterialIndexRangeRenderer(
   std::vector<std::unique_ptr<MaterialIndexRangeRenderer>> renderers)
   : m_renderers{std::move(renderers)}
@@ -99,4 +111,15 @@ void MultiMaterialIndexRangeRenderer::render(MaterialRenderFunc& func)
   }
 }
 
+size_t MultiMaterialIndexRangeRenderer::renderInstances(
+  MaterialRenderFunc& func, const size_t instanceCount)
+{
+  auto drawCalls = size_t(0);
+  for (auto& renderer : m_renderers)
+  {
+    drawCalls += renderer->renderInstances(func, instanceCount);
+  }
+  return drawCalls;
+}
+
 } // namespace tb::render
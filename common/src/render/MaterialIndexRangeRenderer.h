@@ -44,6 +44,14 @@ public:
 
   virtual void prepare(VboManager& vboManager) = 0;
   virtual void render(MaterialRenderFunc& func) = 0;
+
+  /**
+   * Renders the given number of instances. The per-instance data must have been set up by
+   * the caller.
+   *
+   * @return the number of draw calls issued
+   */
+  virtual size_t renderInstances(MaterialRenderFunc& func, size_t instanceCount) = 0;
 };
 
 class MaterialIndexRangeRenderer : public MaterialRenderer
@@ -63,6 +71,7 @@ public:
 
   void prepare(VboManager& vboManager) override;
   void render(MaterialRenderFunc& func) override;
+  size_t renderInstances(MaterialRenderFunc& func, size_t instanceCount) override;
 };
 
 class MultiMaterialIndexRangeRenderer : public MaterialRenderer
@@ -79,6 +88,7 @@ public:
 
   void prepare(VboManager& vboManager) override;
   void render(MaterialRenderFunc& func) override;
+  size_t renderInstances(MaterialRenderFunc& func, size_t instanceCount) override;
 };
 
 } // namespace tb::render
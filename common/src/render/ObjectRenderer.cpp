@@ -189,6 +189,11 @@ void ObjectRenderer::setShowBrushEdges(const bool showBrushEdges)
   m_patchRenderer.setShowEdges(showBrushEdges);
 }
 
+void ObjectRenderer::setBrushChunkSize(const double brushChunkSize)
+{
+  m_brushRenderer.setChunkSize(brushChunkSize);
+}
+
 void ObjectRenderer::setBrushFaceColor(const Color& brushFaceColor)
 {
   m_brushRenderer.setFaceColor(brushFaceColor);
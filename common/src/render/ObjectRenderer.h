@@ -106,6 +106,7 @@ public: // configuration
   void setEntityBoundsColor(const Color& color);
 
   void setShowBrushEdges(bool showBrushEdges);
+  void setBrushChunkSize(double brushChunkSize);
   void setBrushFaceColor(const Color& brushFaceColor);
   void setBrushEdgeColor(const Color& brushEdgeColor);
 
@@ -19,8 +19,6 @@
 
 #include "PatchRenderer.h"
 
-#include "PreferenceManager.h"
-#include "Preferences.h"
 #include "mdl/EditorContext.h"
 #include "mdl/Material.h"
 #include "mdl/PatchNode.h"
@@ -35,12 +33,16 @@
 #include "render/RenderContext.h"
 #include "render/RenderUtils.h"
 #include "render/Shaders.h"
+#include "render/Uniforms.h"
 #include "render/VertexArray.h"
 
 #include "kdl/vector_utils.h"
 
+#include "vm/bbox.h"
 #include "vm/vec.h"
 
+#include <map>
+
 namespace tb::render
 {
 
@@ -141,14 +143,48 @@ void PatchRenderer::render(RenderContext& renderContext, RenderBatch& renderBatc
 
   if (renderContext.showEdges())
   {
-    if (m_showOccludedEdges)
+    for (auto& chunk : m_chunks)
     {
-      m_edgeRenderer.renderOnTop(renderBatch, m_occludedEdgeColor);
+      if (renderContext.camera().intersectsFrustum(chunk.bounds))
+      {
+        if (m_showOccludedEdges)
+        {
+          chunk.edgeRenderer.renderOnTop(renderBatch, m_occludedEdgeColor);
+        }
+        chunk.edgeRenderer.render(renderBatch, m_edgeColor);
+      }
     }
-    m_edgeRenderer.render(renderBatch, m_edgeColor);
   }
 }
 
+namespace
+{
+
+/**
+ * The edge length of the cubic cells that patches are grouped into.
+ */
+constexpr auto ChunkSize = 1024.0;
+
+std::vector<std::vector<const mdl::PatchNode*>> groupIntoChunks(
+  const std::vector<const mdl::PatchNode*>& patchNodes,
+  const mdl::EditorContext& editorContext)
+{
+  auto chunks = std::map<vm::vec3d, std::vector<const mdl::PatchNode*>>{};
+  for (const auto* patchNode : patchNodes)
+  {
+    if (editorContext.visible(patchNode))
+    {
+      const auto cell = vm::floor(patchNode->logicalBounds().center() / ChunkSize);
+      chunks[cell].push_back(patchNode);
+    }
+  }
+
+  return kdl::vec_transform(
+    std::move(chunks), [](auto&& entry) { return std::move(entry.second); });
+}
+
+} // namespace
+
 static MaterialIndexArrayRenderer buildMeshRenderer(
   const std::vector<const mdl::PatchNode*>& patchNodes,
   const mdl::EditorContext& editorContext)
@@ -300,8 +336,22 @@ void PatchRenderer::validate()
 {
   if (!m_valid)
   {
-    m_patchMeshRenderer = buildMeshRenderer(m_patchNodes.get_data(), m_editorContext);
-    m_edgeRenderer = buildEdgeRenderer(m_patchNodes.get_data(), m_editorContext);
+    m_chunks.clear();
+    for (const auto& patchNodes :
+         groupIntoChunks(m_patchNodes.get_data(), m_editorContext))
+    {
+      auto builder = vm::bbox3d::builder{};
+      builder.add(patchNodes.begin(), patchNodes.end(), [](const auto* patchNode) {
+        return patchNode->logicalBounds();
+      });
+
+      m_chunks.push_back(Chunk{
+        patchNodes.size(),
+        vm::bbox3f{builder.bounds()},
+        buildMeshRenderer(patchNodes, m_editorContext),
+        buildEdgeRenderer(patchNodes, m_editorContext),
+      });
+    }
 
     m_valid = true;
   }
@@ -309,7 +359,10 @@ void PatchRenderer::validate()
 
 void PatchRenderer::prepareVerticesAndIndices(VboManager& vboManager)
 {
-  m_patchMeshRenderer.prepare(vboManager);
+  for (auto& chunk : m_chunks)
+  {
+    chunk.meshRenderer.prepare(vboManager);
+  }
 }
 
 namespace
@@ -338,17 +391,17 @@ struct RenderFunc : public MaterialRenderFunc
 
   void before(const mdl::Material* material) override
   {
-    shader.set("GridColor", gridColorForMaterial(material));
+    shader.set(Uniforms::GridColor, gridColorForMaterial(material));
     if (const auto* texture = getTexture(material))
     {
       material->activate(minFilter, magFilter);
-      shader.set("ApplyMaterial", applyMaterial);
-      shader.set("Color", texture->averageColor());
+      shader.set(Uniforms::ApplyMaterial, applyMaterial);
+      shader.set(Uniforms::Color, texture->averageColor());
     }
     else
     {
-      shader.set("ApplyMaterial", false);
-      shader.set("Color", defaultColor);
+      shader.set(Uniforms::ApplyMaterial, false);
+      shader.set(Uniforms::Color, defaultColor);
     }
   }
 
@@ -366,7 +419,7 @@ void PatchRenderer::doRender(RenderContext& context)
 {
   auto& shaderManager = context.shaderManager();
   auto shader = ActiveShader{shaderManager, Shaders::FaceShader};
-  auto& prefs = PreferenceManager::instance();
+  const auto& frameUniforms = context.frameUniforms();
 
   const bool applyMaterial = context.showMaterials();
   const bool shadeFaces = context.shadeFaces();
@@ -374,33 +427,23 @@ void PatchRenderer::doRender(RenderContext& context)
 
   glAssert(glEnable(GL_TEXTURE_2D));
   glAssert(glActiveTexture(GL_TEXTURE0));
-  shader.set("Brightness", prefs.get(Preferences::Brightness));
-  shader.set("RenderGrid", context.showGrid());
-  shader.set("GridSize", static_cast<float>(context.gridSize()));
-  shader.set("GridAlpha", prefs.get(Preferences::GridAlpha));
-  shader.set("ApplyMaterial", applyMaterial);
-  shader.set("Material", 0);
-  shader.set("ApplyTinting", m_tint);
+  shader.applyFrameUniforms(frameUniforms);
+  shader.set(Uniforms::RenderGrid, context.showGrid());
+  shader.set(Uniforms::GridSize, static_cast<float>(context.gridSize()));
+  shader.set(Uniforms::ApplyMaterial, applyMaterial);
+  shader.set(Uniforms::Material, 0);
+  shader.set(Uniforms::ApplyTinting, m_tint);
   if (m_tint)
   {
-    shader.set("TintColor", m_tintColor);
+    shader.set(Uniforms::TintColor, m_tintColor);
   }
-  shader.set("GrayScale", m_grayscale);
-  shader.set("CameraPosition", context.camera().position());
-  shader.set("ShadeFaces", shadeFaces);
-  shader.set("ShowFog", showFog);
-  shader.set("Alpha", 1.0);
-  shader.set("EnableMasked", false);
-  shader.set("ShowSoftMapBounds", !context.softMapBounds().is_empty());
-  shader.set("SoftMapBoundsMin", context.softMapBounds().min);
-  shader.set("SoftMapBoundsMax", context.softMapBounds().max);
+  shader.set(Uniforms::GrayScale, m_grayscale);
+  shader.set(Uniforms::ShadeFaces, shadeFaces);
+  shader.set(Uniforms::ShowFog, showFog);
+  shader.set(Uniforms::Alpha, 1.0f);
+  shader.set(Uniforms::EnableMasked, false);
   shader.set(
-    "SoftMapBoundsColor",
-    vm::vec4f{
-      prefs.get(Preferences::SoftMapBoundsColor).r(),
-      prefs.get(Preferences::SoftMapBoundsColor).g(),
-      prefs.get(Preferences::SoftMapBoundsColor).b(),
-      0.1f});
+    Uniforms::SoftMapBoundsColor, vm::vec4f{frameUniforms.softMapBoundsColor, 0.1f});
 
   auto func = RenderFunc{
     shader,
@@ -415,7 +458,13 @@ void PatchRenderer::doRender(RenderContext& context)
   }
   */
 
-  m_patchMeshRenderer.render(func);
+  for (auto& chunk : m_chunks)
+  {
+    if (context.intersectsFrustum(chunk.bounds, chunk.patchCount))
+    {
+      chunk.meshRenderer.render(func);
+    }
+  }
 
   /*
   if (m_alpha < 1.0f) {
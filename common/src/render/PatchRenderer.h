@@ -26,6 +26,10 @@
 
 #include "kdl/vector_set.h"
 
+#include "vm/bbox.h"
+
+#include <vector>
+
 namespace tb::mdl
 {
 class EditorContext;
@@ -43,11 +47,22 @@ class PatchRenderer : public IndexedRenderable
 private:
   const mdl::EditorContext& m_editorContext;
 
+  /**
+   * The patches are grouped into chunks according to their position so that chunks
+   * which are outside of the view frustum can be skipped when rendering.
+   */
+  struct Chunk
+  {
+    size_t patchCount = 0;
+    vm::bbox3f bounds;
+    MaterialIndexArrayRenderer meshRenderer;
+    DirectEdgeRenderer edgeRenderer;
+  };
+
   bool m_valid = true;
   kdl::vector_set<const mdl::PatchNode*> m_patchNodes;
 
-  MaterialIndexArrayRenderer m_patchMeshRenderer;
-  DirectEdgeRenderer m_edgeRenderer;
+  std::vector<Chunk> m_chunks;
 
   Color m_defaultColor;
   bool m_grayscale = false;
@@ -231,6 +231,16 @@ const vm::bbox3f& RenderContext::softMapBounds() const
 void RenderContext::setSoftMapBounds(const vm::bbox3f& softMapBounds)
 {
   m_softMapBounds = softMapBounds;
+  m_frameUniforms = std::nullopt;
+}
+
+const FrameUniforms& RenderContext::frameUniforms()
+{
+  if (!m_frameUniforms)
+  {
+    m_frameUniforms = makeFrameUniforms(m_camera, m_softMapBounds);
+  }
+  return *m_frameUniforms;
 }
 
 bool RenderContext::hideSelection() const
@@ -279,6 +289,34 @@ void RenderContext::setForceHideSelectionGuide()
   setShowSelectionGuide(ShowSelectionGuide::ForceHide);
 }
 
+bool RenderContext::intersectsFrustum(const vm::bbox3f& bounds, const size_t primitiveCount)
+{
+  if (m_camera.intersectsFrustum(bounds))
+  {
+    m_cullingStats.drawn += primitiveCount;
+    return true;
+  }
+
+  m_cullingStats.culled += primitiveCount;
+  return false;
+}
+
+const CullingStats& RenderContext::cullingStats() const
+{
+  return m_cullingStats;
+}
+
+void RenderContext::countEntityModelDraws(const size_t drawCalls, const size_t instances)
+{
+  m_entityModelStats.drawCalls += drawCalls;
+  m_entityModelStats.instances += instances;
+}
+
+const EntityModelStats& RenderContext::entityModelStats() const
+{
+  return m_entityModelStats;
+}
+
 void RenderContext::setShowSelectionGuide(const ShowSelectionGuide showSelectionGuide)
 {
   switch (showSelectionGuide)
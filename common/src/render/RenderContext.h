@@ -21,10 +21,15 @@
 
 #include "GL.h"
 #include "Macros.h"
+#include "render/CullingStats.h"
+#include "render/EntityModelStats.h"
+#include "render/FrameUniforms.h"
 #include "render/Transformation.h"
 
 #include "vm/bbox.h"
 
+#include <optional>
+
 namespace tb::render
 {
 class Camera;
@@ -83,6 +88,10 @@ private:
 
   ShowSelectionGuide m_showSelectionGuide = ShowSelectionGuide::Hide;
   vm::bbox3f m_softMapBounds;
+  std::optional<FrameUniforms> m_frameUniforms;
+
+  CullingStats m_cullingStats;
+  EntityModelStats m_entityModelStats;
 
 public:
   RenderContext(
@@ -144,6 +153,12 @@ public:
   const vm::bbox3f& softMapBounds() const;
   void setSoftMapBounds(const vm::bbox3f& softMapBounds);
 
+  /**
+   * Returns the uniforms shared by all shaders in this frame. They are created on the
+   * first call and recreated if the soft map bounds change.
+   */
+  const FrameUniforms& frameUniforms();
+
   double gridSize() const;
   void setGridSize(double gridSize);
 
@@ -162,6 +177,22 @@ public:
   void setForceShowSelectionGuide();
   void setForceHideSelectionGuide();
 
+  /**
+   * Checks whether the given bounds intersect the camera's view frustum and records the
+   * given number of primitives as either drawn or culled.
+   *
+   * Returns true if the primitives within the given bounds should be drawn.
+   */
+  bool intersectsFrustum(const vm::bbox3f& bounds, size_t primitiveCount = 1);
+  const CullingStats& cullingStats() const;
+
+  /**
+   * Records the given number of draw calls issued to render the given number of entity
+   * models.
+   */
+  void countEntityModelDraws(size_t drawCalls, size_t instances);
+  const EntityModelStats& entityModelStats() const;
+
 private:
   void setShowSelectionGuide(ShowSelectionGuide showSelectionGuide);
 };
@@ -20,8 +20,10 @@
 #include "ShaderProgram.h"
 
 #include "Ensure.h"
+#include "render/FrameUniforms.h"
 #include "render/Shader.h"
 #include "render/ShaderManager.h"
+#include "render/Uniforms.h"
 
 #include "kdl/result.h"
 
@@ -40,6 +42,8 @@ ShaderProgram::ShaderProgram(std::string name, const GLuint programId)
 ShaderProgram::ShaderProgram(ShaderProgram&& other) noexcept
   : m_name{std::move(other.m_name)}
   , m_programId{std::exchange(other.m_programId, 0)}
+  , m_uniformLocations{std::move(other.m_uniformLocations)}
+  , m_frameUniformsId{other.m_frameUniformsId}
 {
 }
 
@@ -47,6 +51,8 @@ ShaderProgram& ShaderProgram::operator=(ShaderProgram&& other) noexcept
 {
   m_name = std::move(other.m_name);
   m_programId = std::exchange(other.m_programId, 0);
+  m_uniformLocations = std::move(other.m_uniformLocations);
+  m_frameUniformsId = other.m_frameUniformsId;
   return *this;
 }
 
@@ -99,6 +105,7 @@ Result<void> ShaderProgram::link()
       "Could not link shader program '" + m_name + "': " + getInfoLog(m_programId)};
   }
 
+  resolveUniforms();
   return kdl::void_success;
 }
 
@@ -121,25 +128,26 @@ void ShaderProgram::deactivate(ShaderManager& shaderManager)
 
 void ShaderProgram::set(const std::string& name, const bool value)
 {
-  return set(name, int(value));
+  assert(checkActive());
+  setUniform(findUniformLocation(name), value);
 }
 
 void ShaderProgram::set(const std::string& name, const int value)
 {
   assert(checkActive());
-  glAssert(glUniform1i(findUniformLocation(name), value));
+  setUniform(findUniformLocation(name), value);
 }
 
 void ShaderProgram::set(const std::string& name, const size_t value)
 {
   assert(checkActive());
-  glAssert(glUniform1i(findUniformLocation(name), int(value)));
+  setUniform(findUniformLocation(name), int(value));
 }
 
 void ShaderProgram::set(const std::string& name, const float value)
 {
   assert(checkActive());
-  glAssert(glUniform1f(findUniformLocation(name), value));
+  setUniform(findUniformLocation(name), value);
 }
 
 void ShaderProgram::set(const std::string& name, const double value)
@@ -151,41 +159,58 @@ void ShaderProgram::set(const std::string& name, const double value)
 void ShaderProgram::set(const std::string& name, const vm::vec2f& value)
 {
   assert(checkActive());
-  glAssert(glUniform2f(findUniformLocation(name), value.x(), value.y()));
+  setUniform(findUniformLocation(name), value);
 }
 
 void ShaderProgram::set(const std::string& name, const vm::vec3f& value)
 {
   assert(checkActive());
-  glAssert(glUniform3f(findUniformLocation(name), value.x(), value.y(), value.z()));
+  setUniform(findUniformLocation(name), value);
 }
 
 void ShaderProgram::set(const std::string& name, const vm::vec4f& value)
 {
   assert(checkActive());
-  glAssert(
-    glUniform4f(findUniformLocation(name), value.x(), value.y(), value.z(), value.w()));
+  setUniform(findUniformLocation(name), value);
 }
 
 void ShaderProgram::set(const std::string& name, const vm::mat2x2f& value)
 {
   assert(checkActive());
-  glAssert(glUniformMatrix2fv(
-    findUniformLocation(name), 1, false, reinterpret_cast<const float*>(value.v)));
+  setUniform(findUniformLocation(name), value);
 }
 
 void ShaderProgram::set(const std::string& name, const vm::mat3x3f& value)
 {
   assert(checkActive());
-  glAssert(glUniformMatrix3fv(
-    findUniformLocation(name), 1, false, reinterpret_cast<const float*>(value.v)));
+  setUniform(findUniformLocation(name), value);
 }
 
 void ShaderProgram::set(const std::string& name, const vm::mat4x4f& value)
 {
   assert(checkActive());
-  glAssert(glUniformMatrix4fv(
-    findUniformLocation(name), 1, false, reinterpret_cast<const float*>(value.v)));
+  setUniform(findUniformLocation(name), value);
+}
+
+void ShaderProgram::applyFrameUniforms(const FrameUniforms& frameUniforms)
+{
+  if (m_frameUniformsId == frameUniforms.id)
+  {
+    return;
+  }
+
+  set(Uniforms::ViewMatrix, frameUniforms.viewMatrix);
+  set(Uniforms::CameraPosition, frameUniforms.cameraPosition);
+  set(Uniforms::CameraDirection, frameUniforms.cameraDirection);
+  set(Uniforms::CameraRight, frameUniforms.cameraRight);
+  set(Uniforms::CameraUp, frameUniforms.cameraUp);
+  set(Uniforms::ShowSoftMapBounds, frameUniforms.showSoftMapBounds);
+  set(Uniforms::SoftMapBoundsMin, frameUniforms.softMapBoundsMin);
+  set(Uniforms::SoftMapBoundsMax, frameUniforms.softMapBoundsMax);
+  set(Uniforms::Brightness, frameUniforms.brightness);
+  set(Uniforms::GridAlpha, frameUniforms.gridAlpha);
+
+  m_frameUniformsId = frameUniforms.id;
 }
 
 GLint ShaderProgram::findAttributeLocation(const std::string& name) const
@@ -205,8 +230,11 @@ GLint ShaderProgram::findAttributeLocation(const std::string& name) const
   return it->second;
 }
 
-GLint ShaderProgram::findUniformLocation(const std::string& name) const
+GLint ShaderProgram::findUniformLocation(const std::string& name)
 {
+  // the caller may overwrite one of the frame uniforms
+  m_frameUniformsId = 0;
+
   auto it = m_variableCache.find(name);
   if (it == std::end(m_variableCache))
   {
@@ -222,6 +250,71 @@ GLint ShaderProgram::findUniformLocation(const std::string& name) const
   return it->second;
 }
 
+void ShaderProgram::resolveUniforms()
+{
+  const auto& uniforms = registeredUniforms();
+
+  m_uniformLocations.clear();
+  m_uniformLocations.reserve(uniforms.size());
+  for (const auto& name : uniforms)
+  {
+    auto location = GLint(-1);
+    glAssert(location = glGetUniformLocation(m_programId, name.c_str()));
+    m_uniformLocations.push_back(location);
+  }
+
+  // force the frame uniforms to be uploaded again
+  m_frameUniformsId = 0;
+}
+
+void ShaderProgram::setUniform(const GLint location, const bool value)
+{
+  setUniform(location, int(value));
+}
+
+void ShaderProgram::setUniform(const GLint location, const int value)
+{
+  glAssert(glUniform1i(location, value));
+}
+
+void ShaderProgram::setUniform(const GLint location, const float value)
+{
+  glAssert(glUniform1f(location, value));
+}
+
+void ShaderProgram::setUniform(const GLint location, const vm::vec2f& value)
+{
+  glAssert(glUniform2f(location, value.x(), value.y()));
+}
+
+void ShaderProgram::setUniform(const GLint location, const vm::vec3f& value)
+{
+  glAssert(glUniform3f(location, value.x(), value.y(), value.z()));
+}
+
+void ShaderProgram::setUniform(const GLint location, const vm::vec4f& value)
+{
+  glAssert(glUniform4f(location, value.x(), value.y(), value.z(), value.w()));
+}
+
+void ShaderProgram::setUniform(const GLint location, const vm::mat2x2f& value)
+{
+  glAssert(
+    glUniformMatrix2fv(location, 1, false, reinterpret_cast<const float*>(value.v)));
+}
+
+void ShaderProgram::setUniform(const GLint location, const vm::mat3x3f& value)
+{
+  glAssert(
+    glUniformMatrix3fv(location, 1, false, reinterpret_cast<const float*>(value.v)));
+}
+
+void ShaderProgram::setUniform(const GLint location, const vm::mat4x4f& value)
+{
+  glAssert(
+    glUniformMatrix4fv(location, 1, false, reinterpret_cast<const float*>(value.v)));
+}
+
 bool ShaderProgram::checkActive() const
 {
   auto currentProgramId = GLint(-1);
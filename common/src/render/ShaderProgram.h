@@ -22,18 +22,23 @@
 #include "Macros.h"
 #include "Result.h"
 #include "render/GL.h"
+#include "render/Uniform.h"
 
 #include "vm/mat.h"
 #include "vm/vec.h"
 
+#include <cassert>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 namespace tb::render
 {
 
 class ShaderManager;
 class Shader;
+struct FrameUniforms;
 
 class ShaderProgram
 {
@@ -48,6 +53,10 @@ private:
   mutable UniformVariableCache m_variableCache;
   mutable AttributeLocationCache m_attributeCache;
 
+  // the locations of all registered uniforms indexed by their IDs, -1 if unused
+  std::vector<GLint> m_uniformLocations;
+  size_t m_frameUniformsId = 0;
+
 public:
   ShaderProgram(std::string name, GLuint programId);
 
@@ -76,10 +85,43 @@ public:
   void set(const std::string& name, const vm::mat3x3f& value);
   void set(const std::string& name, const vm::mat4x4f& value);
 
+  /**
+   * Sets the value of the given uniform. Does nothing if this program does not use the
+   * uniform.
+   */
+  template <typename T>
+  void set(const Uniform<T>& uniform, const std::type_identity_t<T>& value)
+  {
+    assert(checkActive());
+    assert(uniform.id() < m_uniformLocations.size());
+
+    if (const auto location = m_uniformLocations[uniform.id()]; location != -1)
+    {
+      setUniform(location, value);
+    }
+  }
+
+  /**
+   * Uploads the given frame uniforms unless this program has already received them.
+   */
+  void applyFrameUniforms(const FrameUniforms& frameUniforms);
+
   GLint findAttributeLocation(const std::string& name) const;
 
 private:
-  GLint findUniformLocation(const std::string& name) const;
+  void resolveUniforms();
+
+  void setUniform(GLint location, bool value);
+  void setUniform(GLint location, int value);
+  void setUniform(GLint location, float value);
+  void setUniform(GLint location, const vm::vec2f& value);
+  void setUniform(GLint location, const vm::vec3f& value);
+  void setUniform(GLint location, const vm::vec4f& value);
+  void setUniform(GLint location, const vm::mat2x2f& value);
+  void setUniform(GLint location, const vm::mat3x3f& value);
+  void setUniform(GLint location, const vm::mat4x4f& value);
+
+  GLint findUniformLocation(const std::string& name);
   bool checkActive() const;
 };
 
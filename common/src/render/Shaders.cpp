@@ -48,7 +48,13 @@ const ShaderConfig MiniMapEdgeShader = ShaderConfig{
 
 const ShaderConfig EntityModelShader = ShaderConfig{
   "Entity Model",
-  {"EntityModel.vertsh"},
+  {"EntityModel.vertsh", "EntityModelOrientation.vertsh"},
+  {"MapBounds.fragsh", "EntityModel.fragsh"},
+};
+
+const ShaderConfig EntityModelInstancedShader = ShaderConfig{
+  "Entity Model Instanced",
+  {"EntityModelInstanced.vertsh", "EntityModelOrientation.vertsh"},
   {"MapBounds.fragsh", "EntityModel.fragsh"},
 };
 
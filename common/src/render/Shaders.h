@@ -29,6 +29,7 @@ extern const ShaderConfig VaryingPCShader;
 extern const ShaderConfig VaryingPUniformCShader;
 extern const ShaderConfig MiniMapEdgeShader;
 extern const ShaderConfig EntityModelShader;
+extern const ShaderConfig EntityModelInstancedShader;
 extern const ShaderConfig FaceShader;
 extern const ShaderConfig PatchShader;
 extern const ShaderConfig EdgeShader;
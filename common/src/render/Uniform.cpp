@@ -0,0 +1,48 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Uniform.h"
+
+namespace tb::render
+{
+namespace
+{
+
+std::vector<std::string>& uniformRegistry()
+{
+  // function local so that it is initialized before the first handle is registered
+  static auto registry = std::vector<std::string>{};
+  return registry;
+}
+
+} // namespace
+
+size_t registerUniform(std::string name)
+{
+  auto& registry = uniformRegistry();
+  registry.push_back(std::move(name));
+  return registry.size() - 1;
+}
+
+const std::vector<std::string>& registeredUniforms()
+{
+  return uniformRegistry();
+}
+
+} // namespace tb::render
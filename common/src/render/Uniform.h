@@ -0,0 +1,66 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace tb::render
+{
+
+/**
+ * Registers a uniform variable name and returns its unique ID. The IDs are consecutive
+ * and start at 0.
+ */
+size_t registerUniform(std::string name);
+
+/**
+ * Returns the names of all registered uniform variables, indexed by their IDs.
+ */
+const std::vector<std::string>& registeredUniforms();
+
+/**
+ * A typed handle to a uniform variable.
+ *
+ * Handles are meant to be created once at static initialization time, see Uniforms.h.
+ * Every shader program resolves the locations of all registered uniforms when it is
+ * linked, so setting a uniform by its handle does not need to look up the variable by
+ * its name. Uniforms that are not used by a program are silently ignored when they are
+ * set on that program.
+ *
+ * @tparam T the type of the uniform's value
+ */
+template <typename T>
+class Uniform
+{
+private:
+  size_t m_id;
+
+public:
+  explicit Uniform(std::string name)
+    : m_id{registerUniform(std::move(name))}
+  {
+  }
+
+  size_t id() const { return m_id; }
+  const std::string& name() const { return registeredUniforms()[m_id]; }
+};
+
+} // namespace tb::render
@@ -0,0 +1,54 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Uniforms.h"
+
+namespace tb::render::Uniforms
+{
+
+const Uniform<float> Alpha = Uniform<float>{"Alpha"};
+const Uniform<bool> ApplyMaterial = Uniform<bool>{"ApplyMaterial"};
+const Uniform<bool> ApplyTinting = Uniform<bool>{"ApplyTinting"};
+const Uniform<float> Brightness = Uniform<float>{"Brightness"};
+const Uniform<vm::vec3f> CameraDirection = Uniform<vm::vec3f>{"CameraDirection"};
+const Uniform<vm::vec3f> CameraPosition = Uniform<vm::vec3f>{"CameraPosition"};
+const Uniform<vm::vec3f> CameraRight = Uniform<vm::vec3f>{"CameraRight"};
+const Uniform<vm::vec3f> CameraUp = Uniform<vm::vec3f>{"CameraUp"};
+const Uniform<vm::vec4f> Color = Uniform<vm::vec4f>{"Color"};
+const Uniform<bool> EnableMasked = Uniform<bool>{"EnableMasked"};
+const Uniform<bool> GrayScale = Uniform<bool>{"GrayScale"};
+const Uniform<float> GridAlpha = Uniform<float>{"GridAlpha"};
+const Uniform<vm::vec3f> GridColor = Uniform<vm::vec3f>{"GridColor"};
+const Uniform<float> GridSize = Uniform<float>{"GridSize"};
+const Uniform<int> Material = Uniform<int>{"Material"};
+const Uniform<vm::mat4x4f> ModelMatrix = Uniform<vm::mat4x4f>{"ModelMatrix"};
+const Uniform<int> Orientation = Uniform<int>{"Orientation"};
+const Uniform<bool> RenderGrid = Uniform<bool>{"RenderGrid"};
+const Uniform<bool> ShadeFaces = Uniform<bool>{"ShadeFaces"};
+const Uniform<bool> ShowFog = Uniform<bool>{"ShowFog"};
+const Uniform<bool> ShowSoftMapBounds = Uniform<bool>{"ShowSoftMapBounds"};
+const Uniform<vm::vec4f> SoftMapBoundsColor = Uniform<vm::vec4f>{"SoftMapBoundsColor"};
+const Uniform<vm::vec3f> SoftMapBoundsMax = Uniform<vm::vec3f>{"SoftMapBoundsMax"};
+const Uniform<vm::vec3f> SoftMapBoundsMin = Uniform<vm::vec3f>{"SoftMapBoundsMin"};
+const Uniform<vm::vec4f> TintColor = Uniform<vm::vec4f>{"TintColor"};
+const Uniform<bool> UseUniformColor = Uniform<bool>{"UseUniformColor"};
+const Uniform<bool> UseVertexColor = Uniform<bool>{"UseVertexColor"};
+const Uniform<vm::mat4x4f> ViewMatrix = Uniform<vm::mat4x4f>{"ViewMatrix"};
+
+} // namespace tb::render::Uniforms
@@ -0,0 +1,60 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "render/Uniform.h"
+
+#include "vm/mat.h"
+#include "vm/vec.h"
+
+// The uniform variables of the shaders that are set by their handles, see Uniform.h.
+namespace tb::render::Uniforms
+{
+
+extern const Uniform<float> Alpha;
+extern const Uniform<bool> ApplyMaterial;
+extern const Uniform<bool> ApplyTinting;
+extern const Uniform<float> Brightness;
+extern const Uniform<vm::vec3f> CameraDirection;
+extern const Uniform<vm::vec3f> CameraPosition;
+extern const Uniform<vm::vec3f> CameraRight;
+extern const Uniform<vm::vec3f> CameraUp;
+extern const Uniform<vm::vec4f> Color;
+extern const Uniform<bool> EnableMasked;
+extern const Uniform<bool> GrayScale;
+extern const Uniform<float> GridAlpha;
+extern const Uniform<vm::vec3f> GridColor;
+extern const Uniform<float> GridSize;
+extern const Uniform<int> Material;
+extern const Uniform<vm::mat4x4f> ModelMatrix;
+extern const Uniform<int> Orientation;
+extern const Uniform<bool> RenderGrid;
+extern const Uniform<bool> ShadeFaces;
+extern const Uniform<bool> ShowFog;
+extern const Uniform<bool> ShowSoftMapBounds;
+extern const Uniform<vm::vec4f> SoftMapBoundsColor;
+extern const Uniform<vm::vec3f> SoftMapBoundsMax;
+extern const Uniform<vm::vec3f> SoftMapBoundsMin;
+extern const Uniform<vm::vec4f> TintColor;
+extern const Uniform<bool> UseUniformColor;
+extern const Uniform<bool> UseVertexColor;
+extern const Uniform<vm::mat4x4f> ViewMatrix;
+
+} // namespace tb::render::Uniforms
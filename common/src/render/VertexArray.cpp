@@ -149,6 +149,46 @@ void VertexArray::render(
   }
 }
 
+size_t VertexArray::renderInstances(
+  const PrimType primType,
+  const GLIndices& indices,
+  const GLCounts& counts,
+  const GLint primCount,
+  const GLsizei instanceCount)
+{
+  assert(prepared());
+
+  const auto draw = [&]() -> size_t {
+    if (instanceCount == 1)
+    {
+      glAssert(
+        glMultiDrawArrays(toGL(primType), indices.data(), counts.data(), primCount));
+      return 1;
+    }
+
+    for (GLint i = 0; i < primCount; ++i)
+    {
+      const auto index = indices[size_t(i)];
+      const auto count = counts[size_t(i)];
+      glDrawArraysInstances(toGL(primType), index, count, instanceCount);
+    }
+    return size_t(primCount);
+  };
+
+  if (!m_setup)
+  {
+    if (setup())
+    {
+      const auto drawCalls = draw();
+      cleanup();
+      return drawCalls;
+    }
+    return 0;
+  }
+
+  return draw();
+}
+
 VertexArray::VertexArray(std::shared_ptr<BaseHolder> holder)
   : m_holder{std::move(holder)}
 {
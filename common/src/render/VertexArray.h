@@ -322,6 +322,28 @@ public:
    * @param count the number of vertices to render
    */
   void render(PrimType primType, const GLIndices& indices, GLsizei count);
+
+  /**
+   * Renders the given number of instances of the ranges of primitives of the given type
+   * whose start indices and lengths are given in the given arrays. The per-instance data
+   * must have been set up by the caller, see glSetVertexAttribDivisor.
+   *
+   * Since there is no instanced variant of glMultiDrawArrays, every range is drawn with
+   * its own draw call unless only a single instance is rendered.
+   *
+   * @param primType the primitive type to render
+   * @param indices the start indices of the ranges to render
+   * @param counts the lengths of the ranges to render
+   * @param primCount the number of ranges to render
+   * @param instanceCount the number of instances to render
+   * @return the number of draw calls issued
+   */
+  size_t renderInstances(
+    PrimType primType,
+    const GLIndices& indices,
+    const GLCounts& counts,
+    GLint primCount,
+    GLsizei instanceCount);
   void cleanup();
 
 private:
@@ -21,6 +21,7 @@
 
 #include "Ensure.h"
 #include "Macros.h"
+#include "mdl/ModelUtils.h"
 #include "mdl/Node.h"
 #include "ui/MapDocumentCommandFacade.h"
 
@@ -99,6 +100,25 @@ std::unique_ptr<CommandResult> AddRemoveNodesCommand::doPerformUndo(
   return std::make_unique<CommandResult>(true);
 }
 
+size_t AddRemoveNodesCommand::doGetMemorySize() const
+{
+  // only the nodes to add are owned by this command, the nodes to remove belong to the
+  // document
+  auto result = UpdateLinkedGroupsCommandBase::doGetMemorySize();
+  for (const auto& [parent, children] : m_nodesToAdd)
+  {
+    for (const auto* child : children)
+    {
+      result += sizeof(child) + mdl::estimateMemorySize(*child);
+    }
+  }
+  for (const auto& [parent, children] : m_nodesToRemove)
+  {
+    result += children.size() * sizeof(mdl::Node*);
+  }
+  return result;
+}
+
 void AddRemoveNodesCommand::doAction(MapDocumentCommandFacade& document)
 {
   switch (m_action)
@@ -65,6 +65,8 @@ private:
   std::unique_ptr<CommandResult> doPerformUndo(
     MapDocumentCommandFacade& document) override;
 
+  size_t doGetMemorySize() const override;
+
   void doAction(MapDocumentCommandFacade& document);
   void undoAction(MapDocumentCommandFacade& document);
 
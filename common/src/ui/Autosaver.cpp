@@ -37,6 +37,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <utility>
 
 namespace tb::ui
 {
@@ -143,7 +144,9 @@ Autosaver::Autosaver(
 
 void Autosaver::triggerAutosave(Logger& logger)
 {
-  if (!kdl::mem_expired(m_document))
+  reportFinishedSave(logger);
+
+  if (!kdl::mem_expired(m_document) && !m_writer.busy())
   {
     auto document = kdl::mem_lock(m_document);
     if (
@@ -175,15 +178,40 @@ void Autosaver::autosave(Logger& logger, std::shared_ptr<MapDocument> document)
                           return fs.makeAbsolute(makeBackupName(mapBasename, backupNo));
                         });
              });
-  }) | kdl::transform([&](const auto& backupFilePath) {
-    m_lastSaveTime = Clock::now();
-    m_lastModificationCount = document->modificationCount();
-    document->saveDocumentTo(backupFilePath);
-
-    logger.info() << "Created autosave backup at " << backupFilePath;
+  }) | kdl::transform([&](auto backupFilePath) {
+    m_pendingSave = PendingSave{Clock::now(), document->modificationCount()};
+    m_writer.write(std::move(backupFilePath), document->serializeDocument());
   }) | kdl::transform_error([&](auto e) {
     logger.error() << "Aborting autosave: " << e.msg;
   });
 }
 
+void Autosaver::finishPendingSave(Logger& logger)
+{
+  m_writer.wait();
+  reportFinishedSave(logger);
+}
+
+std::optional<io::BackgroundFileWriterProgress> Autosaver::pendingSaveProgress() const
+{
+  return m_writer.busy() ? std::optional{m_writer.progress()} : std::nullopt;
+}
+
+void Autosaver::reportFinishedSave(Logger& logger)
+{
+  if (auto result = m_writer.takeResult())
+  {
+    const auto pendingSave = std::exchange(m_pendingSave, std::nullopt);
+    assert(pendingSave);
+
+    std::move(*result) | kdl::transform([&](const auto& backupFilePath) {
+      m_lastSaveTime = pendingSave->time;
+      m_lastModificationCount = pendingSave->modificationCount;
+      logger.info() << "Created autosave backup at " << backupFilePath;
+    }) | kdl::transform_error([&](auto e) {
+      logger.error() << "Could not write autosave backup: " << e.msg;
+    });
+  }
+}
+
 } // namespace tb::ui
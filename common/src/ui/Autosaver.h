@@ -19,11 +19,13 @@
 
 #pragma once
 
+#include "io/BackgroundFileWriter.h"
 #include "io/PathMatcher.h"
 
 #include <chrono>
 #include <filesystem>
 #include <memory>
+#include <optional>
 
 namespace tb
 {
@@ -65,16 +67,50 @@ private:
    */
   size_t m_lastModificationCount;
 
+  /**
+   * The time and modification count at which the pending backup was serialized. They are
+   * recorded as the last save once the backup has been written successfully.
+   */
+  struct PendingSave
+  {
+    std::chrono::time_point<Clock> time;
+    size_t modificationCount;
+  };
+  std::optional<PendingSave> m_pendingSave;
+
+  /**
+   * Writes the backups on a background thread so that the user can continue editing
+   * while a backup is being written.
+   */
+  io::BackgroundFileWriter m_writer;
+
 public:
   explicit Autosaver(
     std::weak_ptr<MapDocument> document,
     std::chrono::milliseconds saveInterval = std::chrono::milliseconds(10 * 60 * 1000),
     size_t maxBackups = 50);
 
+  /**
+   * Creates a new backup if the document was modified and the save interval has passed.
+   * The document is serialized immediately, but the backup is written on a background
+   * thread. No new backup is created while the previous one is still being written.
+   */
   void triggerAutosave(Logger& logger);
 
+  /**
+   * Blocks until the pending backup, if any, has been written.
+   */
+  void finishPendingSave(Logger& logger);
+
+  /**
+   * Returns the progress of the pending backup, or std::nullopt if no backup is being
+   * written.
+   */
+  std::optional<io::BackgroundFileWriterProgress> pendingSaveProgress() const;
+
 private:
   void autosave(Logger& logger, std::shared_ptr<ui::MapDocument> document);
+  void reportFinishedSave(Logger& logger);
 };
 
 } // namespace tb::ui
@@ -26,20 +26,27 @@ void CachingLogger::setParentLogger(Logger* parentLogger)
 {
   const auto lock = std::lock_guard{m_cacheMutex};
 
-  m_parentLogger = parentLogger;
-  if (m_parentLogger)
+  // replay the cached messages before publishing the parent logger, otherwise messages
+  // logged concurrently could reach the parent logger before the cached ones; concurrent
+  // loggers wait for the cache mutex until the parent logger is published
+  if (parentLogger)
   {
-    m_cache.getCachedMessages([this](const auto level, const auto& message) {
-      m_parentLogger->log(level, message);
+    m_cache.getCachedMessages([&](const auto level, const auto& message) {
+      parentLogger->log(level, message);
     });
   }
+  m_parentLogger.store(parentLogger, std::memory_order_release);
 }
 
 void CachingLogger::doLog(const LogLevel level, const std::string_view message)
 {
-  if (!cacheMessage(level, message))
+  if (auto* parentLogger = m_parentLogger.load(std::memory_order_acquire))
   {
-    m_parentLogger->log(level, message);
+    parentLogger->log(level, message);
+  }
+  else if (!cacheMessage(level, message))
+  {
+    m_parentLogger.load()->log(level, message);
   }
 }
 
@@ -47,6 +54,7 @@ bool CachingLogger::cacheMessage(const LogLevel level, const std::string_view me
 {
   auto lock = std::lock_guard{m_cacheMutex};
 
+  // the parent logger may have been set since doLog checked it
   if (!m_parentLogger)
   {
     m_cache.cacheMessage(level, message);
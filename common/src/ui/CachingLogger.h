@@ -22,6 +22,7 @@
 #include "Logger.h"
 #include "LoggerCache.h"
 
+#include <atomic>
 #include <mutex>
 #include <string_view>
 
@@ -34,7 +35,8 @@ private:
   LoggerCache m_cache;
   std::mutex m_cacheMutex;
 
-  Logger* m_parentLogger = nullptr;
+  // read without locking once set so that logging doesn't contend on m_cacheMutex
+  std::atomic<Logger*> m_parentLogger = nullptr;
 
 public:
   void setParentLogger(Logger* logger);
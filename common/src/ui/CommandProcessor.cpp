@@ -31,6 +31,8 @@
 #include "kdl/vector_utils.h"
 
 #include <algorithm>
+#include <iterator>
+#include <numeric>
 
 namespace tb::ui
 {
@@ -131,6 +133,16 @@ private:
 
     return false;
   }
+
+  size_t doGetMemorySize() const override
+  {
+    auto result = UndoableCommand::doGetMemorySize();
+    for (const auto& command : m_commands)
+    {
+      result += command->memorySize();
+    }
+    return result;
+  }
 };
 
 } // namespace
@@ -191,6 +203,34 @@ const std::string& CommandProcessor::undoCommandName() const
   return m_undoStack.back()->name();
 }
 
+size_t CommandProcessor::undoMemoryBudget() const
+{
+  return m_undoMemoryBudget;
+}
+
+void CommandProcessor::setUndoMemoryBudget(const size_t undoMemoryBudget)
+{
+  m_undoMemoryBudget = undoMemoryBudget;
+  if (m_transactionStack.empty())
+  {
+    enforceUndoMemoryBudget();
+  }
+}
+
+size_t CommandProcessor::undoMemorySize() const
+{
+  auto result = size_t(0);
+  for (const auto& command : m_undoStack)
+  {
+    result += command->memorySize();
+  }
+  for (const auto& command : m_redoStack)
+  {
+    result += command->memorySize();
+  }
+  return result;
+}
+
 const std::string& CommandProcessor::redoCommandName() const
 {
   if (!canRedo())
@@ -317,8 +357,9 @@ CommandProcessor::SubmitAndStoreResult CommandProcessor::executeAndStoreCommand(
     return {std::move(commandResult), false};
   }
 
-  const auto commandStored = storeCommand(std::move(command), collate);
+  // clear the redo stack first so that it does not count against the undo memory budget
   m_redoStack.clear();
+  const auto commandStored = storeCommand(std::move(command), collate);
   return {std::move(commandResult), commandStored};
 }
 
@@ -437,14 +478,69 @@ bool CommandProcessor::pushToUndoStack(
     auto& lastCommand = m_undoStack.back();
     if (lastCommand->collateWith(*command))
     {
+      enforceUndoMemoryBudget();
       return false;
     }
   }
 
   m_undoStack.push_back(std::move(command));
+  enforceUndoMemoryBudget();
   return true;
 }
 
+void CommandProcessor::enforceUndoMemoryBudget()
+{
+  if (m_undoMemoryBudget == 0)
+  {
+    return;
+  }
+
+  // the estimates change when brushes stop or start sharing their geometry, so they are
+  // computed anew, but only once per command
+  const auto getMemorySize = [](const auto& command) { return command->memorySize(); };
+  const auto undoMemorySizes = kdl::vec_transform(m_undoStack, getMemorySize);
+  const auto redoMemorySizes = kdl::vec_transform(m_redoStack, getMemorySize);
+
+  auto memorySize =
+    std::accumulate(undoMemorySizes.begin(), undoMemorySizes.end(), size_t(0))
+    + std::accumulate(redoMemorySizes.begin(), redoMemorySizes.end(), size_t(0));
+
+  // discard the oldest commands first, but always keep the most recent command so that it
+  // can be undone
+  auto undoEvictCount = size_t(0);
+  while (memorySize > m_undoMemoryBudget && undoEvictCount + 1 < m_undoStack.size())
+  {
+    memorySize -= undoMemorySizes[undoEvictCount++];
+  }
+
+  // then discard the undone commands that are furthest from the current state, but keep
+  // the next command to redo if there is nothing left to undo
+  const auto redoKeepCount = m_undoStack.empty() ? size_t(1) : size_t(0);
+  auto redoEvictCount = size_t(0);
+  while (memorySize > m_undoMemoryBudget
+         && redoEvictCount + redoKeepCount < m_redoStack.size())
+  {
+    memorySize -= redoMemorySizes[redoEvictCount++];
+  }
+
+  if (undoEvictCount > 0)
+  {
+    m_undoStack.erase(
+      m_undoStack.begin(),
+      std::next(m_undoStack.begin(), static_cast<std::ptrdiff_t>(undoEvictCount)));
+  }
+  if (redoEvictCount > 0)
+  {
+    m_redoStack.erase(
+      m_redoStack.begin(),
+      std::next(m_redoStack.begin(), static_cast<std::ptrdiff_t>(redoEvictCount)));
+  }
+  if (undoEvictCount + redoEvictCount > 0)
+  {
+    undoStackEvictedNotifier(undoEvictCount + redoEvictCount);
+  }
+}
+
 std::unique_ptr<UndoableCommand> CommandProcessor::popFromUndoStack()
 {
   assert(m_transactionStack.empty());
@@ -464,6 +560,7 @@ void CommandProcessor::pushToRedoStack(std::unique_ptr<UndoableCommand> command)
 {
   assert(m_transactionStack.empty());
   m_redoStack.push_back(std::move(command));
+  enforceUndoMemoryBudget();
 }
 
 std::unique_ptr<UndoableCommand> CommandProcessor::popFromRedoStack()
@@ -51,6 +51,12 @@ enum class TransactionScope;
  * The command processor supports nested transactions. Each transaction can be committed
  * or rolled back individually. Committing a nested transaction adds it as a command to
  * the containing transaction.
+ *
+ * The memory held by the undo and redo stacks can be bounded by setting an undo memory
+ * budget. When a command is stored or undone and the estimated memory of all commands on
+ * both stacks exceeds the budget, the oldest commands are discarded until the budget is
+ * met again, followed by the undone commands that are furthest from the current state. The
+ * most recent command is always kept.
  */
 class CommandProcessor
 {
@@ -65,6 +71,12 @@ private:
    */
   std::chrono::milliseconds m_collationInterval;
 
+  /**
+   * The maximum estimated memory in bytes that the commands on the undo and redo stacks
+   * may hold, or 0 if they are unbounded.
+   */
+  size_t m_undoMemoryBudget = 0;
+
   /**
    * Holds the commands that were executed so far, with the most recently executed command
    * at the end of the vector.
@@ -143,6 +155,12 @@ public:
    */
   Notifier<const std::string&> transactionUndoneNotifier;
 
+  /**
+   * Notifies observers when commands were discarded from the undo or redo stack to meet
+   * the undo memory budget. The argument is the number of discarded commands.
+   */
+  Notifier<size_t> undoStackEvictedNotifier;
+
   /**
    * Indicates whether there is any command on the undo stack.
    */
@@ -165,6 +183,25 @@ public:
    */
   const std::string& redoCommandName() const;
 
+  /**
+   * Returns the undo memory budget in bytes, or 0 if the undo and redo stacks are
+   * unbounded.
+   */
+  size_t undoMemoryBudget() const;
+
+  /**
+   * Sets the undo memory budget in bytes. Pass 0 to make the undo and redo stacks
+   * unbounded. If they currently exceed the given budget and no transaction is executing,
+   * commands are discarded immediately.
+   */
+  void setUndoMemoryBudget(size_t undoMemoryBudget);
+
+  /**
+   * Returns the estimated memory in bytes held by the commands on the undo and redo
+   * stacks.
+   */
+  size_t undoMemorySize() const;
+
   /**
    * Starts a new transaction. If a transaction is currently executing, then the newly
    * started transaction becomes a nested transaction and will be added as a command to
@@ -362,6 +399,12 @@ private:
    */
   bool pushToUndoStack(std::unique_ptr<UndoableCommand> command, bool collate);
 
+  /**
+   * Discards commands from the undo and redo stacks until the estimated memory they hold
+   * does not exceed the undo memory budget anymore, or until only one command is left.
+   */
+  void enforceUndoMemoryBudget();
+
   /**
    * Pops the topmost command from the undo stack and returns it.
    *
@@ -86,6 +86,7 @@ bool GLContextManager::initialize()
       VaryingPUniformCShader,
       MiniMapEdgeShader,
       EntityModelShader,
+      EntityModelInstancedShader,
       FaceShader,
       PatchShader,
       EdgeShader,
@@ -24,6 +24,8 @@
 #include <QStringList>
 #include <QVBoxLayout>
 
+#include "mdl/BrushFaceHandle.h"
+#include "mdl/BrushNode.h"
 #include "mdl/Issue.h"
 #include "mdl/Validator.h"
 #include "mdl/WorldNode.h"
@@ -32,6 +34,7 @@
 #include "ui/MapDocument.h"
 
 #include "kdl/memory_utils.h"
+#include "kdl/vector_utils.h"
 
 #include <utility>
 
@@ -83,14 +86,22 @@ void IssueBrowser::connectObservers()
     this, &IssueBrowser::documentWasNewedOrLoaded);
   m_notifierConnection += document->documentWasLoadedNotifier.connect(
     this, &IssueBrowser::documentWasNewedOrLoaded);
+  m_notifierConnection +=
+    document->documentWasClearedNotifier.connect(this, &IssueBrowser::documentWasCleared);
   m_notifierConnection +=
     document->nodesWereAddedNotifier.connect(this, &IssueBrowser::nodesWereAdded);
+  m_notifierConnection += document->nodesWillBeRemovedNotifier.connect(
+    this, &IssueBrowser::nodesWillBeRemoved);
   m_notifierConnection +=
-    document->nodesWereRemovedNotifier.connect(this, &IssueBrowser::nodesWereRemoved);
+    document->nodesWillChangeNotifier.connect(this, &IssueBrowser::nodesWillChange);
   m_notifierConnection +=
     document->nodesDidChangeNotifier.connect(this, &IssueBrowser::nodesDidChange);
   m_notifierConnection += document->brushFacesDidChangeNotifier.connect(
     this, &IssueBrowser::brushFacesDidChange);
+  m_notifierConnection += document->entityDefinitionsDidChangeNotifier.connect(
+    this, &IssueBrowser::entityDefinitionsOrModsDidChange);
+  m_notifierConnection += document->modsDidChangeNotifier.connect(
+    this, &IssueBrowser::entityDefinitionsOrModsDidChange);
 }
 
 void IssueBrowser::documentWasNewedOrLoaded(MapDocument*)
@@ -104,23 +115,42 @@ void IssueBrowser::documentWasSaved(MapDocument*)
   m_view->update();
 }
 
-void IssueBrowser::nodesWereAdded(const std::vector<mdl::Node*>&)
+void IssueBrowser::documentWasCleared(MapDocument*)
 {
+  // the nodes are destroyed without being removed
   m_view->reload();
 }
 
-void IssueBrowser::nodesWereRemoved(const std::vector<mdl::Node*>&)
+void IssueBrowser::nodesWereAdded(const std::vector<mdl::Node*>& nodes)
 {
-  m_view->reload();
+  m_view->invalidateNodes(nodes);
 }
 
-void IssueBrowser::nodesDidChange(const std::vector<mdl::Node*>&)
+void IssueBrowser::nodesWillBeRemoved(const std::vector<mdl::Node*>& nodes)
 {
-  m_view->reload();
+  m_view->removeNodes(nodes);
+}
+
+void IssueBrowser::nodesWillChange(const std::vector<mdl::Node*>& nodes)
+{
+  // the change may remove links, so the linked entities must be found beforehand
+  m_view->invalidateNodes(nodes);
+}
+
+void IssueBrowser::nodesDidChange(const std::vector<mdl::Node*>& nodes)
+{
+  m_view->invalidateNodes(nodes);
+}
+
+void IssueBrowser::brushFacesDidChange(const std::vector<mdl::BrushFaceHandle>& faces)
+{
+  m_view->invalidateNodes(kdl::vec_transform(
+    faces, [](const auto& handle) -> mdl::Node* { return handle.node(); }));
 }
 
-void IssueBrowser::brushFacesDidChange(const std::vector<mdl::BrushFaceHandle>&)
+void IssueBrowser::entityDefinitionsOrModsDidChange()
 {
+  // entity definitions are replaced without notifying about the affected entities
   m_view->reload();
 }
 
@@ -67,10 +67,13 @@ private:
   void connectObservers();
   void documentWasNewedOrLoaded(MapDocument* document);
   void documentWasSaved(MapDocument* document);
+  void documentWasCleared(MapDocument* document);
   void nodesWereAdded(const std::vector<mdl::Node*>& nodes);
-  void nodesWereRemoved(const std::vector<mdl::Node*>& nodes);
+  void nodesWillBeRemoved(const std::vector<mdl::Node*>& nodes);
+  void nodesWillChange(const std::vector<mdl::Node*>& nodes);
   void nodesDidChange(const std::vector<mdl::Node*>& nodes);
   void brushFacesDidChange(const std::vector<mdl::BrushFaceHandle>& faces);
+  void entityDefinitionsOrModsDidChange();
   void issueIgnoreChanged(mdl::Issue* issue);
 
   void updateFilterFlags();
@@ -42,10 +42,54 @@
 #include "kdl/vector_set.h"
 #include "kdl/vector_utils.h"
 
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace tb::ui
 {
+namespace
+{
+
+std::vector<mdl::Node*> collectSubtrees(const std::vector<mdl::Node*>& nodes)
+{
+  auto result = std::vector<mdl::Node*>{};
+  mdl::Node::visitAll(nodes, [&](auto&& thisLambda, mdl::Node* node) {
+    result.push_back(node);
+    node->visitChildren(thisLambda);
+  });
+  return result;
+}
+
+std::vector<mdl::Node*> collectLinkedEntities(const std::vector<mdl::Node*>& nodes)
+{
+  auto result = std::vector<mdl::Node*>{};
+  const auto addLinkedEntities = [&](const mdl::EntityNodeBase* entityNode) {
+    for (const auto* links :
+         {&entityNode->linkSources(),
+          &entityNode->linkTargets(),
+          &entityNode->killSources(),
+          &entityNode->killTargets()})
+    {
+      result.insert(result.end(), links->begin(), links->end());
+    }
+  };
+
+  mdl::Node::visitAll(
+    nodes,
+    kdl::overload(
+      [&](mdl::WorldNode* world) { addLinkedEntities(world); },
+      [](mdl::LayerNode*) {},
+      [](mdl::GroupNode*) {},
+      [&](mdl::EntityNode* entity) { addLinkedEntities(entity); },
+      [](mdl::BrushNode*) {},
+      [](mdl::PatchNode*) {}));
+  return result;
+}
+
+} // namespace
 
 IssueBrowserView::IssueBrowserView(std::weak_ptr<MapDocument> document, QWidget* parent)
   : QWidget{parent}
@@ -97,9 +141,44 @@ void IssueBrowserView::setShowHiddenIssues(const bool show)
 
 void IssueBrowserView::reload()
 {
+  m_reloadAll = true;
+  invalidate();
+}
+
+void IssueBrowserView::invalidateNodes(const std::vector<mdl::Node*>& nodes)
+{
+  const auto subtreeNodes = collectSubtrees(nodes);
+  const auto linkedEntities = collectLinkedEntities(subtreeNodes);
+  m_changedNodes.insert(subtreeNodes.begin(), subtreeNodes.end());
+  m_changedNodes.insert(linkedEntities.begin(), linkedEntities.end());
+
+  for (auto* node : nodes)
+  {
+    for (auto* ancestor = node->parent(); ancestor; ancestor = ancestor->parent())
+    {
+      m_changedNodes.insert(ancestor);
+    }
+  }
+
   invalidate();
 }
 
+void IssueBrowserView::removeNodes(const std::vector<mdl::Node*>& nodes)
+{
+  // the ancestors and linked entities remain, but their issues may change
+  invalidateNodes(nodes);
+
+  for (auto* node : collectSubtrees(nodes))
+  {
+    m_changedNodes.erase(node);
+    if (const auto it = m_issueSeqIdsByNode.find(node); it != m_issueSeqIdsByNode.end())
+    {
+      m_removedSeqIds.insert(it->second.begin(), it->second.end());
+      m_issueSeqIdsByNode.erase(it);
+    }
+  }
+}
+
 void IssueBrowserView::deselectAll()
 {
   m_tableView->clearSelection();
@@ -133,42 +212,94 @@ void IssueBrowserView::updateIssues()
   {
     const auto validators = document->world()->registeredValidators();
 
-    auto issues = std::vector<const mdl::Issue*>{};
-    const auto collectIssues = [&](auto* node) {
-      for (auto* issue : node->issues(validators))
+    if (m_reloadAll)
+    {
+      m_issues.clear();
+      m_issueSeqIdsByNode.clear();
+      m_removedSeqIds.clear();
+      m_changedNodes.clear();
+
+      const auto nodes = collectSubtrees({document->world()});
+      m_changedNodes.insert(nodes.begin(), nodes.end());
+      m_reloadAll = false;
+    }
+
+    // The nodes that had issues are checked again in case their issues were invalidated
+    // by a change that wasn't reported, so that the table never shows a destroyed issue.
+    auto nodes = std::vector<mdl::Node*>(m_changedNodes.begin(), m_changedNodes.end());
+    for (const auto& [node, seqIds] : m_issueSeqIdsByNode)
+    {
+      if (!m_changedNodes.contains(node))
+      {
+        nodes.push_back(node);
+      }
+    }
+    m_changedNodes.clear();
+
+    mdl::Node::validateIssues(nodes, validators);
+
+    // find the nodes whose issues changed since the last update
+    auto removedSeqIds = std::exchange(m_removedSeqIds, {});
+    auto addedIssues = std::vector<IssueEntry>{};
+
+    for (auto* node : nodes)
+    {
+      const auto issues = node->issues(validators);
+      auto seqIds =
+        kdl::vec_transform(issues, [](const auto* issue) { return issue->seqId(); });
+
+      const auto it = m_issueSeqIdsByNode.find(node);
+      if (it != m_issueSeqIdsByNode.end() && it->second == seqIds)
+      {
+        continue;
+      }
+
+      for (const auto* issue : issues)
       {
-        if (
-          m_showHiddenIssues
-          || (!issue->hidden() && (issue->type() & m_hiddenIssueTypes) == 0))
+        addedIssues.push_back({issue->seqId(), issue});
+      }
+
+      if (it != m_issueSeqIdsByNode.end())
+      {
+        removedSeqIds.insert(it->second.begin(), it->second.end());
+        if (seqIds.empty())
+        {
+          m_issueSeqIdsByNode.erase(it);
+        }
+        else
         {
-          issues.push_back(issue);
+          it->second = std::move(seqIds);
         }
       }
+      else if (!seqIds.empty())
+      {
+        m_issueSeqIdsByNode.emplace(node, std::move(seqIds));
+      }
+    }
+
+    const auto bySeqIdDescending = [](const auto& lhs, const auto& rhs) {
+      return lhs.seqId > rhs.seqId;
     };
 
-    document->world()->accept(kdl::overload(
-      [&](auto&& thisLambda, mdl::WorldNode* world) {
-        collectIssues(world);
-        world->visitChildren(thisLambda);
-      },
-      [&](auto&& thisLambda, mdl::LayerNode* layer) {
-        collectIssues(layer);
-        layer->visitChildren(thisLambda);
-      },
-      [&](auto&& thisLambda, mdl::GroupNode* group) {
-        collectIssues(group);
-        group->visitChildren(thisLambda);
-      },
-      [&](auto&& thisLambda, mdl::EntityNode* entity) {
-        collectIssues(entity);
-        entity->visitChildren(thisLambda);
-      },
-      [&](mdl::BrushNode* brush) { collectIssues(brush); },
-      [&](mdl::PatchNode* patch) { collectIssues(patch); }));
-
-    issues = kdl::vec_sort(std::move(issues), [](const auto* lhs, const auto* rhs) {
-      return lhs->seqId() > rhs->seqId();
+    std::erase_if(m_issues, [&](const auto& entry) {
+      return removedSeqIds.contains(entry.seqId);
     });
+
+    addedIssues = kdl::vec_sort(std::move(addedIssues), bySeqIdDescending);
+
+    const auto mid = m_issues.insert(m_issues.end(), addedIssues.begin(), addedIssues.end());
+    std::inplace_merge(m_issues.begin(), mid, m_issues.end(), bySeqIdDescending);
+
+    auto issues = std::vector<const mdl::Issue*>{};
+    for (const auto& entry : m_issues)
+    {
+      if (
+        m_showHiddenIssues
+        || (!entry.issue->hidden() && (entry.issue->type() & m_hiddenIssueTypes) == 0))
+      {
+        issues.push_back(entry.issue);
+      }
+    }
     m_tableModel->setIssues(std::move(issues));
   }
 }
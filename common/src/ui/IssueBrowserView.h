@@ -25,6 +25,8 @@
 #include "mdl/IssueType.h"
 
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 class QWidget;
@@ -36,6 +38,7 @@ namespace mdl
 {
 class Issue;
 class IssueQuickFix;
+class Node;
 } // namespace mdl
 
 namespace ui
@@ -53,6 +56,36 @@ private:
   bool m_showHiddenIssues = false;
 
   bool m_valid = false;
+  bool m_reloadAll = true;
+
+  /**
+   * The issues found by the last update, ordered by descending sequence id. The sequence
+   * id is stored alongside each issue because the issue itself may have been destroyed
+   * since.
+   */
+  struct IssueEntry
+  {
+    size_t seqId;
+    const mdl::Issue* issue;
+  };
+  std::vector<IssueEntry> m_issues;
+
+  /**
+   * The sequence ids of the issues of each node that had issues as of the last update. A
+   * node whose issues have the same sequence ids still has the same issues. Every
+   * update checks these nodes again, so an issue shown in the table is never stale.
+   */
+  std::unordered_map<mdl::Node*, std::vector<size_t>> m_issueSeqIdsByNode;
+
+  /**
+   * The nodes whose issues may have changed since the last update.
+   */
+  std::unordered_set<mdl::Node*> m_changedNodes;
+
+  /**
+   * The sequence ids of the issues of nodes that were removed since the last update.
+   */
+  std::unordered_set<size_t> m_removedSeqIds;
 
   QTableView* m_tableView = nullptr;
   IssueBrowserModel* m_tableModel = nullptr;
@@ -71,6 +104,20 @@ public:
   void reload();
   void deselectAll();
 
+  /**
+   * Marks the given nodes as changed, along with all other nodes whose issues depend on
+   * them: their ancestors, their descendants and the entities linked to them. Call this
+   * before and after the nodes change so that links that are added or removed are
+   * accounted for.
+   */
+  void invalidateNodes(const std::vector<mdl::Node*>& nodes);
+
+  /**
+   * Drops the issues of the given nodes and their descendants. Must be called while the
+   * nodes are still in the world.
+   */
+  void removeNodes(const std::vector<mdl::Node*>& nodes);
+
 private:
   void updateIssues();
 
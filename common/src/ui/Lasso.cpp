@@ -30,6 +30,9 @@
 #include "vm/polygon.h"
 #include "vm/segment.h"
 
+#include <algorithm>
+#include <array>
+
 namespace tb::ui
 {
 
@@ -68,6 +71,59 @@ bool Lasso::selects(
   return selects(polygon.center(), plane, box);
 }
 
+std::function<bool(const vm::bbox3d&)> Lasso::boundsTest() const
+{
+  const auto transform = getTransform();
+  const auto inverseTransform = vm::invert(transform);
+  if (!inverseTransform)
+  {
+    return [](const vm::bbox3d&) { return true; };
+  }
+
+  const auto box = getBox(transform);
+  const auto center = *inverseTransform * vm::vec3d{box.center(), 0.0};
+  const auto corners = std::array{
+    *inverseTransform * vm::vec3d{box.min.x(), box.min.y(), 0.0},
+    *inverseTransform * vm::vec3d{box.min.x(), box.max.y(), 0.0},
+    *inverseTransform * vm::vec3d{box.max.x(), box.max.y(), 0.0},
+    *inverseTransform * vm::vec3d{box.max.x(), box.min.y(), 0.0},
+  };
+
+  // The selected points lie in the pyramid (or prism for orthographic cameras) that is
+  // spanned by the pick rays through the corners of the lasso box.
+  auto planes = std::vector<vm::plane3d>{};
+  for (size_t i = 0; i < corners.size(); ++i)
+  {
+    const auto& start = corners[i];
+    const auto& end = corners[(i + 1) % corners.size()];
+    const auto rayDirection = m_camera.orthographicProjection()
+                                ? vm::vec3d{m_camera.direction()}
+                                : start - vm::vec3d{m_camera.position()};
+
+    const auto normal = vm::cross(end - start, rayDirection);
+    if (vm::is_zero(normal, vm::Cd::almost_zero()))
+    {
+      // the lasso box is degenerate
+      return [](const vm::bbox3d&) { return true; };
+    }
+
+    const auto plane = vm::plane3d{start, vm::normalize(normal)};
+    planes.push_back(plane.point_distance(center) > 0.0 ? plane.flip() : plane);
+  }
+
+  return [planes = std::move(planes)](const vm::bbox3d& bounds) {
+    return std::none_of(planes.begin(), planes.end(), [&](const auto& plane) {
+      // the corner of the box that is furthest behind the plane
+      const auto corner = vm::vec3d{
+        plane.normal.x() > 0.0 ? bounds.min.x() : bounds.max.x(),
+        plane.normal.y() > 0.0 ? bounds.min.y() : bounds.max.y(),
+        plane.normal.z() > 0.0 ? bounds.min.z() : bounds.max.z(),
+      };
+      return plane.point_distance(corner) > vm::Cd::almost_zero();
+    });
+  };
+}
+
 std::optional<vm::vec3d> Lasso::project(
   const vm::vec3d& point, const vm::plane3d& plane) const
 {
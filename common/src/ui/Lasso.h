@@ -25,6 +25,8 @@
 #include "vm/polygon.h"
 #include "vm/segment.h"
 
+#include <functional>
+
 namespace tb::render
 {
 class Camera;
@@ -63,6 +65,12 @@ public:
     }
   }
 
+  /**
+   * Returns a conservative test for bounding boxes. The test returns false only if no
+   * point within a given box can be selected by this lasso.
+   */
+  std::function<bool(const vm::bbox3d&)> boundsTest() const;
+
 private:
   bool selects(
     const vm::vec3d& point, const vm::plane3d& plane, const vm::bbox2d& box) const;
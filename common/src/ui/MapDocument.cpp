@@ -29,6 +29,7 @@
 #include "io/PathInfo.h"
 #include "io/SimpleParserStatus.h"
 #include "io/SystemPaths.h"
+#include "io/TextureCache.h"
 #include "mdl/AssetUtils.h"
 #include "mdl/BezierPatch.h"
 #include "mdl/Brush.h"
@@ -79,6 +80,7 @@
 #include "mdl/PropertyKeyWithDoubleQuotationMarksValidator.h"
 #include "mdl/PropertyValueWithDoubleQuotationMarksValidator.h"
 #include "mdl/PushSelection.h"
+#include "mdl/ResourceLoadQueue.h"
 #include "mdl/ResourceManager.h"
 #include "mdl/SoftMapBoundsValidator.h"
 #include "mdl/TagManager.h"
@@ -369,6 +371,26 @@ bool applyAndSwap(
 
   return success;
 }
+
+/**
+ * Returns the texture cache shared by all documents, or nullptr if the texture cache is
+ * disabled in the preferences.
+ */
+std::shared_ptr<io::TextureCache> textureCacheFromPreferences()
+{
+  if (!pref(Preferences::TextureCacheEnabled))
+  {
+    return nullptr;
+  }
+
+  static auto textureCache = std::make_shared<io::TextureCache>(
+    io::SystemPaths::userDataDirectory() / "texture cache", 0);
+
+  const auto maxSizeInMegabytes = std::max(0, pref(Preferences::TextureCacheSize));
+  textureCache->setMaxSize(size_t(maxSizeInMegabytes) * 1024u * 1024u);
+  return textureCache;
+}
+
 } // namespace
 
 const vm::bbox3d MapDocument::DefaultWorldBounds(-32768.0, 32768.0);
@@ -377,6 +399,7 @@ const std::string MapDocument::DefaultDocumentName("unnamed.map");
 MapDocument::MapDocument()
   : m_worldBounds(DefaultWorldBounds)
   , m_world(nullptr)
+  , m_resourceLoadQueue(std::make_unique<mdl::ResourceLoadQueue>())
   , m_resourceManager(std::make_unique<mdl::ResourceManager>())
   , m_entityDefinitionManager(std::make_unique<mdl::EntityDefinitionManager>())
   , m_entityModelManager(std::make_unique<mdl::EntityModelManager>(
@@ -653,6 +676,16 @@ Result<void> MapDocument::exportDocumentAs(const io::ExportOptions& options)
   return m_game->exportMap(*m_world, options);
 }
 
+std::string MapDocument::serializeDocument()
+{
+  ensure(m_game.get() != nullptr, "game is null");
+  ensure(m_world, "world is null");
+
+  std::stringstream stream;
+  m_game->writeMapToStream(*m_world, stream);
+  return stream.str();
+}
+
 void MapDocument::doSaveDocument(const std::filesystem::path& path)
 {
   saveDocumentTo(path);
@@ -674,6 +707,9 @@ void MapDocument::clearDocument()
     clearWorld();
     clearModificationCount();
 
+    // the game and its file system may be replaced after this
+    m_resourceLoadQueue->waitForTasks();
+
     documentWasClearedNotifier(this);
   }
 }
@@ -4262,6 +4298,17 @@ void MapDocument::clearRepeatableCommands()
   m_repeatStack->clear();
 }
 
+size_t MapDocument::undoMemorySize() const
+{
+  return doGetUndoMemorySize();
+}
+
+void MapDocument::updateUndoMemoryBudget()
+{
+  const auto budgetInMegabytes = std::max(0, pref(Preferences::UndoMemoryBudget));
+  doSetUndoMemoryBudget(size_t(budgetInMegabytes) * 1024u * 1024u);
+}
+
 void MapDocument::startTransaction(std::string name, const TransactionScope scope)
 {
   debug("Starting transaction '" + name + "'");
@@ -4338,16 +4385,28 @@ void MapDocument::processResourcesSync(const mdl::ProcessContext& processContext
 void MapDocument::processResourcesAsync(const mdl::ProcessContext& processContext)
 {
   const auto processedResourceIds = m_resourceManager->process(
-    [](auto task) { return std::async(std::move(task)); },
-    processContext,
-    std::chrono::milliseconds{20});
+    m_resourceLoadQueue->taskRunner(), processContext, std::chrono::milliseconds{20});
 
   if (!processedResourceIds.empty())
   {
+    if (!m_resourceManager->needsProcessing())
+    {
+      const auto stats = m_resourceLoadQueue->stats();
+      debug() << "Loaded " << stats.completedTasks << " resources (average latency "
+              << stats.averageLatency.count() << "ms, max latency "
+              << stats.maxLatency.count() << "ms, " << stats.cancelledTasks
+              << " cancelled)";
+    }
+
     resourcesWereProcessedNotifier.notify(processedResourceIds);
   }
 }
 
+mdl::ResourceLoadQueueStats MapDocument::resourceLoadStats() const
+{
+  return m_resourceLoadQueue->stats();
+}
+
 bool MapDocument::needsResourceProcessing()
 {
   return m_resourceManager->needsProcessing();
@@ -4361,6 +4420,17 @@ void MapDocument::pick(const vm::ray3d& pickRay, mdl::PickResult& pickResult) co
   }
 }
 
+void MapDocument::pickClosest(
+  const vm::ray3d& pickRay,
+  const mdl::HitFilter& hitFilter,
+  mdl::PickResult& pickResult) const
+{
+  if (m_world)
+  {
+    m_world->pickClosest(*m_editorContext, pickRay, hitFilter, pickResult);
+  }
+}
+
 std::vector<mdl::Node*> MapDocument::findNodesContaining(const vm::vec3d& point) const
 {
   auto result = std::vector<mdl::Node*>{};
@@ -4610,6 +4680,7 @@ void MapDocument::loadMaterials()
         [](const auto& str) { return std::filesystem::path{str}; });
       m_game->reloadWads(path(), wadPaths, logger());
     }
+    m_materialManager->setTextureCache(textureCacheFromPreferences());
     m_game->loadMaterialCollections(*m_materialManager, [&](auto resourceLoader) {
       auto resource = std::make_shared<mdl::TextureResource>(std::move(resourceLoader));
       m_resourceManager->addResource(resource);
@@ -4640,7 +4711,8 @@ static auto makeSetMaterialsVisitor(mdl::MaterialManager& manager)
       for (size_t i = 0u; i < brush.faceCount(); ++i)
       {
         const mdl::BrushFace& face = brush.face(i);
-        mdl::Material* material = manager.material(face.attributes().materialName());
+        mdl::Material* material =
+          manager.material(face.attributes().internedMaterialName());
         brushNode->setFaceMaterial(i, material);
       }
     },
@@ -4685,7 +4757,8 @@ void MapDocument::setMaterials(const std::vector<mdl::BrushFaceHandle>& faceHand
   {
     mdl::BrushNode* node = faceHandle.node();
     const mdl::BrushFace& face = faceHandle.face();
-    auto* material = m_materialManager->material(face.attributes().materialName());
+    auto* material =
+      m_materialManager->material(face.attributes().internedMaterialName());
     node->setFaceMaterial(faceHandle.faceIndex(), material);
   }
   materialUsageCountsDidChangeNotifier();
@@ -4841,6 +4914,8 @@ std::vector<std::filesystem::path> MapDocument::externalSearchPaths() const
 
 void MapDocument::updateGameSearchPaths()
 {
+  // loading tasks may still read from the file system that is about to be replaced
+  m_resourceLoadQueue->waitForTasks();
   m_game->setAdditionalSearchPaths(
     kdl::vec_transform(
       mods(), [](const auto& mod) { return std::filesystem::path{mod}; }),
@@ -5214,6 +5289,7 @@ void MapDocument::preferenceDidChange(const std::filesystem::path& path)
   {
     const mdl::GameFactory& gameFactory = mdl::GameFactory::instance();
     const std::filesystem::path newGamePath = gameFactory.gamePath(m_game->config().name);
+    m_resourceLoadQueue->waitForTasks();
     m_game->setGamePath(newGamePath, logger());
 
     clearEntityModels();
@@ -5222,6 +5298,16 @@ void MapDocument::preferenceDidChange(const std::filesystem::path& path)
     reloadMaterials();
     setMaterials();
   }
+  else if (path == Preferences::UndoMemoryBudget.path())
+  {
+    updateUndoMemoryBudget();
+  }
+  else if (
+    path == Preferences::TextureCacheEnabled.path()
+    || path == Preferences::TextureCacheSize.path())
+  {
+    m_materialManager->setTextureCache(textureCacheFromPreferences());
+  }
 }
 
 void MapDocument::commandDone(Command& command)
@@ -24,6 +24,7 @@
 #include "Result.h"
 #include "mdl/ColorRange.h"
 #include "mdl/Game.h"
+#include "mdl/HitFilter.h"
 #include "mdl/MapFacade.h"
 #include "mdl/NodeCollection.h"
 #include "mdl/NodeContents.h"
@@ -68,6 +69,7 @@ class PickResult;
 class PointTrace;
 class PortalFile;
 class ResourceId;
+class ResourceLoadQueue;
 class ResourceManager;
 class SmartTag;
 class TagManager;
@@ -76,6 +78,7 @@ class WorldNode;
 enum class MapFormat;
 enum class WrapStyle;
 struct ProcessContext;
+struct ResourceLoadQueueStats;
 } // namespace tb::mdl
 
 namespace tb::ui
@@ -118,6 +121,7 @@ protected:
   std::optional<PointFile> m_pointFile;
   std::optional<PortalFile> m_portalFile;
 
+  std::unique_ptr<mdl::ResourceLoadQueue> m_resourceLoadQueue;
   std::unique_ptr<mdl::ResourceManager> m_resourceManager;
   std::unique_ptr<mdl::EntityDefinitionManager> m_entityDefinitionManager;
   std::unique_ptr<mdl::EntityModelManager> m_entityModelManager;
@@ -315,6 +319,12 @@ public: // new, load, save document
   void saveDocumentTo(const std::filesystem::path& path);
   Result<void> exportDocumentAs(const io::ExportOptions& options);
 
+  /**
+   * Serializes the entire document into a string, which can then be written to a file on
+   * another thread while the document is being edited.
+   */
+  std::string serializeDocument();
+
 private:
   void doSaveDocument(const std::filesystem::path& path);
   void clearDocument();
@@ -656,6 +666,14 @@ public: // command processing
   void repeatCommands();
   void clearRepeatableCommands();
 
+  /**
+   * Returns the estimated memory in bytes held by the undo history.
+   */
+  size_t undoMemorySize() const;
+
+protected:
+  void updateUndoMemoryBudget();
+
 public: // transactions
   void startTransaction(std::string name, TransactionScope scope);
   void rollbackTransaction();
@@ -676,6 +694,8 @@ private: // subclassing interface for command processing
   virtual const std::string& doGetRedoCommandName() const = 0;
   virtual void doUndoCommand() = 0;
   virtual void doRedoCommand() = 0;
+  virtual size_t doGetUndoMemorySize() const = 0;
+  virtual void doSetUndoMemoryBudget(size_t undoMemoryBudget) = 0;
 
   virtual void doClearCommandProcessor() = 0;
   virtual void doStartTransaction(std::string name, TransactionScope scope) = 0;
@@ -689,10 +709,15 @@ private: // subclassing interface for command processing
 public: // asset state management
   void processResourcesSync(const mdl::ProcessContext& processContext);
   void processResourcesAsync(const mdl::ProcessContext& processContext);
+  mdl::ResourceLoadQueueStats resourceLoadStats() const;
   bool needsResourceProcessing();
 
 public: // picking
   void pick(const vm::ray3d& pickRay, mdl::PickResult& pickResult) const;
+  void pickClosest(
+    const vm::ray3d& pickRay,
+    const mdl::HitFilter& hitFilter,
+    mdl::PickResult& pickResult) const;
   std::vector<mdl::Node*> findNodesContaining(const vm::vec3d& point) const;
 
 private: // world management
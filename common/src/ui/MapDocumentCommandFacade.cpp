@@ -80,6 +80,7 @@ MapDocumentCommandFacade::MapDocumentCommandFacade()
   : m_commandProcessor{std::make_unique<CommandProcessor>(*this)}
 {
   connectObservers();
+  updateUndoMemoryBudget();
 }
 
 MapDocumentCommandFacade::~MapDocumentCommandFacade() = default;
@@ -622,6 +623,15 @@ void MapDocumentCommandFacade::connectObservers()
     m_commandProcessor->transactionDoneNotifier.connect(transactionDoneNotifier);
   m_notifierConnection +=
     m_commandProcessor->transactionUndoneNotifier.connect(transactionUndoneNotifier);
+  m_notifierConnection += m_commandProcessor->undoStackEvictedNotifier.connect(
+    this, &MapDocumentCommandFacade::undoStackEvicted);
+}
+
+void MapDocumentCommandFacade::undoStackEvicted(const size_t evictCount)
+{
+  info() << "Discarded " << evictCount
+         << " undo steps to meet the undo memory budget, undo history now uses "
+         << m_commandProcessor->undoMemorySize() / 1024u << " KiB";
 }
 
 bool MapDocumentCommandFacade::isCurrentDocumentStateObservable() const
@@ -659,6 +669,16 @@ void MapDocumentCommandFacade::doRedoCommand()
   m_commandProcessor->redo();
 }
 
+size_t MapDocumentCommandFacade::doGetUndoMemorySize() const
+{
+  return m_commandProcessor->undoMemorySize();
+}
+
+void MapDocumentCommandFacade::doSetUndoMemoryBudget(const size_t undoMemoryBudget)
+{
+  m_commandProcessor->setUndoMemoryBudget(undoMemoryBudget);
+}
+
 void MapDocumentCommandFacade::doClearCommandProcessor()
 {
   m_commandProcessor->clear();
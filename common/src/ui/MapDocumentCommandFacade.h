@@ -110,6 +110,7 @@ private: // notification
   void connectObservers();
   void documentWasNewed(MapDocument* document);
   void documentWasLoaded(MapDocument* document);
+  void undoStackEvicted(size_t evictCount);
 
 private: // implement MapDocument interface
   bool isCurrentDocumentStateObservable() const override;
@@ -120,6 +121,8 @@ private: // implement MapDocument interface
   const std::string& doGetRedoCommandName() const override;
   void doUndoCommand() override;
   void doRedoCommand() override;
+  size_t doGetUndoMemorySize() const override;
+  void doSetUndoMemoryBudget(size_t undoMemoryBudget) override;
 
   void doClearCommandProcessor() override;
   void doStartTransaction(std::string name, TransactionScope scope) override;
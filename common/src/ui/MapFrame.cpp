@@ -185,9 +185,12 @@ MapFrame::~MapFrame()
   const auto children = this->children();
   qDeleteAll(std::rbegin(children), std::rend(children));
 
-  // let's trigger a final autosave before releasing the document
+  // let's trigger a final autosave before releasing the document, but wait for a pending
+  // backup first because no new backup is created while one is being written
   auto logger = NullLogger{};
+  m_autosaver->finishPendingSave(logger);
   m_autosaver->triggerAutosave(logger);
+  m_autosaver->finishPendingSave(logger);
 
   m_document->setViewEffectsService(nullptr);
   m_document.reset();
@@ -235,11 +235,12 @@ vm::vec3d MapView3D::pasteObjectsDelta(
   {
     const auto pickRay =
       vm::ray3d{m_camera->pickRay(float(clientCoords.x()), float(clientCoords.y()))};
+    const auto hitFilter = type(mdl::BrushNode::BrushHitType);
     auto pickResult = mdl::PickResult::byDistance();
 
-    document->pick(pickRay, pickResult);
+    document->pickClosest(pickRay, hitFilter, pickResult);
 
-    const auto& hit = pickResult.first(type(mdl::BrushNode::BrushHitType));
+    const auto& hit = pickResult.first(hitFilter);
     if (const auto faceHandle = mdl::hitToFaceHandle(hit))
     {
       const auto& face = faceHandle->face();
@@ -79,6 +79,8 @@
 #include "vm/polygon.h"
 #include "vm/util.h"
 
+#include <fmt/format.h>
+
 #include <vector>
 
 namespace tb::ui
@@ -1028,6 +1030,8 @@ void MapViewBase::renderContents()
   renderFPS(renderContext, renderBatch);
 
   renderBatch.render(renderContext);
+  m_cullingStats = renderContext.cullingStats();
+  m_entityModelStats = renderContext.entityModelStats();
 
   if (document->needsResourceProcessing())
   {
@@ -1146,7 +1150,13 @@ void MapViewBase::renderFPS(
   if (pref(Preferences::ShowFPS))
   {
     auto renderService = render::RenderService{renderContext, renderBatch};
-    renderService.renderHeadsUp(m_currentFPS);
+    renderService.renderHeadsUp(fmt::format(
+      "{} Drawn: {} Culled: {} Models: {} in {} draw calls",
+      m_currentFPS,
+      m_cullingStats.drawn,
+      m_cullingStats.culled,
+      m_entityModelStats.instances,
+      m_entityModelStats.drawCalls));
   }
 }
 
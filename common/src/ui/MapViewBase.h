@@ -20,6 +20,8 @@
 #pragma once
 
 #include "NotifierConnection.h"
+#include "render/CullingStats.h"
+#include "render/EntityModelStats.h"
 #include "ui/ActionContext.h"
 #include "ui/CameraLinkHelper.h"
 #include "ui/MapView.h"
@@ -97,6 +99,12 @@ private:
    */
   bool m_isCurrent = false;
 
+  /**
+   * The culling stats of the most recently rendered frame, shown with the FPS counter.
+   */
+  render::CullingStats m_cullingStats;
+  render::EntityModelStats m_entityModelStats;
+
   SignalDelayer* m_updateActionStatesSignalDelayer = nullptr;
 
   NotifierConnection m_notifierConnection;
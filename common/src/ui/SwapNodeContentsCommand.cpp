@@ -19,6 +19,7 @@
 
 #include "SwapNodeContentsCommand.h"
 
+#include "mdl/ModelUtils.h"
 #include "mdl/Node.h"
 #include "ui/MapDocumentCommandFacade.h"
 
@@ -68,4 +69,14 @@ bool SwapNodeContentsCommand::doCollateWith(UndoableCommand& command)
   return false;
 }
 
+size_t SwapNodeContentsCommand::doGetMemorySize() const
+{
+  auto result = UpdateLinkedGroupsCommandBase::doGetMemorySize();
+  for (const auto& [node, contents] : m_nodes)
+  {
+    result += sizeof(node) + mdl::estimateMemorySize(contents);
+  }
+  return result;
+}
+
 } // namespace tb::ui
@@ -50,6 +50,7 @@ public:
     MapDocumentCommandFacade& document) override;
 
   bool doCollateWith(UndoableCommand& command) override;
+  size_t doGetMemorySize() const override;
 
   deleteCopyAndMove(SwapNodeContentsCommand);
 };
@@ -73,11 +73,21 @@ bool UndoableCommand::collateWith(UndoableCommand& command)
   return false;
 }
 
+size_t UndoableCommand::memorySize() const
+{
+  return doGetMemorySize();
+}
+
 bool UndoableCommand::doCollateWith(UndoableCommand&)
 {
   return false;
 }
 
+size_t UndoableCommand::doGetMemorySize() const
+{
+  return sizeof(*this) + name().capacity();
+}
+
 void UndoableCommand::setModificationCount(MapDocumentCommandFacade& document) const
 {
   if (m_modificationCount)
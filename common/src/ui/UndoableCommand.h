@@ -45,11 +45,22 @@ public:
 
   virtual bool collateWith(UndoableCommand& command);
 
+  /**
+   * Returns an estimate of the memory in bytes that this command holds in order to undo
+   * or redo its changes.
+   *
+   * The estimate is not cached because the memory of brush geometry that is shared with
+   * the document or other commands is split among its owners, so the estimate changes
+   * whenever a brush stops or starts sharing its geometry.
+   */
+  size_t memorySize() const;
+
 protected:
   virtual std::unique_ptr<CommandResult> doPerformUndo(
     MapDocumentCommandFacade& document) = 0;
 
   virtual bool doCollateWith(UndoableCommand& command);
+  virtual size_t doGetMemorySize() const;
 
   void setModificationCount(MapDocumentCommandFacade& document) const;
   void resetModificationCount(MapDocumentCommandFacade& document) const;
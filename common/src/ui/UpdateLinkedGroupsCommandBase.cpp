@@ -101,4 +101,9 @@ bool UpdateLinkedGroupsCommandBase::collateWith(UndoableCommand& command)
   return false;
 }
 
+size_t UpdateLinkedGroupsCommandBase::doGetMemorySize() const
+{
+  return UndoableCommand::doGetMemorySize() + m_updateLinkedGroupsHelper.memorySize();
+}
+
 } // namespace tb::ui
@@ -49,6 +49,9 @@ public:
 
   bool collateWith(UndoableCommand& command) override;
 
+protected:
+  size_t doGetMemorySize() const override;
+
 private:
   deleteCopyAndMove(UpdateLinkedGroupsCommandBase);
 };
@@ -112,6 +112,28 @@ void UpdateLinkedGroupsHelper::collateWith(UpdateLinkedGroupsHelper& other)
   }
 }
 
+size_t UpdateLinkedGroupsHelper::memorySize() const
+{
+  return std::visit(
+    kdl::overload(
+      [](const ChangedLinkedGroups& changedLinkedGroups) {
+        return changedLinkedGroups.capacity() * sizeof(mdl::GroupNode*);
+      },
+      [](const LinkedGroupUpdates& linkedGroupUpdates) {
+        auto result =
+          linkedGroupUpdates.capacity() * sizeof(LinkedGroupUpdates::value_type);
+        for (const auto& [groupNode, oldChildren] : linkedGroupUpdates)
+        {
+          for (const auto& oldChild : oldChildren)
+          {
+            result += mdl::estimateMemorySize(*oldChild);
+          }
+        }
+        return result;
+      }),
+    m_state);
+}
+
 Result<void> UpdateLinkedGroupsHelper::computeLinkedGroupUpdates(
   MapDocumentCommandFacade& document)
 {
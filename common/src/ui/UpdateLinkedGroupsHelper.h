@@ -70,6 +70,12 @@ public:
   void undoLinkedGroupUpdates(MapDocumentCommandFacade& document);
   void collateWith(UpdateLinkedGroupsHelper& other);
 
+  /**
+   * Returns an estimate of the memory in bytes held by the replaced children of the
+   * updated linked groups.
+   */
+  size_t memorySize() const;
+
 private:
   Result<void> computeLinkedGroupUpdates(MapDocumentCommandFacade& document);
   static Result<LinkedGroupUpdates> computeLinkedGroupUpdates(
@@ -25,14 +25,59 @@
 #include "mdl/Polyhedron.h"
 #include "ui/Grid.h"
 
+#include "vm/bbox.h"
 #include "vm/distance.h"
+#include "vm/intersection.h"
 #include "vm/polygon.h"
 #include "vm/ray.h"
 #include "vm/vec.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace tb::ui
 {
 
+vm::bbox3d handleBounds(const vm::vec3d& handle)
+{
+  return vm::bbox3d{handle, handle};
+}
+
+vm::bbox3d handleBounds(const vm::segment3d& handle)
+{
+  return vm::bbox3d{
+    vm::min(handle.start(), handle.end()), vm::max(handle.start(), handle.end())};
+}
+
+vm::bbox3d handleBounds(const vm::polygon3d& handle)
+{
+  auto builder = vm::bbox3d::builder{};
+  builder.add(std::begin(handle), std::end(handle));
+  return builder.initialized() ? builder.bounds() : vm::bbox3d{};
+}
+
+bool mayHitPointHandle(
+  const vm::ray3d& pickRay,
+  const render::Camera& camera,
+  const vm::bbox3d& bounds,
+  const double handleRadius)
+{
+  // The perspective scaling factor is linear in the distance to the camera plane, so its
+  // maximum within the bounds is attained at one of the corners.
+  auto maxScaling = 0.0;
+  bounds.for_each_vertex([&](const auto& vertex) {
+    maxScaling = std::max(
+      maxScaling,
+      std::abs(static_cast<double>(camera.perspectiveScalingFactor(vm::vec3f{vertex}))));
+  });
+
+  // Camera::pickPointHandle uses a sphere with this radius, add some slack to account for
+  // rounding errors
+  const auto radius = 2.0 * handleRadius * maxScaling * 1.01 + vm::Cd::almost_zero();
+  const auto expanded = bounds.expand(radius);
+  return expanded.contains(pickRay.origin) || vm::intersect_ray_bbox(pickRay, expanded);
+}
+
 VertexHandleManagerBase::~VertexHandleManagerBase() = default;
 
 const mdl::HitType::Type VertexHandleManager::HandleHitType = mdl::HitType::freeType();
@@ -42,11 +87,11 @@ void VertexHandleManager::pick(
   const render::Camera& camera,
   mdl::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
+  const auto handleRadius = double(pref(Preferences::HandleRadius));
+  for (const auto* entry : findPickCandidates(pickRay, camera, handleRadius))
   {
-    if (
-      const auto distance = camera.pickPointHandle(
-        pickRay, position, double(pref(Preferences::HandleRadius))))
+    const auto& position = entry->first;
+    if (const auto distance = camera.pickPointHandle(pickRay, position, handleRadius))
     {
       const auto hitPoint = vm::point_at_distance(pickRay, *distance);
       const auto error = vm::squared_distance(pickRay, position).distance;
@@ -93,19 +138,21 @@ void EdgeHandleManager::pickGridHandle(
   const Grid& grid,
   mdl::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
+  const auto handleRadius = double(pref(Preferences::HandleRadius));
+  for (const auto* entry : findPickCandidates(pickRay, camera, handleRadius))
   {
+    const auto& position = entry->first;
     if (
-      const auto edgeDist = camera.pickLineSegmentHandle(
-        pickRay, position, double(pref(Preferences::HandleRadius))))
+      const auto edgeDist =
+        camera.pickLineSegmentHandle(pickRay, position, handleRadius))
     {
       if (
         const auto pointHandle =
           grid.snap(vm::point_at_distance(pickRay, *edgeDist), position))
       {
         if (
-          const auto pointDist = camera.pickPointHandle(
-            pickRay, *pointHandle, double(pref(Preferences::HandleRadius))))
+          const auto pointDist =
+            camera.pickPointHandle(pickRay, *pointHandle, handleRadius))
         {
           const auto hitPoint = vm::point_at_distance(pickRay, *pointDist);
           pickResult.addHit(mdl::Hit{
@@ -121,13 +168,13 @@ void EdgeHandleManager::pickCenterHandle(
   const render::Camera& camera,
   mdl::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
+  const auto handleRadius = double(pref(Preferences::HandleRadius));
+  for (const auto* entry : findPickCandidates(pickRay, camera, handleRadius))
   {
+    const auto& position = entry->first;
     const auto pointHandle = position.center();
 
-    if (
-      const auto pointDist = camera.pickPointHandle(
-        pickRay, pointHandle, double(pref(Preferences::HandleRadius))))
+    if (const auto pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius))
     {
       const auto hitPoint = vm::point_at_distance(pickRay, *pointDist);
       pickResult.addHit(mdl::Hit{HandleHitType, *pointDist, hitPoint, position});
@@ -174,8 +221,10 @@ void FaceHandleManager::pickGridHandle(
   const Grid& grid,
   mdl::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
+  const auto handleRadius = double(pref(Preferences::HandleRadius));
+  for (const auto* entry : findPickCandidates(pickRay, camera, handleRadius))
   {
+    const auto& position = entry->first;
     if (const auto plane = vm::from_points(std::begin(position), std::end(position)))
     {
       if (
@@ -186,8 +235,8 @@ void FaceHandleManager::pickGridHandle(
           grid.snap(vm::point_at_distance(pickRay, *distance), *plane);
 
         if (
-          const auto pointDist = camera.pickPointHandle(
-            pickRay, pointHandle, double(pref(Preferences::HandleRadius))))
+          const auto pointDist =
+            camera.pickPointHandle(pickRay, pointHandle, handleRadius))
         {
           const auto hitPoint = vm::point_at_distance(pickRay, *pointDist);
           pickResult.addHit(mdl::Hit{
@@ -203,13 +252,13 @@ void FaceHandleManager::pickCenterHandle(
   const render::Camera& camera,
   mdl::PickResult& pickResult) const
 {
-  for (const auto& [position, info] : m_handles)
+  const auto handleRadius = double(pref(Preferences::HandleRadius));
+  for (const auto* entry : findPickCandidates(pickRay, camera, handleRadius))
   {
+    const auto& position = entry->first;
     const auto pointHandle = position.center();
 
-    if (
-      const auto pointDist = camera.pickPointHandle(
-        pickRay, pointHandle, double(pref(Preferences::HandleRadius))))
+    if (const auto pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius))
     {
       const auto hitPoint = vm::point_at_distance(pickRay, *pointDist);
       pickResult.addHit(mdl::Hit{HandleHitType, *pointDist, hitPoint, position});
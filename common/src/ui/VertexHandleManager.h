@@ -22,10 +22,16 @@
 #include "mdl/BrushNode.h"
 #include "mdl/HitType.h"
 #include "mdl/PickResult.h"
+#include "octree.h"
 #include "render/Camera.h"
 
 #include "kdl/vector_set.h"
 
+#include "vm/bbox.h"
+#include "vm/polygon.h"
+#include "vm/ray.h"
+#include "vm/segment.h"
+
 #include <iterator>
 #include <map>
 #include <vector>
@@ -39,6 +45,27 @@ namespace tb::ui
 {
 class Grid;
 
+/**
+ * Returns the bounds of the given handle. These are used to store the handle in the
+ * spatial index of a handle manager.
+ */
+vm::bbox3d handleBounds(const vm::vec3d& handle);
+vm::bbox3d handleBounds(const vm::segment3d& handle);
+vm::bbox3d handleBounds(const vm::polygon3d& handle);
+
+/**
+ * Indicates whether the given pick ray might hit a point handle located within the given
+ * bounds when using Camera::pickPointHandle with the given handle radius.
+ *
+ * This is a conservative test: it may return true even if no point within the bounds can
+ * be hit, but it never returns false if such a point exists.
+ */
+bool mayHitPointHandle(
+  const vm::ray3d& pickRay,
+  const render::Camera& camera,
+  const vm::bbox3d& bounds,
+  double handleRadius);
+
 class VertexHandleManagerBase
 {
 public:
@@ -172,6 +199,12 @@ protected:
    */
   HandleMap m_handles;
 
+  /**
+   * Indexes the handles by their bounds. Stores pointers to the entries of m_handles,
+   * which remain valid until the entries are erased.
+   */
+  octree<double, HandleEntry*> m_handleTree;
+
   /**
    * The total number of selected handles, not counting duplicates.
    */
@@ -179,10 +212,15 @@ protected:
 
 public:
   VertexHandleManagerBaseT()
-    : m_selectedHandleCount(0)
+    : m_handleTree(64.0)
+    , m_selectedHandleCount(0)
   {
   }
 
+  // The handle tree stores pointers into the handle map
+  VertexHandleManagerBaseT(const VertexHandleManagerBaseT&) = delete;
+  VertexHandleManagerBaseT& operator=(const VertexHandleManagerBaseT&) = delete;
+
   ~VertexHandleManagerBaseT() override {}
 
 public:
@@ -260,6 +298,31 @@ public:
     return result;
   }
 
+  /**
+   * Returns all handles which are stored in a node of the spatial index whose bounds
+   * satisfy the given predicate. The predicate must return true for every box that
+   * contains a handle of interest. The caller has to test the returned handles
+   * individually.
+   *
+   * @tparam P the type of the predicate, which must be a unary function that maps a
+   * vm::bbox3d to bool
+   * @param predicate the predicate to apply to the node bounds
+   * @return a list containing the candidate handles
+   */
+  template <typename P>
+  HandleList findHandles(const P& predicate) const
+  {
+    const auto entries = m_handleTree.find_if(predicate);
+
+    auto result = HandleList{};
+    result.reserve(entries.size());
+    for (const auto* entry : entries)
+    {
+      result.push_back(entry->first);
+    }
+    return result;
+  }
+
 private:
   template <typename T, typename O>
   void collectHandles(const T& test, O out) const
@@ -316,8 +379,14 @@ public:
    */
   void add(const Handle& handle)
   {
-    m_handles[handle].inc(); // unknown value gets value constructed, which for HandleInfo
-                             // means its default constructor is called
+    // unknown value gets value constructed, which for HandleInfo means its default
+    // constructor is called
+    const auto [it, inserted] = m_handles.try_emplace(handle);
+    if (inserted)
+    {
+      m_handleTree.insert(handleBounds(handle), &*it);
+    }
+    it->second.inc();
   }
 
   /**
@@ -338,6 +407,7 @@ public:
       if (info.count == 0)
       {
         deselect(info);
+        m_handleTree.remove(&*it);
         m_handles.erase(it);
       }
       return true;
@@ -351,6 +421,7 @@ public:
    */
   void clear()
   {
+    m_handleTree.clear();
     m_handles.clear();
     m_selectedHandleCount = 0;
   }
@@ -458,8 +529,10 @@ private:
   void forEachCloseHandle(const H& otherHandle, F fun)
   {
     static const auto epsilon = 0.001 * 0.001;
-    for (auto& [handle, info] : m_handles)
+    const auto searchBounds = handleBounds(otherHandle).expand(0.001);
+    for (auto* entry : m_handleTree.find_intersectors(searchBounds))
     {
+      auto& [handle, info] = *entry;
       if (compare(otherHandle, handle, epsilon) == 0)
       {
         fun(info);
@@ -522,6 +595,24 @@ public:
     }
   }
 
+protected:
+  /**
+   * Returns the entries of all handles that might be hit by the given pick ray when
+   * picking a point handle within the handle's bounds.
+   *
+   * @param pickRay the picking ray
+   * @param camera the camera
+   * @param handleRadius the handle radius
+   * @return a list containing the candidate entries
+   */
+  std::vector<HandleEntry*> findPickCandidates(
+    const vm::ray3d& pickRay, const render::Camera& camera, const double handleRadius) const
+  {
+    return m_handleTree.find_if([&](const vm::bbox3d& bounds) {
+      return mayHitPointHandle(pickRay, camera, bounds, handleRadius);
+    });
+  }
+
 public:
   /**
    * Finds and returns all brushes in the given range which are incident to the given
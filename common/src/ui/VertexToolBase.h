@@ -207,11 +207,11 @@ public: // Handle selection
 
   void select(const Lasso& lasso, const bool modifySelection)
   {
-    const auto allHandles = handleManager().allHandles();
+    const auto candidates = handleManager().findHandles(lasso.boundsTest());
     auto selectedHandles = std::vector<H>{};
 
     lasso.selected(
-      std::begin(allHandles), std::end(allHandles), std::back_inserter(selectedHandles));
+      std::begin(candidates), std::end(candidates), std::back_inserter(selectedHandles));
     if (!modifySelection)
     {
       handleManager().deselectAll();
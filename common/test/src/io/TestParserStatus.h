@@ -34,6 +34,7 @@ class TestParserStatus : public ParserStatus
 private:
   static NullLogger _logger;
   std::map<LogLevel, std::vector<std::string>> m_messages;
+  std::vector<double> m_progress;
 
 public:
   TestParserStatus();
@@ -41,6 +42,7 @@ public:
 public:
   size_t countStatus(LogLevel level) const;
   const std::vector<std::string>& messages(LogLevel level) const;
+  const std::vector<double>& reportedProgress() const;
 
 private:
   void doProgress(double progress) override;
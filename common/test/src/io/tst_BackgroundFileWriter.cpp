@@ -0,0 +1,91 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "io/BackgroundFileWriter.h"
+#include "io/TestEnvironment.h"
+
+#include <filesystem>
+#include <string>
+
+#include "Catch2.h"
+
+namespace tb::io
+{
+
+TEST_CASE("BackgroundFileWriter")
+{
+  auto env = TestEnvironment{};
+  auto writer = BackgroundFileWriter{};
+
+  SECTION("has no result before anything was written")
+  {
+    CHECK_FALSE(writer.busy());
+    CHECK(writer.takeResult() == std::nullopt);
+  }
+
+  SECTION("writes file")
+  {
+    const auto contents = std::string(3 * 1024 * 1024, 'x');
+    REQUIRE(writer.write(env.dir() / "test.map", contents));
+
+    writer.wait();
+    CHECK_FALSE(writer.busy());
+    CHECK(
+      writer.progress()
+      == BackgroundFileWriterProgress{contents.size(), contents.size()});
+    CHECK(writer.takeResult() == Result<std::filesystem::path>{env.dir() / "test.map"});
+    CHECK(writer.takeResult() == std::nullopt);
+    CHECK(env.loadFile("test.map") == contents);
+  }
+
+  SECTION("replaces existing file")
+  {
+    env.createFile("test.map", "old content");
+
+    REQUIRE(writer.write(env.dir() / "test.map", "new content"));
+    writer.wait();
+
+    CHECK(writer.takeResult() == Result<std::filesystem::path>{env.dir() / "test.map"});
+    CHECK(env.loadFile("test.map") == "new content");
+  }
+
+  SECTION("reports errors")
+  {
+    REQUIRE(writer.write(env.dir() / "does_not_exist/test.map", "some content"));
+    writer.wait();
+
+    const auto result = writer.takeResult();
+    REQUIRE(result != std::nullopt);
+    CHECK(result->is_error());
+  }
+
+  SECTION("writes again after previous write has finished")
+  {
+    REQUIRE(writer.write(env.dir() / "test1.map", "some content"));
+    writer.wait();
+    REQUIRE(writer.write(env.dir() / "test2.map", "other content"));
+    writer.wait();
+
+    CHECK(writer.takeResult() == Result<std::filesystem::path>{env.dir() / "test2.map"});
+    CHECK(env.loadFile("test1.map") == "some content");
+    CHECK(env.loadFile("test2.map") == "other content");
+  }
+}
+
+} // namespace tb::io
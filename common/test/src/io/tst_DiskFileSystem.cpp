@@ -213,6 +213,19 @@ TEST_CASE("DiskFileSystemTest")
     checkOpenFile("anotherDir/test3.map");
     checkOpenFile("anotherDir/../anotherDir/./test3.map");
   }
+
+  SECTION("containerPath")
+  {
+    CHECK(
+      fs.containerPath("test.txt")
+      == Result<std::filesystem::path>{env.dir() / "test.txt"});
+    CHECK(
+      fs.containerPath("anotherDir/test3.map")
+      == Result<std::filesystem::path>{env.dir() / "anotherDir/test3.map"});
+    CHECK(
+      fs.containerPath("anotherDir")
+      == Result<std::filesystem::path>{Error{"'anotherDir' not found"}});
+  }
 }
 
 TEST_CASE("WritableDiskFileSystemTest")
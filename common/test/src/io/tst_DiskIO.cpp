@@ -27,6 +27,9 @@
 #include "io/TraversalMode.h"
 
 #include <filesystem>
+#include <fstream>
+#include <memory>
+#include <vector>
 
 #include "catch/Matchers.h"
 
@@ -114,6 +117,11 @@ TEST_CASE("DiskIO")
       CHECK(
         Disk::fixPath(env.dir() / "anotHERDIR/./SUBdirTEST/../SubdirTesT/TesT2.MAP")
         == env.dir() / "anotherDir/subDirTest/test2.map");
+
+      // the cached directory index is updated when a directory changes
+      CHECK(Disk::fixPath(env.dir() / "NEWFILE.txt") == env.dir() / "NEWFILE.txt");
+      std::ofstream{env.dir() / "newFile.txt"} << "new content";
+      CHECK(Disk::fixPath(env.dir() / "NEWFILE.txt") == env.dir() / "newFile.txt");
     }
   }
 
@@ -224,32 +232,53 @@ TEST_CASE("DiskIO")
       Disk::openFile("asdf/bleh"),
       MatchesAnyOf({
         // macOS / Linux
-        Result<std::shared_ptr<CFile>>{
+        Result<std::shared_ptr<MappedFile>>{
           Error{"Failed to open 'asdf/bleh': path does not denote a file"}},
         // Windows
-        Result<std::shared_ptr<CFile>>{
+        Result<std::shared_ptr<MappedFile>>{
           Error{"Failed to open 'asdf\\bleh': path does not denote a file"}},
       }));
     CHECK_THAT(
       Disk::openFile(env.dir() / "does/not/exist"),
       MatchesAnyOf({
         // macOS / Linux
-        Result<std::shared_ptr<CFile>>{Error{
+        Result<std::shared_ptr<MappedFile>>{Error{
           "Failed to open '" + (env.dir() / "does/not/exist").string()
           + "': path does not denote a file"}},
         // Windows
-        Result<std::shared_ptr<CFile>>{Error{
+        Result<std::shared_ptr<MappedFile>>{Error{
           "Failed to open '" + (env.dir() / "does\\not\\exist").string()
           + "': path does not denote a file"}},
       }));
     CHECK(
       Disk::openFile(env.dir() / "does_not_exist.txt")
-      == Result<std::shared_ptr<CFile>>{Error{
+      == Result<std::shared_ptr<MappedFile>>{Error{
         "Failed to open '" + (env.dir() / "does_not_exist.txt").string()
         + "': path does not denote a file"}});
 
     auto file = Disk::openFile(env.dir() / "test.txt");
     CHECK(file.is_success());
+    CHECK(file.value()->size() == 12);
+
+    auto reader = file.value()->reader();
+    CHECK(reader.readString(reader.size()) == "some content");
+
+    auto bufferedReader = file.value()->reader().subReaderFromBegin(5).buffer();
+    CHECK(bufferedReader.begin() == file.value()->begin() + 5);
+    CHECK(bufferedReader.readString(bufferedReader.size()) == "content");
+
+    // readers keep the mapping alive after the file is released
+    auto weakFile = std::weak_ptr<MappedFile>{};
+    {
+      auto ownedReader = [&]() {
+        auto ownedFile = Disk::openFile(env.dir() / "test.txt") | kdl::value();
+        weakFile = ownedFile;
+        return ownedFile->reader().subReaderFromBegin(5).buffer();
+      }();
+      CHECK_FALSE(weakFile.expired());
+      CHECK(ownedReader.readString(ownedReader.size()) == "content");
+    }
+    CHECK(weakFile.expired());
 
     file = Disk::openFile(env.dir() / "anotherDir/subDirTest/test2.map");
     CHECK(file.is_success());
@@ -259,6 +288,12 @@ TEST_CASE("DiskIO")
 
     file = Disk::openFile(env.dir() / "linkedTest2.map");
     CHECK(file.is_success());
+
+    env.createFile("empty.txt", "");
+    file = Disk::openFile(env.dir() / "empty.txt");
+    REQUIRE(file.is_success());
+    CHECK(file.value()->size() == 0);
+    CHECK(file.value()->reader().eof());
   }
 
   SECTION("withStream")
@@ -526,6 +561,47 @@ TEST_CASE("DiskIO")
     }
   }
 
+  SECTION("writeFileAtomically")
+  {
+    SECTION("write new file")
+    {
+      REQUIRE(Disk::pathInfo(env.dir() / "new.txt") == PathInfo::Unknown);
+
+      CHECK(Disk::writeFileAtomically(env.dir() / "new.txt", "new content").is_success());
+      CHECK(env.loadFile("new.txt") == "new content");
+      CHECK(Disk::pathInfo(env.dir() / "new.txt.tmp") == PathInfo::Unknown);
+    }
+
+    SECTION("replace existing file")
+    {
+      REQUIRE(Disk::pathInfo(env.dir() / "test.txt") == PathInfo::File);
+
+      auto progress = std::vector<size_t>{};
+      CHECK(Disk::writeFileAtomically(
+              env.dir() / "test.txt",
+              "other content",
+              [&](const auto bytesWritten) { progress.push_back(bytesWritten); })
+              .is_success());
+      CHECK(env.loadFile("test.txt") == "other content");
+      CHECK(progress == std::vector<size_t>{13});
+      CHECK(Disk::pathInfo(env.dir() / "test.txt.tmp") == PathInfo::Unknown);
+    }
+
+    SECTION("write into non existing directory")
+    {
+      CHECK(Disk::writeFileAtomically(env.dir() / "does_not_exist/new.txt", "new content")
+              .is_error());
+      CHECK(Disk::pathInfo(env.dir() / "does_not_exist") == PathInfo::Unknown);
+    }
+
+    SECTION("replace directory")
+    {
+      CHECK(Disk::writeFileAtomically(env.dir() / "dir1", "new content").is_error());
+      CHECK(Disk::pathInfo(env.dir() / "dir1") == PathInfo::Directory);
+      CHECK(Disk::pathInfo(env.dir() / "dir1.tmp") == PathInfo::Unknown);
+    }
+  }
+
   SECTION("moveFile")
   {
     SECTION("move non existing file")
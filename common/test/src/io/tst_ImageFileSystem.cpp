@@ -27,6 +27,7 @@
 #include "io/ZipFileSystem.h"
 
 #include <filesystem>
+#include <fstream>
 
 #include "catch/Matchers.h"
 
@@ -936,6 +937,16 @@ alias v30 "fov 30; sensitivity 7; bind mouse1 v90"
 alias v90 "fov 90; sensitivity 13; bind mouse1 v30"
 )");
   }
+
+  SECTION("containerPath")
+  {
+    const auto containerPath = fs->containerPath("pics/tag1.pcx") | kdl::value();
+    CHECK(containerPath.is_absolute());
+    CHECK(std::filesystem::is_regular_file(containerPath));
+    CHECK(containerPath.extension() != ".pcx");
+
+    CHECK(fs->containerPath("does_not_exist").is_error());
+  }
 }
 
 TEST_CASE("Flat ImageFileSystems")
@@ -982,6 +993,12 @@ TEST_CASE("Flat ImageFileSystems")
     reader.read(contents.data(), reader.size());
     CHECK(contents == cr8_czg_03_contents);
   }
+
+  SECTION("containerPath")
+  {
+    // the file system does not keep the path of the wad file
+    CHECK(fs->containerPath("cr8_czg_3.D").is_error());
+  }
 }
 
 TEST_CASE("WadFileSystem")
@@ -1012,4 +1029,44 @@ TEST_CASE("WadFileSystem")
   }
 }
 
+TEST_CASE("IdPakFileSystem")
+{
+#ifndef _WIN32
+  // On Windows, a mapped file cannot be replaced.
+  SECTION("Pak files can be replaced while pak file system exists")
+  {
+    const auto pakPath =
+      std::filesystem::current_path() / "fixture/test/io/Pak/idpak.pak";
+    const auto copyPath =
+      std::filesystem::current_path() / "fixture/test/io/Pak/idpak_2.pak";
+    const auto otherPath =
+      std::filesystem::current_path() / "fixture/test/io/Pak/idpak_3.pak";
+
+    REQUIRE_FALSE(std::filesystem::is_regular_file(copyPath));
+    REQUIRE_NOTHROW(std::filesystem::copy(pakPath, copyPath));
+    REQUIRE(std::filesystem::is_regular_file(copyPath));
+
+    {
+      const auto fs = openFS<IdPakFileSystem>(copyPath);
+      const auto file = fs->openFile("amnet.cfg") | kdl::value();
+
+      // the mapping keeps referring to the replaced file
+      {
+        auto stream = std::ofstream{otherPath, std::ios::out | std::ios::binary};
+        stream << "not a pak file";
+      }
+      REQUIRE_NOTHROW(std::filesystem::rename(otherPath, copyPath));
+
+      auto reader = file->reader();
+      CHECK(reader.readString(5) == "//\n//");
+    }
+
+    if (std::filesystem::is_regular_file(copyPath))
+    {
+      REQUIRE(std::filesystem::remove(copyPath));
+    }
+  }
+#endif
+}
+
 } // namespace tb::io
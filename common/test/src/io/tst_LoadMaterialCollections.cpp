@@ -21,6 +21,8 @@
 #include "TestUtils.h"
 #include "io/DiskFileSystem.h"
 #include "io/LoadMaterialCollections.h"
+#include "io/TestEnvironment.h"
+#include "io/TextureCache.h"
 #include "io/VirtualFileSystem.h"
 #include "io/WadFileSystem.h"
 #include "mdl/GameConfig.h"
@@ -146,7 +148,7 @@ TEST_CASE("loadMaterialCollections")
     };
 
     CHECK_THAT(
-      loadMaterialCollections(fs, materialConfig, createResource, logger),
+      loadMaterialCollections(fs, materialConfig, createResource, nullptr, logger),
       MatchesMaterialCollections({
         {
           "textures/",
@@ -177,6 +179,95 @@ TEST_CASE("loadMaterialCollections")
       }));
   }
 
+  SECTION("WAD file with texture cache")
+  {
+    const auto wadPath = workDir / "fixture/test/io/Wad/cr8_czg.wad";
+    fs.mount("", std::make_unique<DiskFileSystem>(workDir)); // to find the palette
+    fs.mount("textures", openFS<WadFileSystem>(wadPath));
+
+    const auto materialConfig = mdl::MaterialConfig{
+      "textures",
+      {".D"},
+      "fixture/test/palette.lmp",
+      "wad",
+      "",
+      {},
+    };
+
+    auto env = TestEnvironment{};
+    auto textureCache =
+      std::make_shared<TextureCache>(env.dir() / "cache", 64 * 1024 * 1024);
+
+    const auto getMaterialCollectionInfos = [&]() {
+      return loadMaterialCollections(
+               fs, materialConfig, createResource, textureCache, logger)
+             | kdl::transform([](const auto& materialCollections) {
+                 return kdl::vec_transform(
+                   materialCollections, makeMaterialCollectionInfo);
+               });
+    };
+
+    const auto uncachedInfos =
+      loadMaterialCollections(fs, materialConfig, createResource, nullptr, logger)
+      | kdl::transform([](const auto& materialCollections) {
+          return kdl::vec_transform(materialCollections, makeMaterialCollectionInfo);
+        });
+    REQUIRE(uncachedInfos.is_success());
+    REQUIRE(textureCache->size() == 0);
+
+    CHECK(getMaterialCollectionInfos() == uncachedInfos);
+
+    const auto cacheSize = textureCache->size();
+    CHECK(cacheSize > 0);
+
+    CHECK(getMaterialCollectionInfos() == uncachedInfos);
+    CHECK(textureCache->size() == cacheSize);
+  }
+
+  SECTION("Image files with texture cache")
+  {
+    const auto testDir = workDir / "fixture/test/io/Shader/loader/shader_with_image";
+    fs.mount("", std::make_unique<DiskFileSystem>(testDir));
+
+    const auto materialConfig = mdl::MaterialConfig{
+      "textures",
+      {".tga", ".png", ".jpg", ".jpeg"},
+      "",
+      std::nullopt,
+      "scripts",
+      {},
+    };
+
+    auto env = TestEnvironment{};
+    auto textureCache =
+      std::make_shared<TextureCache>(env.dir() / "cache", 64 * 1024 * 1024);
+
+    const auto getMaterialCollectionInfos = [&]() {
+      return loadMaterialCollections(
+               fs, materialConfig, createResource, textureCache, logger)
+             | kdl::transform([](const auto& materialCollections) {
+                 return kdl::vec_transform(
+                   materialCollections, makeMaterialCollectionInfo);
+               });
+    };
+
+    const auto uncachedInfos =
+      loadMaterialCollections(fs, materialConfig, createResource, nullptr, logger)
+      | kdl::transform([](const auto& materialCollections) {
+          return kdl::vec_transform(materialCollections, makeMaterialCollectionInfo);
+        });
+    REQUIRE(uncachedInfos.is_success());
+    REQUIRE(textureCache->size() == 0);
+
+    CHECK(getMaterialCollectionInfos() == uncachedInfos);
+
+    const auto cacheSize = textureCache->size();
+    CHECK(cacheSize > 0);
+
+    CHECK(getMaterialCollectionInfos() == uncachedInfos);
+    CHECK(textureCache->size() == cacheSize);
+  }
+
   SECTION("Quake 3 shaders")
   {
     SECTION("Linking shaders with images")
@@ -196,7 +287,7 @@ TEST_CASE("loadMaterialCollections")
         };
 
         CHECK_THAT(
-          loadMaterialCollections(fs, materialConfig, createResource, logger),
+          loadMaterialCollections(fs, materialConfig, createResource, nullptr, logger),
           MatchesMaterialCollections({
             {
               "textures/test",
@@ -224,7 +315,7 @@ TEST_CASE("loadMaterialCollections")
         };
 
         CHECK_THAT(
-          loadMaterialCollections(fs, materialConfig, createResource, logger),
+          loadMaterialCollections(fs, materialConfig, createResource, nullptr, logger),
           MatchesMaterialCollections({
             {
               "textures/test",
@@ -258,7 +349,7 @@ TEST_CASE("loadMaterialCollections")
         };
 
         CHECK_THAT(
-          loadMaterialCollections(fs, materialConfig, createResource, logger),
+          loadMaterialCollections(fs, materialConfig, createResource, nullptr, logger),
           MatchesMaterialCollections({
             {
               "textures/",
@@ -291,7 +382,7 @@ TEST_CASE("loadMaterialCollections")
       };
 
       CHECK_THAT(
-        loadMaterialCollections(fs, materialConfig, createResource, logger),
+        loadMaterialCollections(fs, materialConfig, createResource, nullptr, logger),
         MatchesMaterialCollections({
           {
             "textures/test",
@@ -323,7 +414,7 @@ TEST_CASE("loadMaterialCollections")
       };
 
       CHECK_THAT(
-        loadMaterialCollections(fs, materialConfig, createResource, logger),
+        loadMaterialCollections(fs, materialConfig, createResource, nullptr, logger),
         MatchesMaterialCollections({
           {
             "textures/",
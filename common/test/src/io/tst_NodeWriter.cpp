@@ -18,6 +18,7 @@
  */
 
 #include "TestUtils.h"
+#include "io/NodeSerializationCache.h"
 #include "io/NodeWriter.h"
 #include "mdl/BrushBuilder.h"
 #include "mdl/BrushFace.h"
@@ -37,6 +38,7 @@
 #include <fmt/format.h>
 
 #include <sstream>
+#include <string>
 #include <vector>
 
 #include "catch/Matchers.h"
@@ -295,6 +297,49 @@ TEST_CASE("NodeWriterTest.writeWorldspawnWithBrushInDefaultLayer")
   CHECK(actual == expected);
 }
 
+TEST_CASE("NodeWriterTest.writeMapReusesSerializationCache")
+{
+  const auto worldBounds = vm::bbox3d{8192.0};
+
+  auto map = mdl::WorldNode{{}, {}, mdl::MapFormat::Standard};
+
+  auto builder = mdl::BrushBuilder{map.mapFormat(), worldBounds};
+  auto* brushNode1 = new mdl::BrushNode{builder.createCube(64.0, "none") | kdl::value()};
+  auto* brushNode2 = new mdl::BrushNode{builder.createCube(32.0, "none") | kdl::value()};
+  map.defaultLayer()->addChild(brushNode1);
+  map.defaultLayer()->addChild(brushNode2);
+
+  const auto writeMap = [&]() {
+    auto str = std::stringstream{};
+    auto writer = NodeWriter{map, str};
+    writer.writeMap();
+    return str.str();
+  };
+
+  const auto firstWrite = writeMap();
+  CHECK(map.serializationCache().size() == 2u);
+
+  // writing an unchanged map produces the same output from the cache
+  CHECK(writeMap() == firstWrite);
+
+  // a changed brush is serialized again
+  brushNode1->setBrush(builder.createCube(16.0, "none") | kdl::value());
+  CHECK(map.serializationCache().find(mdl::MapFormat::Standard, *brushNode1) == nullptr);
+  CHECK(
+    map.serializationCache().find(mdl::MapFormat::Standard, *brushNode2) != nullptr);
+
+  const auto secondWrite = writeMap();
+  CHECK(secondWrite != firstWrite);
+  CHECK(secondWrite.find("( -8 -8 -8 )") != std::string::npos);
+
+  // entries of removed brushes are dropped
+  map.defaultLayer()->removeChild(brushNode1);
+  delete brushNode1;
+
+  writeMap();
+  CHECK(map.serializationCache().size() == 1u);
+}
+
 TEST_CASE("NodeWriterTest.writeWorldspawnWithBrushInCustomLayer")
 {
   const auto worldBounds = vm::bbox3d{8192.0};
@@ -0,0 +1,251 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Color.h"
+#include "io/TestEnvironment.h"
+#include "io/TextureCache.h"
+#include "mdl/Texture.h"
+#include "mdl/TextureBuffer.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::io
+{
+namespace
+{
+
+mdl::TextureBuffer makeBuffer(const size_t size, const unsigned char value)
+{
+  auto buffer = mdl::TextureBuffer{size};
+  std::fill_n(buffer.data(), size, value);
+  return buffer;
+}
+
+mdl::Texture makeTexture(const unsigned char value)
+{
+  auto buffers = std::vector<mdl::TextureBuffer>{};
+  buffers.push_back(makeBuffer(4 * 4 * 4, value));
+  buffers.push_back(makeBuffer(2 * 2 * 4, value));
+
+  return mdl::Texture{
+    4,
+    4,
+    Color{0.25f, 0.5f, 0.75f, 1.0f},
+    GL_RGBA,
+    mdl::TextureMask::On,
+    mdl::Q2EmbeddedDefaults{1, 2, 3},
+    std::move(buffers)};
+}
+
+TextureCacheKey makeKey(const std::string& name, const uint64_t parameterHash = 0)
+{
+  return TextureCacheKey{std::hash<std::string>{}(name), 0, 0, parameterHash};
+}
+
+std::vector<std::filesystem::path> entryFiles(const std::filesystem::path& directory)
+{
+  auto result = std::vector<std::filesystem::path>{};
+  for (const auto& entry : std::filesystem::directory_iterator{directory})
+  {
+    if (entry.path().extension() == ".tbtex")
+    {
+      result.push_back(entry.path());
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("makeTextureCacheKey")
+{
+  auto env = TestEnvironment{};
+  env.createFile("textures.pak", "some contents");
+  const auto containerPath = env.dir() / "textures.pak";
+
+  const auto key = makeTextureCacheKey(containerPath, "textures/some.png", 1);
+  REQUIRE(key.is_success());
+
+  CHECK(makeTextureCacheKey(containerPath, "textures/some.png", 1) == key);
+  CHECK(makeTextureCacheKey(containerPath, "textures/other.png", 1) != key);
+  CHECK(makeTextureCacheKey(containerPath, "textures/some.png", 2) != key);
+
+  SECTION("changes when the container changes")
+  {
+    std::filesystem::resize_file(containerPath, 64);
+    CHECK(makeTextureCacheKey(containerPath, "textures/some.png", 1) != key);
+  }
+
+  SECTION("returns an error if the container does not exist")
+  {
+    CHECK(makeTextureCacheKey(env.dir() / "missing.pak", "textures/some.png", 1)
+            .is_error());
+  }
+}
+
+TEST_CASE("TextureCache")
+{
+  auto env = TestEnvironment{};
+  const auto cacheDir = env.dir() / "cache";
+
+  auto cache = TextureCache{cacheDir, 1024 * 1024};
+
+  SECTION("returns an error for missing entries")
+  {
+    CHECK(cache.load(makeKey("some texture")).is_error());
+  }
+
+  SECTION("loads stored textures")
+  {
+    const auto key = makeKey("some texture");
+    REQUIRE(cache.store(key, makeTexture(0x33)).is_success());
+    CHECK(cache.size() > 0);
+
+    const auto result = cache.load(key);
+    REQUIRE(result.is_success());
+
+    const auto& texture = result.value();
+    CHECK(texture.width() == 4);
+    CHECK(texture.height() == 4);
+    CHECK(texture.averageColor() == Color{0.25f, 0.5f, 0.75f, 1.0f});
+    CHECK(texture.format() == GL_RGBA);
+    CHECK(texture.mask() == mdl::TextureMask::On);
+    CHECK(
+      texture.embeddedDefaults()
+      == mdl::EmbeddedDefaults{mdl::Q2EmbeddedDefaults{1, 2, 3}});
+
+    const auto& buffers = texture.buffersIfLoaded();
+    REQUIRE(buffers.size() == 2);
+    CHECK(buffers[0].size() == 4 * 4 * 4);
+    CHECK(buffers[1].size() == 2 * 2 * 4);
+    CHECK(std::all_of(
+      buffers[0].data(), buffers[0].data() + buffers[0].size(), [](const auto c) {
+        return c == 0x33;
+      }));
+  }
+
+  SECTION("distinguishes keys")
+  {
+    REQUIRE(cache.store(makeKey("some texture"), makeTexture(0x33)).is_success());
+
+    CHECK(cache.load(makeKey("other texture")).is_error());
+    CHECK(cache.load(makeKey("some texture", 1)).is_error());
+  }
+
+  SECTION("does not store textures without buffers")
+  {
+    CHECK(cache.store(makeKey("some texture"), mdl::Texture{4, 4}).is_error());
+    CHECK(cache.size() == 0);
+  }
+
+  SECTION("removes invalid entries")
+  {
+    const auto key = makeKey("some texture");
+    REQUIRE(cache.store(key, makeTexture(0x33)).is_success());
+
+    const auto files = entryFiles(cacheDir);
+    REQUIRE(files.size() == 1);
+    std::filesystem::resize_file(files.front(), 64);
+
+    CHECK(cache.load(key).is_error());
+    CHECK(entryFiles(cacheDir).empty());
+    CHECK(cache.size() == 0);
+  }
+
+  SECTION("finds entries written by another instance")
+  {
+    const auto key = makeKey("some texture");
+    REQUIRE(cache.store(key, makeTexture(0x33)).is_success());
+
+    auto otherCache = TextureCache{cacheDir, 1024 * 1024};
+    CHECK(otherCache.size() == 0);
+    CHECK(otherCache.load(key).is_success());
+    CHECK(otherCache.size() == cache.size());
+  }
+
+  SECTION("evicts least recently used entries")
+  {
+    const auto key1 = makeKey("texture 1");
+    const auto key2 = makeKey("texture 2");
+    const auto key3 = makeKey("texture 3");
+
+    REQUIRE(cache.store(key1, makeTexture(0x11)).is_success());
+    const auto entrySize = cache.size();
+
+    cache.setMaxSize(2 * entrySize);
+    REQUIRE(cache.store(key2, makeTexture(0x22)).is_success());
+    REQUIRE(cache.load(key1).is_success());
+    REQUIRE(cache.store(key3, makeTexture(0x33)).is_success());
+
+    CHECK(cache.size() == 2 * entrySize);
+    CHECK(entryFiles(cacheDir).size() == 2);
+    CHECK(cache.load(key1).is_success());
+    CHECK(cache.load(key2).is_error());
+    CHECK(cache.load(key3).is_success());
+
+    cache.setMaxSize(entrySize);
+    CHECK(cache.size() == entrySize);
+    CHECK(cache.load(key1).is_error());
+    CHECK(cache.load(key3).is_success());
+  }
+
+  SECTION("keeps entries whose files cannot be removed")
+  {
+    const auto key1 = makeKey("texture 1");
+    const auto key2 = makeKey("texture 2");
+
+    REQUIRE(cache.store(key1, makeTexture(0x11)).is_success());
+    const auto entrySize = cache.size();
+
+    // a non-empty directory in place of the entry file cannot be removed
+    const auto files = entryFiles(cacheDir);
+    REQUIRE(files.size() == 1);
+    std::filesystem::remove(files.front());
+    std::filesystem::create_directories(files.front() / "blocked");
+
+    cache.setMaxSize(entrySize);
+    REQUIRE(cache.store(key2, makeTexture(0x22)).is_success());
+
+    // the entry is kept as the least recently used entry so that it is evicted again
+    CHECK(cache.size() == 2 * entrySize);
+
+    std::filesystem::remove_all(files.front());
+    cache.setMaxSize(entrySize);
+    CHECK(cache.size() == entrySize);
+    CHECK(cache.load(key2).is_success());
+  }
+
+  SECTION("clears all entries")
+  {
+    REQUIRE(cache.store(makeKey("texture 1"), makeTexture(0x11)).is_success());
+    REQUIRE(cache.store(makeKey("texture 2"), makeTexture(0x22)).is_success());
+
+    cache.clear();
+    CHECK(cache.size() == 0);
+    CHECK(entryFiles(cacheDir).empty());
+  }
+}
+
+} // namespace tb::io
@@ -32,12 +32,15 @@
 #include "mdl/PatchNode.h"
 #include "mdl/WorldNode.h"
 
+#include "kdl/string_utils.h"
+
 #include "vm/mat.h"
 #include "vm/mat_ext.h"
 #include "vm/vec.h"
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <filesystem>
 #include <string>
 
@@ -1941,6 +1944,119 @@ TEST_CASE("WorldReader.parseProtectedEntityProperties")
   }
 }
 
+TEST_CASE("WorldReader.parseManyEntitiesAndReportIssuesInFileOrder")
+{
+  const auto data = R"(
+{
+"classname" "worldspawn"
+"message" "yay"
+"message" "duplicate"
+}
+// a comment with a { brace
+{
+"classname" "info_player_start"
+"origin" "1 2 3"
+"origin" "4 5 6"
+}
+; a Heretic 2 comment with a } brace
+{
+"classname" "func_door"
+"targetname" "door { }"
+{
+( -0 -0 -16 ) ( -0 -0  -0 ) ( 64 -0 -16 ) {none 0 0 0 1 1
+( -0 -0 -16 ) ( -0 64 -16 ) ( -0 -0  -0 ) none 0 0 0 1 1
+( -0 -0 -16 ) ( 64 -0 -16 ) ( -0 64 -16 ) none 0 0 0 1 1
+( 64 64  -0 ) ( -0 64  -0 ) ( 64 64 -16 ) none 0 0 0 1 1
+( 64 64  -0 ) ( 64 64 -16 ) ( 64 -0  -0 ) none 0 0 0 1 1
+( 64 64  -0 ) ( 64 -0  -0 ) ( -0 64  -0 ) none 0 0 0 1 1
+( 0 0 0 ) ( 0 0 0 ) ( 0 0 0 ) none 0 0 0 1 1
+}
+}
+{
+"classname" "light"
+"light" "300"
+"light" "200"
+}
+)";
+
+  const auto worldBounds = vm::bbox3d{8192.0};
+
+  SECTION("Entities are read in file order")
+  {
+    auto status = TestParserStatus{};
+    auto reader = WorldReader{data, mdl::MapFormat::Standard, {}};
+
+    auto world = reader.read(worldBounds, status);
+    REQUIRE(world != nullptr);
+    CHECK(*world->entity().property("message") == "yay");
+
+    const auto* defaultLayer = world->defaultLayer();
+    REQUIRE(defaultLayer->childCount() == 3u);
+
+    const auto* playerStart =
+      dynamic_cast<const mdl::EntityNode*>(defaultLayer->children()[0]);
+    REQUIRE(playerStart != nullptr);
+    CHECK(*playerStart->entity().property("origin") == "1 2 3");
+
+    const auto* door = dynamic_cast<const mdl::EntityNode*>(defaultLayer->children()[1]);
+    REQUIRE(door != nullptr);
+    CHECK(*door->entity().property("targetname") == "door { }");
+    REQUIRE(door->childCount() == 1u);
+
+    const auto* brushNode = dynamic_cast<const mdl::BrushNode*>(door->children().front());
+    REQUIRE(brushNode != nullptr);
+    CHECK(brushNode->brush().faceCount() == 6u);
+    CHECK(brushNode->lineNumber() == 17u);
+
+    const auto* light = dynamic_cast<const mdl::EntityNode*>(defaultLayer->children()[2]);
+    REQUIRE(light != nullptr);
+    CHECK(*light->entity().property("light") == "300");
+
+    CHECK(
+      status.messages(LogLevel::Warn)
+      == std::vector<std::string>{
+        "Ignoring duplicate entity property 'message' (at line 5, column 1)",
+        "Ignoring duplicate entity property 'origin' (at line 11, column 1)",
+        "Ignoring duplicate entity property 'light' (at line 30, column 1)",
+      });
+    REQUIRE(status.messages(LogLevel::Error).size() == 1u);
+    CHECK_THAT(
+      status.messages(LogLevel::Error).front(),
+      Catch::Matchers::StartsWith("Skipping face: ")
+        && Catch::Matchers::EndsWith("(at line 23, column 57)"));
+
+    const auto& progress = status.reportedProgress();
+    REQUIRE(!progress.empty());
+    CHECK(std::is_sorted(progress.begin(), progress.end()));
+    CHECK(progress.back() == 1.0);
+  }
+
+  SECTION("Errors in any entity are reported")
+  {
+    const auto invalidData = kdl::str_replace_every(data, "\"light\" \"200\"", "\"light\"");
+
+    auto status = TestParserStatus{};
+    auto reader = WorldReader{invalidData, mdl::MapFormat::Standard, {}};
+
+    CHECK_THROWS_WITH(
+      reader.read(worldBounds, status),
+      Catch::Matchers::StartsWith("At line 31, column 1:"));
+
+    // the messages of the entities preceding the error are reported once
+    CHECK(
+      status.messages(LogLevel::Warn)
+      == std::vector<std::string>{
+        "Ignoring duplicate entity property 'message' (at line 5, column 1)",
+        "Ignoring duplicate entity property 'origin' (at line 11, column 1)",
+      });
+    REQUIRE(status.messages(LogLevel::Error).size() == 1u);
+    CHECK_THAT(
+      status.messages(LogLevel::Error).front(),
+      Catch::Matchers::StartsWith("Skipping face: ")
+        && Catch::Matchers::EndsWith("(at line 23, column 57)"));
+  }
+}
+
 TEST_CASE("WorldReader.parseUnknownFormatEmptyMap")
 {
   const auto data = R"(
@@ -108,10 +108,14 @@ Result<std::unique_ptr<WorldNode>> TestGame::loadMap(
 
 Result<void> TestGame::writeMap(WorldNode& world, const std::filesystem::path& path) const
 {
-  return io::Disk::withOutputStream(path, [&](auto& stream) {
-    auto writer = io::NodeWriter{world, stream};
-    writer.writeMap();
-  });
+  return io::Disk::withOutputStream(
+    path, [&](auto& stream) { writeMapToStream(world, stream); });
+}
+
+void TestGame::writeMapToStream(WorldNode& world, std::ostream& stream) const
+{
+  auto writer = io::NodeWriter{world, stream};
+  writer.writeMap();
 }
 
 Result<void> TestGame::exportMap(
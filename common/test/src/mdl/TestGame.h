@@ -73,6 +73,7 @@ public:
     Logger& logger) const override;
   Result<void> writeMap(
     WorldNode& world, const std::filesystem::path& path) const override;
+  void writeMapToStream(WorldNode& world, std::ostream& stream) const override;
   Result<void> exportMap(
     WorldNode& world, const io::ExportOptions& options) const override;
 
@@ -24,6 +24,7 @@
 #include "mdl/BrushNode.h"
 #include "mdl/Material.h"
 #include "mdl/Texture.h"
+#include "mdl/UVCoordSystem.h"
 
 #include "kdl/range_to_vector.h"
 #include "kdl/result.h"
@@ -31,6 +32,8 @@
 #include "kdl/vector_utils.h"
 
 #include "vm/approx.h"
+#include "vm/mat.h"
+#include "vm/mat_ext.h"
 #include "vm/polygon.h"
 #include "vm/segment.h"
 #include "vm/vec.h"
@@ -267,6 +270,45 @@ TEST_CASE("BrushTest.cloneFaceAttributesFrom")
   CHECK(newBrush == brush);
 }
 
+TEST_CASE("BrushTest.copySharesGeometryAndUVCoordSystems")
+{
+  const auto worldBounds = vm::bbox3d{4096.0};
+
+  const auto brushBuilder = BrushBuilder{MapFormat::Valve, worldBounds};
+  const auto brush = brushBuilder.createCube(64.0, "material") | kdl::value();
+
+  auto copy = brush;
+  CHECK(copy == brush);
+
+  for (size_t i = 0; i < brush.faceCount(); ++i)
+  {
+    CHECK(copy.face(i).geometry() == brush.face(i).geometry());
+    CHECK(&copy.face(i).uvCoordSystem() == &brush.face(i).uvCoordSystem());
+  }
+
+  SECTION("Changing the UV coordinate system of a face unshares it")
+  {
+    const auto uAxis = brush.face(0).uAxis();
+
+    copy.face(0).rotateUV(45.0f);
+
+    CHECK(&copy.face(0).uvCoordSystem() != &brush.face(0).uvCoordSystem());
+    CHECK(&copy.face(1).uvCoordSystem() == &brush.face(1).uvCoordSystem());
+    CHECK(brush.face(0).uAxis() == uAxis);
+    CHECK(copy.face(0).uAxis() != uAxis);
+  }
+
+  SECTION("Changing the geometry of a brush unshares it")
+  {
+    const auto transform = vm::translation_matrix(vm::vec3d{16, 0, 0});
+    REQUIRE(copy.transform(worldBounds, transform, false).is_success());
+
+    CHECK(copy.bounds() != brush.bounds());
+    CHECK(brush.bounds() == vm::bbox3d{32.0});
+    CHECK(copy.face(0).geometry() != brush.face(0).geometry());
+  }
+}
+
 TEST_CASE("BrushTest.clip")
 {
   const auto worldBounds = vm::bbox3d{4096.0};
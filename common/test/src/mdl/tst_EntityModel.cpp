@@ -33,6 +33,7 @@
 #include "vm/bbox.h"
 #include "vm/intersection.h"
 
+#include <chrono>
 #include <filesystem>
 
 #include "Catch2.h"
@@ -145,4 +146,65 @@ TEST_CASE("EntityModelTest.buildRenderer.defaultSkinIndex")
   CHECK(renderer1 != nullptr);
   CHECK(renderer2 != nullptr);
 }
+
+TEST_CASE("EntityModelTest.pickData")
+{
+  using namespace std::chrono_literals;
+
+  auto modelData = EntityModelData{PitchType::Normal, Orientation::Oriented};
+  modelData.addFrame("frame 1", vm::bbox3f{0, 8});
+  modelData.addFrame("frame 2", vm::bbox3f{0, 8});
+
+  auto& frame1 = modelData.frames()[0];
+  auto& frame2 = modelData.frames()[1];
+
+  auto& surface = modelData.addSurface("surface", 2);
+
+  auto size = render::IndexRangeMap::Size{};
+  size.inc(render::PrimType::Triangles, 1);
+
+  auto builder = render::IndexRangeMapBuilder<EntityModelVertex::Type>{3, size};
+  builder.addTriangle(
+    EntityModelVertex{{0, 0, 0}, {0, 0}},
+    EntityModelVertex{{8, 0, 0}, {1, 0}},
+    EntityModelVertex{{0, 8, 0}, {0, 1}});
+
+  surface.addMesh(frame1, builder.vertices(), builder.indices());
+  surface.addMesh(frame2, builder.vertices(), builder.indices());
+
+  const auto ray = vm::ray3f{vm::vec3f{1, 1, 8}, vm::vec3f{0, 0, -1}};
+
+  CHECK(!frame1.hasPickData());
+  CHECK(!frame2.hasPickData());
+  CHECK(modelData.memoryStats().framesWithPickData == 0);
+  CHECK(modelData.memoryStats().pickDataBytes == 0);
+
+  CHECK(frame1.intersect(ray) == vm::optional_approx<float>{8.0f});
+  CHECK(frame1.hasPickData());
+  CHECK(!frame2.hasPickData());
+
+  const auto stats = modelData.memoryStats();
+  CHECK(stats.frameCount == 2);
+  CHECK(stats.framesWithPickData == 1);
+  CHECK(stats.pickDataBytes == frame1.pickDataSize());
+  CHECK(stats.vertexBytes > 0);
+
+  SECTION("keeps recently used pick data")
+  {
+    CHECK(modelData.releasePickData(std::chrono::steady_clock::now() - 1min) == 0);
+    CHECK(frame1.hasPickData());
+  }
+
+  SECTION("releases unused pick data")
+  {
+    CHECK(
+      modelData.releasePickData(std::chrono::steady_clock::now() + 1min)
+      == stats.pickDataBytes);
+    CHECK(!frame1.hasPickData());
+    CHECK(modelData.memoryStats().pickDataBytes == 0);
+
+    CHECK(frame1.intersect(ray) == vm::optional_approx<float>{8.0f});
+    CHECK(frame1.hasPickData());
+  }
+}
 } // namespace tb::mdl
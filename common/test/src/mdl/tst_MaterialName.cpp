@@ -0,0 +1,90 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/MaterialName.h"
+
+#include "kdl/parallel.h"
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::mdl
+{
+
+TEST_CASE("MaterialName")
+{
+  SECTION("Default constructed names are empty")
+  {
+    CHECK(MaterialName{}.empty());
+    CHECK(MaterialName{} == MaterialName{""});
+  }
+
+  SECTION("Equal names share their storage")
+  {
+    const auto name = std::string{"some_material"};
+    const auto n1 = MaterialName{name};
+    const auto n2 = MaterialName{"some_material"};
+
+    CHECK(n1 == n2);
+    CHECK(&n1.str() == &n2.str());
+    CHECK(std::hash<MaterialName>{}(n1) == std::hash<MaterialName>{}(n2));
+    CHECK(n1 != MaterialName{"other_material"});
+  }
+
+  SECTION("Names are case sensitive, but share their lower case name")
+  {
+    const auto n1 = MaterialName{"Some_Material"};
+    const auto n2 = MaterialName{"SOME_MATERIAL"};
+    const auto n3 = MaterialName{"some_material"};
+
+    CHECK(n1 != n2);
+    CHECK(n1.str() == "Some_Material");
+    CHECK(n1.lower() == n3);
+    CHECK(n2.lower() == n3);
+    CHECK(n3.lower() == n3);
+  }
+
+  SECTION("Finding a name does not intern it")
+  {
+    const auto count = MaterialName::internedCount();
+    CHECK(MaterialName::find("never_interned_material") == std::nullopt);
+    CHECK(MaterialName::internedCount() == count);
+
+    const auto name = MaterialName{"found_material"};
+    CHECK(MaterialName::find("found_material") == name);
+    CHECK(MaterialName::find("FOUND_MATERIAL") == std::nullopt);
+  }
+
+  SECTION("Names can be interned concurrently")
+  {
+    const auto names = kdl::vec_parallel_transform(
+      std::vector<size_t>(1000), [](const auto) { return MaterialName{"Concurrent"}; });
+
+    CHECK(std::all_of(names.begin(), names.end(), [&](const auto& name) {
+      return name == names.front();
+    }));
+    CHECK(names.front().lower() == MaterialName{"concurrent"});
+  }
+}
+
+} // namespace tb::mdl
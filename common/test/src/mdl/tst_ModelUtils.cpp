@@ -333,6 +333,64 @@ TEST_CASE("ModelUtils.collectContainedNodes")
       std::vector<Node*>{&groupNode, &entityNode, &brushNode, &patchNode}));
 }
 
+TEST_CASE("ModelUtils.collectTouchingAndContainedNodesInWorld")
+{
+  constexpr auto worldBounds = vm::bbox3d{8192.0};
+  constexpr auto mapFormat = MapFormat::Quake3;
+
+  const auto createBrushNode = [&](const vm::bbox3d& bounds) {
+    return new BrushNode{
+      BrushBuilder{mapFormat, worldBounds}.createCuboid(bounds, "material")
+      | kdl::value()};
+  };
+
+  auto worldNode = WorldNode{{}, {}, mapFormat};
+  auto* layerNode = worldNode.defaultLayer();
+
+  auto* queryBrushNode = createBrushNode({{0, 0, 0}, {128, 128, 128}});
+  auto* insideBrushNode = createBrushNode({{32, 32, 32}, {64, 64, 64}});
+  auto* touchingBrushNode = createBrushNode({{96, 96, 96}, {192, 192, 192}});
+  auto* farBrushNode = createBrushNode({{1024, 1024, 1024}, {1088, 1088, 1088}});
+
+  auto* brushEntityNode = new EntityNode{Entity{}};
+  auto* entityBrushNode = createBrushNode({{16, 16, 16}, {48, 48, 48}});
+  brushEntityNode->addChild(entityBrushNode);
+
+  auto* groupNode = new GroupNode{Group{"group"}};
+  auto* groupedBrushNode = createBrushNode({{-64, -64, -64}, {16, 16, 16}});
+  groupNode->addChild(groupedBrushNode);
+
+  auto* farGroupNode = new GroupNode{Group{"far group"}};
+  farGroupNode->addChild(createBrushNode({{2048, 0, 0}, {2112, 64, 64}}));
+
+  layerNode->addChildren(
+    {queryBrushNode,
+     insideBrushNode,
+     touchingBrushNode,
+     farBrushNode,
+     brushEntityNode,
+     groupNode,
+     farGroupNode});
+
+  // the query brush is not part of the result even though it is in the world
+  CHECK_THAT(
+    collectTouchingNodes({&worldNode}, {queryBrushNode}),
+    Catch::Matchers::Equals(std::vector<Node*>{
+      insideBrushNode, touchingBrushNode, entityBrushNode, groupNode}));
+
+  CHECK_THAT(
+    collectContainedNodes({&worldNode}, {queryBrushNode}),
+    Catch::Matchers::Equals(std::vector<Node*>{insideBrushNode, entityBrushNode}));
+
+  // the results are the same as when the objects are not looked up in the node tree
+  CHECK(
+    collectTouchingNodes({&worldNode}, {queryBrushNode, farBrushNode})
+    == collectTouchingNodes({layerNode}, {queryBrushNode, farBrushNode}));
+  CHECK(
+    collectContainedNodes({&worldNode}, {queryBrushNode, farBrushNode})
+    == collectContainedNodes({layerNode}, {queryBrushNode, farBrushNode}));
+}
+
 TEST_CASE("ModelUtils.collectSelectedNodes")
 {
   constexpr auto worldBounds = vm::bbox3d{8192.0};
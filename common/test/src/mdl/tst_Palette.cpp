@@ -17,12 +17,18 @@
  along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "Color.h"
 #include "Result.h"
 #include "io/DiskIO.h"
+#include "io/Reader.h"
 #include "mdl/Palette.h"
+#include "mdl/TextureBuffer.h"
 
 #include "kdl/result.h"
 
+#include <array>
+#include <vector>
+
 #include "Catch2.h"
 
 namespace tb::mdl
@@ -214,4 +220,88 @@ TEST_CASE("loadPalette")
   CHECK(loadPalette(*file, filePath) == expectedPalette);
 }
 
+TEST_CASE("indexedToRgba")
+{
+  auto paletteData = std::vector<unsigned char>{};
+  for (size_t i = 0; i < 256; ++i)
+  {
+    paletteData.push_back(static_cast<unsigned char>(i));
+    paletteData.push_back(static_cast<unsigned char>(255 - i));
+    paletteData.push_back(static_cast<unsigned char>(i / 2));
+  }
+  const auto palette = makePalette(paletteData, PaletteColorFormat::Rgb) | kdl::value();
+
+  // more than one SIMD block and a remainder
+  const auto pixelCount = GENERATE(size_t(1), size_t(8), size_t(37));
+  const auto withTransparentIndex = GENERATE(false, true);
+  const auto transparency =
+    GENERATE(PaletteTransparency::Opaque, PaletteTransparency::Index255Transparent);
+
+  CAPTURE(pixelCount, withTransparentIndex, transparency);
+
+  auto indices = std::vector<unsigned char>{};
+  for (size_t i = 0; i < pixelCount; ++i)
+  {
+    indices.push_back(static_cast<unsigned char>((i * 7) % 255));
+  }
+  if (withTransparentIndex)
+  {
+    indices.back() = 255;
+  }
+
+  auto expectedImage = std::vector<unsigned char>{};
+  auto expectedSum = std::array<size_t, 3>{0, 0, 0};
+  for (const auto index : indices)
+  {
+    for (size_t c = 0; c < 3; ++c)
+    {
+      expectedImage.push_back(paletteData[size_t(index) * 3 + c]);
+      expectedSum[c] += paletteData[size_t(index) * 3 + c];
+    }
+    expectedImage.push_back(
+      transparency == PaletteTransparency::Index255Transparent && index == 255 ? 0x00
+                                                                               : 0xFF);
+  }
+  const auto expectedAverageColor = Color{
+    float(expectedSum[0]) / (255.0f * float(pixelCount)),
+    float(expectedSum[1]) / (255.0f * float(pixelCount)),
+    float(expectedSum[2]) / (255.0f * float(pixelCount)),
+    1.0f};
+  const auto expectedTransparency =
+    withTransparentIndex && transparency == PaletteTransparency::Index255Transparent;
+
+  SECTION("from span")
+  {
+    auto rgbaImage = TextureBuffer{pixelCount * 4};
+    auto averageColor = Color{};
+    CHECK(
+      palette.indexedToRgba(indices, rgbaImage, transparency, averageColor)
+      == expectedTransparency);
+    CHECK(
+      std::vector<unsigned char>(rgbaImage.data(), rgbaImage.data() + rgbaImage.size())
+      == expectedImage);
+    CHECK(averageColor == expectedAverageColor);
+  }
+
+  SECTION("from reader")
+  {
+    indices.push_back(0xAB);
+    auto reader = io::Reader::from(
+      reinterpret_cast<const char*>(indices.data()),
+      reinterpret_cast<const char*>(indices.data() + indices.size()));
+
+    auto rgbaImage = TextureBuffer{pixelCount * 4};
+    auto averageColor = Color{};
+    CHECK(
+      palette.indexedToRgba(reader, pixelCount, rgbaImage, transparency, averageColor)
+      == expectedTransparency);
+    CHECK(
+      std::vector<unsigned char>(rgbaImage.data(), rgbaImage.data() + rgbaImage.size())
+      == expectedImage);
+    CHECK(averageColor == expectedAverageColor);
+    CHECK(reader.readUnsignedChar<unsigned char>() == 0xAB);
+    CHECK_THROWS(palette.indexedToRgba(reader, 1, rgbaImage, transparency, averageColor));
+  }
+}
+
 } // namespace tb::mdl
@@ -22,6 +22,7 @@
 #include "mdl/Resource.h"
 
 #include "kdl/reflection_impl.h"
+#include "kdl/vector_utils.h"
 
 #include "Catch2.h"
 
@@ -139,6 +140,49 @@ TEST_CASE("Resource")
     }
   }
 
+  SECTION("Task runner declines loading task")
+  {
+    auto resource = ResourceT{[]() { return Result<MockResource>{MockResource{}}; }};
+    const auto decliningTaskRunner = [](auto) {
+      return std::future<std::unique_ptr<TaskResult>>{};
+    };
+
+    CHECK(!resource.process(decliningTaskRunner, processContext));
+    CHECK(std::holds_alternative<ResourceUnloaded<MockResource>>(resource.state()));
+    CHECK(resource.needsLoading());
+
+    CHECK(resource.process(taskRunner, processContext));
+    CHECK(std::holds_alternative<ResourceLoading<MockResource>>(resource.state()));
+    CHECK(!resource.needsLoading());
+  }
+
+  SECTION("Dropping a loading resource cancels its task")
+  {
+    auto loaderCalled = false;
+    auto resource = ResourceT{[&]() {
+      loaderCalled = true;
+      return Result<MockResource>{MockResource{}};
+    }};
+
+    setResourceState<ResourceLoading<MockResource>>(
+      resource, mockTaskRunner, processContext);
+    resource.drop();
+    REQUIRE(resource.isDropped());
+
+    auto [promise, task] = kdl::vec_pop_front(mockTaskRunner.tasks);
+    CHECK(task() == nullptr);
+    CHECK(!loaderCalled);
+  }
+
+  SECTION("Accessing an unloaded resource marks it as requested")
+  {
+    auto resource = ResourceT{[]() { return Result<MockResource>{MockResource{}}; }};
+    CHECK(!resource.isRequested());
+
+    CHECK(resource.get() == nullptr);
+    CHECK(resource.isRequested());
+  }
+
   SECTION("Resource loading succeeds")
   {
     auto mockUploadCall = std::optional<bool>{};
@@ -0,0 +1,223 @@
+/*
+ Copyright (C) 2023 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Result.h"
+#include "mdl/Resource.h"
+#include "mdl/ResourceLoadQueue.h"
+
+#include "kdl/reflection_impl.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include "Catch2.h"
+
+namespace tb::mdl
+{
+namespace
+{
+
+class MockTaskResult : public TaskResult
+{
+public:
+  int value;
+
+  explicit MockTaskResult(const int value_)
+    : value{value_}
+  {
+  }
+};
+
+int getValue(std::future<std::unique_ptr<TaskResult>>& future)
+{
+  auto result = future.get();
+  return static_cast<MockTaskResult&>(*result).value;
+}
+
+/**
+ * Blocks all tasks that wait for it until it is released.
+ */
+class Gate
+{
+private:
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  bool m_open = false;
+
+public:
+  void wait()
+  {
+    auto lock = std::unique_lock{m_mutex};
+    m_condition.wait(lock, [&]() { return m_open; });
+  }
+
+  void open()
+  {
+    {
+      const auto lock = std::lock_guard{m_mutex};
+      m_open = true;
+    }
+    m_condition.notify_all();
+  }
+};
+
+struct MockResource
+{
+  int value;
+
+  void upload(bool) const {}
+  void drop(bool) const {}
+
+  kdl_reflect_inline(MockResource, value);
+};
+
+} // namespace
+
+TEST_CASE("ResourceLoadQueue")
+{
+  SECTION("Runs tasks")
+  {
+    auto queue = ResourceLoadQueue{2};
+
+    auto future1 = queue.run([]() { return std::make_unique<MockTaskResult>(1); });
+    auto future2 = queue.run([]() { return std::make_unique<MockTaskResult>(2); });
+
+    REQUIRE(future1.valid());
+    REQUIRE(future2.valid());
+    CHECK(getValue(future1) == 1);
+    CHECK(getValue(future2) == 2);
+
+    const auto stats = queue.stats();
+    CHECK(stats.completedTasks == 2);
+    CHECK(stats.cancelledTasks == 0);
+    CHECK(stats.declinedTasks == 0);
+  }
+
+  SECTION("Declines tasks when the queue is full")
+  {
+    auto gate = Gate{};
+    auto started = std::promise<void>{};
+
+    auto queue = ResourceLoadQueue{1, 2};
+
+    // occupies the only worker
+    auto blocking = queue.run([&]() {
+      started.set_value();
+      gate.wait();
+      return std::make_unique<MockTaskResult>(0);
+    });
+    started.get_future().wait();
+
+    auto queued1 = queue.run([]() { return std::make_unique<MockTaskResult>(1); });
+    auto queued2 = queue.run([]() { return std::make_unique<MockTaskResult>(2); });
+    auto declined = queue.run([]() { return std::make_unique<MockTaskResult>(3); });
+
+    CHECK(queued1.valid());
+    CHECK(queued2.valid());
+    CHECK(!declined.valid());
+
+    auto stats = queue.stats();
+    CHECK(stats.queuedTasks == 2);
+    CHECK(stats.runningTasks == 1);
+    CHECK(stats.declinedTasks == 1);
+
+    gate.open();
+    CHECK(getValue(blocking) == 0);
+    CHECK(getValue(queued1) == 1);
+    CHECK(getValue(queued2) == 2);
+  }
+
+  SECTION("Counts cancelled tasks")
+  {
+    auto queue = ResourceLoadQueue{1};
+
+    auto future = queue.run([]() { return nullptr; });
+    REQUIRE(future.valid());
+
+    while (queue.stats().cancelledTasks == 0)
+    {
+      std::this_thread::yield();
+    }
+
+    CHECK(queue.stats().completedTasks == 0);
+  }
+
+  SECTION("Propagates exceptions")
+  {
+    auto queue = ResourceLoadQueue{1};
+
+    auto future =
+      queue.run([]() -> std::unique_ptr<TaskResult> { throw std::runtime_error{""}; });
+    CHECK_THROWS_AS(future.get(), std::runtime_error);
+  }
+
+  SECTION("Waits for queued and running tasks")
+  {
+    auto gate = Gate{};
+    auto started = std::promise<void>{};
+    auto queue = ResourceLoadQueue{1};
+
+    auto finished = std::atomic<int>{0};
+    auto blocking = queue.run([&]() {
+      started.set_value();
+      gate.wait();
+      ++finished;
+      return std::make_unique<MockTaskResult>(0);
+    });
+    started.get_future().wait();
+
+    auto queued = queue.run([&]() {
+      ++finished;
+      return std::make_unique<MockTaskResult>(1);
+    });
+
+    auto waiter = std::thread{[&]() { queue.waitForTasks(); }};
+    gate.open();
+    waiter.join();
+
+    CHECK(finished == 2);
+    CHECK(queue.stats().queuedTasks == 0);
+    CHECK(queue.stats().runningTasks == 0);
+  }
+
+  SECTION("Loads resources")
+  {
+    auto queue = ResourceLoadQueue{2};
+    auto resource =
+      Resource<MockResource>{[]() { return Result<MockResource>{MockResource{1}}; }};
+
+    const auto processContext = ProcessContext{false, [](auto, auto) {}};
+    REQUIRE(resource.process(queue.taskRunner(), processContext));
+    REQUIRE(std::holds_alternative<ResourceLoading<MockResource>>(resource.state()));
+
+    while (!std::holds_alternative<ResourceLoaded<MockResource>>(resource.state()))
+    {
+      resource.process(queue.taskRunner(), processContext);
+    }
+
+    CHECK(resource.get()->value == 1);
+  }
+}
+
+} // namespace tb::mdl
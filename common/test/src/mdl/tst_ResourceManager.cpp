@@ -142,6 +142,33 @@ TEST_CASE("ResourceManager")
     CHECK(!resourceManager.needsProcessing());
   }
 
+  SECTION("Requested resources are loaded first")
+  {
+    auto resource1 = std::make_shared<ResourceT>(mockResourceLoader);
+    auto resource2 = std::make_shared<ResourceT>(mockResourceLoader);
+    auto resource3 = std::make_shared<ResourceT>(mockResourceLoader);
+    resourceManager.addResource(resource1);
+    resourceManager.addResource(resource2);
+    resourceManager.addResource(resource3);
+
+    // accessing a resource that isn't loaded yet marks it as requested
+    REQUIRE(resource3->get() == nullptr);
+
+    // a task runner that only accepts one task at a time
+    const auto limitedTaskRunner = [&](auto task) {
+      return mockTaskRunner.tasks.empty()
+               ? mockTaskRunner.run(std::move(task))
+               : std::future<std::unique_ptr<TaskResult>>{};
+    };
+
+    CHECK(
+      resourceManager.process(limitedTaskRunner, processContext)
+      == std::vector{resource3->id()});
+    CHECK(std::holds_alternative<ResourceUnloaded<MockResource>>(resource1->state()));
+    CHECK(std::holds_alternative<ResourceUnloaded<MockResource>>(resource2->state()));
+    CHECK(std::holds_alternative<ResourceLoading<MockResource>>(resource3->state()));
+  }
+
   SECTION("addResource")
   {
     auto resource1 = std::make_shared<ResourceT>(mockResourceLoader);
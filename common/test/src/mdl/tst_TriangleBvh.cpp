@@ -0,0 +1,145 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mdl/TriangleBvh.h"
+
+#include "vm/approx.h"
+#include "vm/intersection.h"
+#include "vm/vec.h"
+
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::mdl
+{
+namespace
+{
+
+std::optional<float> intersectBruteForce(
+  const std::vector<vm::vec3f>& vertices, const vm::ray3f& ray)
+{
+  auto result = std::optional<float>{};
+  for (size_t i = 0; i + 2 < vertices.size(); i += 3)
+  {
+    const auto distance =
+      vm::intersect_ray_triangle(ray, vertices[i], vertices[i + 1], vertices[i + 2]);
+    result = vm::safe_min(result, distance);
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("TriangleBvh")
+{
+  SECTION("empty tree")
+  {
+    const auto bvh = TriangleBvh{std::vector<vm::vec3f>{}};
+    CHECK(bvh.triangleCount() == 0);
+    CHECK(
+      bvh.intersect(vm::ray3f{vm::vec3f{0, 0, 0}, vm::vec3f{1, 0, 0}}) == std::nullopt);
+  }
+
+  SECTION("single triangle")
+  {
+    const auto bvh = TriangleBvh{std::vector<vm::vec3f>{
+      vm::vec3f{-1, -1, 0},
+      vm::vec3f{1, -1, 0},
+      vm::vec3f{0, 1, 0},
+    }};
+    CHECK(bvh.triangleCount() == 1);
+    CHECK(
+      bvh.intersect(vm::ray3f{vm::vec3f{0, 0, 5}, vm::vec3f{0, 0, -1}})
+      == vm::optional_approx<float>{5.0f});
+    CHECK(
+      bvh.intersect(vm::ray3f{vm::vec3f{0, 0, 5}, vm::vec3f{0, 0, 1}}) == std::nullopt);
+    CHECK(
+      bvh.intersect(vm::ray3f{vm::vec3f{2, 0, 5}, vm::vec3f{0, 0, -1}}) == std::nullopt);
+  }
+
+  SECTION("returns the closest hit")
+  {
+    auto vertices = std::vector<vm::vec3f>{};
+    for (int z = 0; z < 32; ++z)
+    {
+      vertices.emplace_back(-1, -1, z);
+      vertices.emplace_back(1, -1, z);
+      vertices.emplace_back(0, 1, z);
+    }
+
+    const auto bvh = TriangleBvh{vertices};
+    CHECK(bvh.triangleCount() == 32);
+    CHECK(
+      bvh.intersect(vm::ray3f{vm::vec3f{0, 0, 100}, vm::vec3f{0, 0, -1}})
+      == vm::optional_approx<float>{69.0f});
+    CHECK(
+      bvh.intersect(vm::ray3f{vm::vec3f{0, 0, -10}, vm::vec3f{0, 0, 1}})
+      == vm::optional_approx<float>{10.0f});
+    CHECK(
+      bvh.intersect(vm::ray3f{vm::vec3f{0, 0, 10.5f}, vm::vec3f{0, 0, 1}})
+      == vm::optional_approx<float>{0.5f});
+  }
+
+  SECTION("matches brute force intersection")
+  {
+    auto engine = std::mt19937{};
+    auto coord = std::uniform_real_distribution<float>{-100.0f, 100.0f};
+    auto offset = std::uniform_real_distribution<float>{-8.0f, 8.0f};
+
+    auto vertices = std::vector<vm::vec3f>{};
+    for (size_t i = 0; i < 500; ++i)
+    {
+      const auto center = vm::vec3f{coord(engine), coord(engine), coord(engine)};
+      for (size_t j = 0; j < 3; ++j)
+      {
+        vertices.push_back(
+          center + vm::vec3f{offset(engine), offset(engine), offset(engine)});
+      }
+    }
+
+    const auto bvh = TriangleBvh{vertices};
+    CHECK(bvh.triangleCount() == 500);
+    CHECK(bvh.memoryUsage() >= vertices.size() * sizeof(vm::vec3f));
+
+    for (size_t i = 0; i < 500; ++i)
+    {
+      const auto origin = vm::vec3f{coord(engine), coord(engine), coord(engine)};
+      const auto target = vm::vec3f{coord(engine), coord(engine), coord(engine)};
+      const auto ray = vm::ray3f{origin, vm::normalize(target - origin)};
+
+      CHECK(
+        bvh.intersect(ray) == vm::optional_approx(intersectBruteForce(vertices, ray)));
+    }
+
+    // axis aligned rays have zero components in their direction
+    for (size_t i = 0; i < 100; ++i)
+    {
+      const auto origin = vm::vec3f{coord(engine), coord(engine), -200.0f};
+      const auto ray = vm::ray3f{origin, vm::vec3f{0, 0, 1}};
+
+      CHECK(
+        bvh.intersect(ray) == vm::optional_approx(intersectBruteForce(vertices, ray)));
+    }
+  }
+}
+
+} // namespace tb::mdl
@@ -21,19 +21,24 @@
 #include "mdl/BezierPatch.h"
 #include "mdl/BrushBuilder.h"
 #include "mdl/BrushNode.h"
+#include "mdl/EditorContext.h"
 #include "mdl/Entity.h"
 #include "mdl/EntityNode.h"
 #include "mdl/Group.h"
 #include "mdl/GroupNode.h"
+#include "mdl/HitAdapter.h"
 #include "mdl/Layer.h"
 #include "mdl/LayerNode.h"
 #include "mdl/MapFormat.h"
 #include "mdl/PatchNode.h"
+#include "mdl/PickResult.h"
 #include "mdl/WorldNode.h"
 #include "octree.h"
 
 #include "kdl/result.h"
 
+#include <vector>
+
 #include "Catch2.h"
 
 namespace tb::mdl
@@ -316,6 +321,67 @@ TEST_CASE("WorldNodeTest.disableNodeTreeUpdates")
   CHECK(nodeTree.contains(patchNode));
 }
 
+TEST_CASE("WorldNodeTest.pickClosest")
+{
+  using namespace HitFilters;
+
+  constexpr auto worldBounds = vm::bbox3d{8192.0};
+  constexpr auto mapFormat = MapFormat::Quake3;
+
+  auto worldNode = WorldNode{{}, {}, mapFormat};
+
+  auto brushNodes = std::vector<BrushNode*>{};
+  for (size_t i = 0; i < 5; ++i)
+  {
+    const auto min = vm::vec3d{double(i) * 1024.0, 0, 0};
+    auto* brushNode = new BrushNode{
+      BrushBuilder{mapFormat, worldBounds}.createCuboid(
+        vm::bbox3d{min, min + vm::vec3d{64, 64, 64}}, "material")
+      | kdl::value()};
+    worldNode.defaultLayer()->addChild(brushNode);
+    brushNodes.push_back(brushNode);
+  }
+
+  const auto editorContext = EditorContext{};
+  const auto ray = vm::ray3d{{-512, 32, 32}, {1, 0, 0}};
+
+  auto allHits = PickResult::byDistance();
+  worldNode.pick(editorContext, ray, allHits);
+  REQUIRE(allHits.size() == 5u);
+
+  SECTION("Finds the closest hit")
+  {
+    auto pickResult = PickResult::byDistance();
+    worldNode.pickClosest(editorContext, ray, type(BrushNode::BrushHitType), pickResult);
+
+    CHECK(pickResult.size() < allHits.size());
+    CHECK(hitToNode(pickResult.first(type(BrushNode::BrushHitType))) == brushNodes[0]);
+  }
+
+  SECTION("Finds the closest hit that matches the filter")
+  {
+    const auto hitFilter = type(BrushNode::BrushHitType) && minDistance(2048.0);
+
+    auto pickResult = PickResult::byDistance();
+    worldNode.pickClosest(editorContext, ray, hitFilter, pickResult);
+
+    CHECK(pickResult.size() < allHits.size());
+    CHECK(hitToNode(pickResult.first(hitFilter)) == brushNodes[2]);
+  }
+
+  SECTION("Finds no hit if the ray misses")
+  {
+    auto pickResult = PickResult::byDistance();
+    worldNode.pickClosest(
+      editorContext,
+      vm::ray3d{{-512, 128, 32}, {1, 0, 0}},
+      type(BrushNode::BrushHitType),
+      pickResult);
+
+    CHECK(pickResult.empty());
+  }
+}
+
 TEST_CASE("WorldNodeTest.persistentIdOfDefaultLayer")
 {
   auto worldNode = WorldNode{{}, {}, MapFormat::Standard};
@@ -17,6 +17,7 @@
  along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "render/OrthographicCamera.h"
 #include "render/PerspectiveCamera.h"
 
 #include "Catch2.h"
@@ -70,4 +71,49 @@ TEST_CASE("CameraTest.testYawWhenPitchedDown")
   CHECK_FALSE(vm::is_nan(c.up()));
 }
 
+TEST_CASE("CameraTest.intersectsFrustum")
+{
+  SECTION("Perspective camera")
+  {
+    auto c = PerspectiveCamera{
+      90.0f,
+      1.0f,
+      8000.0f,
+      Camera::Viewport{0, 0, 800, 600},
+      vm::vec3f{0, 0, 0},
+      vm::vec3f{1, 0, 0},
+      vm::vec3f{0, 0, 1}};
+
+    CHECK(c.intersectsFrustum(vm::bbox3f{{100, -8, -8}, {116, 8, 8}}));
+    CHECK(c.intersectsFrustum(vm::bbox3f{{-8, -8, -8}, {8, 8, 8}}));
+    CHECK(c.intersectsFrustum(vm::bbox3f{{100, 90, -8}, {116, 200, 8}}));
+    CHECK_FALSE(c.intersectsFrustum(vm::bbox3f{{-116, -8, -8}, {-100, 8, 8}}));
+    CHECK_FALSE(c.intersectsFrustum(vm::bbox3f{{100, 200, -8}, {116, 300, 8}}));
+    CHECK_FALSE(c.intersectsFrustum(vm::bbox3f{{100, -8, 200}, {116, 8, 300}}));
+
+    c.setDirection(vm::vec3f{-1, 0, 0}, vm::vec3f{0, 0, 1});
+    CHECK_FALSE(c.intersectsFrustum(vm::bbox3f{{100, -8, -8}, {116, 8, 8}}));
+    CHECK(c.intersectsFrustum(vm::bbox3f{{-116, -8, -8}, {-100, 8, 8}}));
+  }
+
+  SECTION("Orthographic camera")
+  {
+    auto c = OrthographicCamera{
+      1.0f,
+      8000.0f,
+      Camera::Viewport{0, 0, 200, 100},
+      vm::vec3f{0, 0, 1000},
+      vm::vec3f{0, 0, -1},
+      vm::vec3f{0, 1, 0}};
+
+    CHECK(c.intersectsFrustum(vm::bbox3f{{-8, -8, -8}, {8, 8, 8}}));
+    CHECK(c.intersectsFrustum(vm::bbox3f{{90, 40, -8}, {110, 60, 8}}));
+    CHECK_FALSE(c.intersectsFrustum(vm::bbox3f{{110, -8, -8}, {120, 8, 8}}));
+    CHECK_FALSE(c.intersectsFrustum(vm::bbox3f{{-8, 60, -8}, {8, 70, 8}}));
+
+    c.moveTo(vm::vec3f{115, 0, 1000});
+    CHECK(c.intersectsFrustum(vm::bbox3f{{110, -8, -8}, {120, 8, 8}}));
+  }
+}
+
 } // namespace tb::render
@@ -0,0 +1,199 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Color.h"
+#include "io/ELParser.h"
+#include "mdl/BrushNode.h"
+#include "mdl/DecalDefinition.h"
+#include "mdl/Entity.h"
+#include "mdl/EntityDefinition.h"
+#include "mdl/EntityNode.h"
+#include "mdl/ModelDefinition.h"
+#include "render/EntityDecalRenderer.h"
+#include "ui/MapDocument.h"
+#include "ui/MapDocumentTest.h"
+
+#include "kdl/vector_utils.h"
+
+#include "vm/bbox.h"
+#include "vm/vec.h"
+
+#include <memory>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::render
+{
+
+TEST_CASE_METHOD(ui::MapDocumentTest, "EntityDecalRenderer")
+{
+  auto parser = io::ELParser{io::ELParser::Mode::Strict, R"("decal")"};
+  auto decalEntityDefinition = std::make_unique<mdl::PointEntityDefinition>(
+    "decal_entity",
+    Color{},
+    vm::bbox3d{8.0},
+    "",
+    std::vector<std::shared_ptr<mdl::PropertyDefinition>>{},
+    mdl::ModelDefinition{},
+    mdl::DecalDefinition{parser.parse()});
+
+  auto pointEntityDefinition = std::make_unique<mdl::PointEntityDefinition>(
+    "point_entity",
+    Color{},
+    vm::bbox3d{8.0},
+    "",
+    std::vector<std::shared_ptr<mdl::PropertyDefinition>>{},
+    mdl::ModelDefinition{},
+    mdl::DecalDefinition{});
+
+  document->setEntityDefinitions(kdl::vec_from<std::unique_ptr<mdl::EntityDefinition>>(
+    std::move(decalEntityDefinition), std::move(pointEntityDefinition)));
+
+  // brushNode1 is at the origin, brushNode2 is further along the X axis
+  auto* brushNode1 = createBrushNode();
+  auto* brushNode2 = createBrushNode();
+  auto* decalEntityNode =
+    new mdl::EntityNode{mdl::Entity{{{"classname", "decal_entity"}}}};
+  auto* pointEntityNode =
+    new mdl::EntityNode{mdl::Entity{{{"classname", "point_entity"}}}};
+
+  document->addNodes({{document->parentForNodes(),
+                       {brushNode1, brushNode2, decalEntityNode, pointEntityNode}}});
+
+  document->selectNodes({brushNode2});
+  document->translateObjects(vm::vec3d{64, 0, 0});
+  document->deselectAll();
+
+  const auto originBounds = vm::bbox3d{1.0};
+  const auto translatedBounds = originBounds.translate(vm::vec3d{64, 0, 0});
+
+  auto renderer = EntityDecalRenderer{document};
+  renderer.updateNode(brushNode1);
+  renderer.updateNode(brushNode2);
+  renderer.updateNode(decalEntityNode);
+  renderer.updateNode(pointEntityNode);
+
+  using BrushList = std::vector<const mdl::BrushNode*>;
+  using EntityList = std::vector<const mdl::EntityNode*>;
+
+  SECTION("Tracks entities with a decal specification")
+  {
+    CHECK(renderer.findEntities(document->worldBounds()) == EntityList{decalEntityNode});
+    CHECK(renderer.findEntities(translatedBounds) == EntityList{});
+  }
+
+  SECTION("Collects the brushes that intersect a decal entity")
+  {
+    CHECK(renderer.decalBrushes(decalEntityNode) == BrushList{});
+
+    renderer.validate();
+    CHECK(renderer.decalBrushes(decalEntityNode) == BrushList{brushNode1});
+    CHECK(renderer.brushDependents(brushNode1) == EntityList{decalEntityNode});
+    CHECK(renderer.brushDependents(brushNode2) == EntityList{});
+  }
+
+  SECTION("Updates a moved entity")
+  {
+    renderer.validate();
+
+    document->selectNodes({decalEntityNode});
+    document->translateObjects(vm::vec3d{64, 0, 0});
+    document->deselectAll();
+    renderer.updateNode(decalEntityNode);
+
+    CHECK(renderer.findEntities(originBounds) == EntityList{});
+    CHECK(renderer.findEntities(translatedBounds) == EntityList{decalEntityNode});
+    CHECK(renderer.decalBrushes(decalEntityNode) == BrushList{});
+    CHECK(renderer.brushDependents(brushNode1) == EntityList{});
+
+    renderer.validate();
+    CHECK(renderer.decalBrushes(decalEntityNode) == BrushList{brushNode2});
+    CHECK(renderer.brushDependents(brushNode2) == EntityList{decalEntityNode});
+  }
+
+  SECTION("Invalidates entities that intersect a changed brush")
+  {
+    renderer.validate();
+
+    document->selectNodes({brushNode2});
+    document->translateObjects(vm::vec3d{-64, 0, 0});
+    document->deselectAll();
+    renderer.updateNode(brushNode2);
+
+    renderer.validate();
+    CHECK_THAT(
+      renderer.decalBrushes(decalEntityNode),
+      Catch::UnorderedEquals(BrushList{brushNode1, brushNode2}));
+    CHECK(renderer.brushDependents(brushNode2) == EntityList{decalEntityNode});
+  }
+
+  SECTION("Invalidates entities whose decal was created from a changed brush")
+  {
+    renderer.validate();
+
+    document->selectNodes({brushNode1});
+    document->translateObjects(vm::vec3d{0, 64, 0});
+    document->deselectAll();
+    renderer.updateNode(brushNode1);
+
+    renderer.validate();
+    CHECK(renderer.decalBrushes(decalEntityNode) == BrushList{});
+    CHECK(renderer.brushDependents(brushNode1) == EntityList{});
+  }
+
+  SECTION("Removes entities")
+  {
+    renderer.validate();
+    renderer.removeNode(decalEntityNode);
+
+    CHECK(renderer.findEntities(document->worldBounds()) == EntityList{});
+    CHECK(renderer.decalBrushes(decalEntityNode) == BrushList{});
+    CHECK(renderer.brushDependents(brushNode1) == EntityList{});
+  }
+
+  SECTION("Removes entities that no longer have a decal specification")
+  {
+    renderer.validate();
+
+    document->selectNodes({decalEntityNode});
+    document->setProperty("classname", "point_entity");
+    document->deselectAll();
+    renderer.updateNode(decalEntityNode);
+
+    CHECK(renderer.findEntities(document->worldBounds()) == EntityList{});
+    CHECK(renderer.brushDependents(brushNode1) == EntityList{});
+  }
+
+  SECTION("Removes brushes")
+  {
+    renderer.validate();
+
+    document->removeNodes({brushNode1});
+    renderer.removeNode(brushNode1);
+
+    CHECK(renderer.brushDependents(brushNode1) == EntityList{});
+    CHECK(renderer.decalBrushes(decalEntityNode) == BrushList{});
+
+    renderer.validate();
+    CHECK(renderer.decalBrushes(decalEntityNode) == BrushList{});
+  }
+}
+
+} // namespace tb::render
@@ -19,6 +19,10 @@
 
 #include "octree.h"
 
+#include <algorithm>
+#include <optional>
+#include <vector>
+
 #include "Catch2.h"
 
 namespace tb
@@ -613,6 +617,47 @@ TEST_CASE("octree.find_intersectors-ray")
   }
 }
 
+TEST_CASE("octree.visit_intersectors_front_to_back")
+{
+  auto tree = octree<double, int>{32.0};
+
+  const auto visit = [&](const vm::ray3d& ray, const std::vector<int>& hits) {
+    auto result = std::vector<int>{};
+    tree.visit_intersectors_front_to_back(ray, [&](const int i) -> std::optional<double> {
+      result.push_back(i);
+      return std::find(hits.begin(), hits.end(), i) != hits.end()
+               ? std::optional{double(i) * 64.0}
+               : std::nullopt;
+    });
+    return result;
+  };
+
+  SECTION("empty tree")
+  {
+    CHECK(visit(vm::ray3d{{0, 0, 0}, {1, 0, 0}}, {}).empty());
+  }
+
+  SECTION("multiple nodes")
+  {
+    tree.insert({{64, 0, 0}, {96, 32, 32}}, 1);
+    tree.insert({{128, 0, 0}, {160, 32, 32}}, 2);
+    tree.insert({{192, 0, 0}, {224, 32, 32}}, 3);
+    tree.insert({{192, 64, 0}, {224, 96, 32}}, 4);
+
+    const auto ray = vm::ray3d{{0, 16, 16}, {1, 0, 0}};
+
+    // all nodes hit by the ray are visited in front to back order if there is no hit
+    CHECK(visit(ray, {}) == std::vector<int>{1, 2, 3});
+
+    // nodes farther away than the closest hit are not visited
+    CHECK(visit(ray, {1}) == std::vector<int>{1});
+    CHECK(visit(ray, {2, 3}) == std::vector<int>{1, 2});
+
+    // the ray starts within a node
+    CHECK(visit(vm::ray3d{{144, 16, 16}, {-1, 0, 0}}, {}) == std::vector<int>{2, 1});
+  }
+}
+
 TEST_CASE("octree.find_intersectors-bbox")
 {
   auto tree = octree<double, int>{32.0};
@@ -717,4 +762,43 @@ TEST_CASE("octree.find_containers")
     CHECK(tree.find_containers({64, 64, 64}) == std::vector<int>{1});
   }
 }
+
+TEST_CASE("octree.find_if")
+{
+  auto tree = octree<double, int>{32.0};
+
+  SECTION("empty tree")
+  {
+    CHECK(tree.find_if([](const auto&) { return true; }).empty());
+  }
+
+  SECTION("multiple nodes")
+  {
+    tree.insert({{32, 32, 32}, {64, 64, 64}}, 1);
+    tree.insert({{-64, -64, -64}, {-32, -32, -32}}, 2);
+    tree.insert({{-16, -16, -16}, {16, 16, 16}}, 3);
+
+    CHECK_THAT(
+      tree.find_if([](const auto&) { return true; }),
+      Catch::UnorderedEquals(std::vector<int>{1, 2, 3}));
+    CHECK(tree.find_if([](const auto&) { return false; }).empty());
+
+    // only the root node contains the point, so only its data is found
+    CHECK(
+      tree.find_if([](const auto& bounds) { return bounds.contains({-8, -8, -8}); })
+      == std::vector<int>{3});
+
+    const auto positive = [](const auto& bounds) {
+      return bounds.max.x() > 0.0 && bounds.max.y() > 0.0 && bounds.max.z() > 0.0;
+    };
+    CHECK_THAT(
+      tree.find_if(positive), Catch::UnorderedEquals(std::vector<int>{1, 3}));
+
+    const auto negative = [](const auto& bounds) {
+      return bounds.min.x() < 0.0 && bounds.min.y() < 0.0 && bounds.min.z() < 0.0;
+    };
+    CHECK_THAT(
+      tree.find_if(negative), Catch::UnorderedEquals(std::vector<int>{2, 3}));
+  }
+}
 } // namespace tb
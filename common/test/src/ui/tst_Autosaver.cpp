@@ -96,6 +96,7 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverNoSaveUntilSaveInter
   document->addNodes({{document->currentLayer(), {createBrushNode("some_material")}}});
 
   autosaver.triggerAutosave(logger);
+  autosaver.finishPendingSave(logger);
 
   CHECK_FALSE(env.fileExists("autosave/test.1.map"));
   CHECK_FALSE(env.directoryExists("autosave"));
@@ -113,6 +114,7 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverNoSaveOfUnchangedMap
 
   auto autosaver = Autosaver{document, 0s};
   autosaver.triggerAutosave(logger);
+  autosaver.finishPendingSave(logger);
 
   CHECK_FALSE(env.fileExists("autosave/test.1.map"));
   CHECK_FALSE(env.directoryExists("autosave"));
@@ -136,6 +138,7 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverSavesAfterSaveInterv
   std::this_thread::sleep_for(100ms);
 
   autosaver.triggerAutosave(logger);
+  autosaver.finishPendingSave(logger);
 
   CHECK(env.fileExists("autosave/test.1.map"));
   CHECK(env.directoryExists("autosave"));
@@ -159,6 +162,7 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverSavesAgainAfterSaveI
   std::this_thread::sleep_for(100ms);
 
   autosaver.triggerAutosave(logger);
+  autosaver.finishPendingSave(logger);
 
   CHECK(env.fileExists("autosave/test.1.map"));
   CHECK(env.directoryExists("autosave"));
@@ -168,15 +172,47 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverSavesAgainAfterSaveI
   std::this_thread::sleep_for(100ms);
 
   autosaver.triggerAutosave(logger);
+  autosaver.finishPendingSave(logger);
   CHECK_FALSE(env.fileExists("autosave/test.2.map"));
 
   // modify the map
   document->addNodes({{document->currentLayer(), {createBrushNode("some_material")}}});
 
   autosaver.triggerAutosave(logger);
+  autosaver.finishPendingSave(logger);
   CHECK(env.fileExists("autosave/test.2.map"));
 }
 
+TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverSavesAgainAfterFailedSave")
+{
+  using namespace std::chrono_literals;
+
+  auto env = io::TestEnvironment{};
+  auto logger = NullLogger{};
+
+  document->saveDocumentAs(env.dir() / "test.map");
+  assert(env.fileExists("test.map"));
+
+  // a directory in place of the backup makes writing it fail
+  env.createDirectory("autosave/test.1.map");
+
+  auto autosaver = Autosaver{document, 0s};
+
+  // modify the map
+  document->addNodes({{document->currentLayer(), {createBrushNode("some_material")}}});
+
+  autosaver.triggerAutosave(logger);
+  autosaver.finishPendingSave(logger);
+  CHECK_FALSE(env.fileExists("autosave/test.1.map"));
+
+  std::filesystem::remove(env.dir() / "autosave/test.1.map");
+
+  // the map was not modified again, but the failed backup was not recorded as a save
+  autosaver.triggerAutosave(logger);
+  autosaver.finishPendingSave(logger);
+  CHECK(env.fileExists("autosave/test.1.map"));
+}
+
 TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverCleanup")
 {
   using namespace std::chrono_literals;
@@ -219,6 +255,8 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverCleanup")
 
     std::this_thread::sleep_for(100ms);
     autosaver.triggerAutosave(logger);
+    autosaver.finishPendingSave(logger);
+  autosaver.finishPendingSave(logger);
 
     const auto allPaths = kdl::vec_push_back(initialPaths, "autosave/test.3.map");
 
@@ -243,6 +281,8 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverCleanup")
 
     std::this_thread::sleep_for(100ms);
     autosaver.triggerAutosave(logger);
+    autosaver.finishPendingSave(logger);
+  autosaver.finishPendingSave(logger);
 
     CHECK(env.directoryContents("autosave") == allPaths);
     CHECK(
@@ -304,6 +344,8 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverCleanup")
 
     std::this_thread::sleep_for(100ms);
     autosaver.triggerAutosave(logger);
+    autosaver.finishPendingSave(logger);
+  autosaver.finishPendingSave(logger);
 
     const auto allPaths = std::vector<std::filesystem::path>{
       "autosave/test.1.map",
@@ -351,6 +393,7 @@ TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverSavesWhenCrashFilesP
   document->addNodes({{document->currentLayer(), {createBrushNode("some_material")}}});
 
   autosaver.triggerAutosave(logger);
+  autosaver.finishPendingSave(logger);
 
   CHECK(env.fileExists("autosave/test.2.map"));
 }
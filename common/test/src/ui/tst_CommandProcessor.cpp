@@ -243,6 +243,38 @@ public:
   }
 };
 
+class SizedCommand : public NullCommand
+{
+private:
+  size_t m_memorySize;
+
+public:
+  SizedCommand(std::string name, const size_t memorySize)
+    : NullCommand{std::move(name)}
+    , m_memorySize{memorySize}
+  {
+  }
+
+private:
+  size_t doGetMemorySize() const override { return m_memorySize; }
+};
+
+class VariableSizedCommand : public NullCommand
+{
+private:
+  std::shared_ptr<size_t> m_memorySize;
+
+public:
+  VariableSizedCommand(std::string name, std::shared_ptr<size_t> memorySize)
+    : NullCommand{std::move(name)}
+    , m_memorySize{std::move(memorySize)}
+  {
+  }
+
+private:
+  size_t doGetMemorySize() const override { return *m_memorySize; }
+};
+
 } // namespace
 
 TEST_CASE("CommandProcessorTest.doAndUndoSuccessfulCommand")
@@ -832,4 +864,117 @@ TEST_CASE("CommandProcessorTest.collateTransactions")
   commandProcessor.undo();
 }
 
+TEST_CASE("CommandProcessorTest.undoMemoryBudget")
+{
+  auto facade = MapDocumentCommandFacade{};
+  auto commandProcessor = CommandProcessor{facade};
+
+  auto evictedCounts = std::vector<size_t>{};
+  auto notifierConnection = NotifierConnection{};
+  notifierConnection += commandProcessor.undoStackEvictedNotifier.connect(
+    [&](const size_t evictCount) { evictedCounts.push_back(evictCount); });
+
+  commandProcessor.executeAndStore(std::make_unique<SizedCommand>("cmd1", 100));
+  commandProcessor.executeAndStore(std::make_unique<SizedCommand>("cmd2", 100));
+  commandProcessor.executeAndStore(std::make_unique<SizedCommand>("cmd3", 100));
+  CHECK(commandProcessor.undoMemorySize() == 300);
+  CHECK(evictedCounts.empty());
+
+  SECTION("Setting a budget evicts the oldest commands")
+  {
+    commandProcessor.setUndoMemoryBudget(250);
+    CHECK(commandProcessor.undoMemorySize() == 200);
+    CHECK(evictedCounts == std::vector<size_t>{1});
+
+    commandProcessor.executeAndStore(std::make_unique<SizedCommand>("cmd4", 100));
+    CHECK(commandProcessor.undoMemorySize() == 200);
+    CHECK(evictedCounts == std::vector<size_t>{1, 1});
+
+    CHECK(commandProcessor.undoCommandName() == "cmd4");
+    commandProcessor.undo();
+    CHECK(commandProcessor.undoCommandName() == "cmd3");
+    commandProcessor.undo();
+    CHECK_FALSE(commandProcessor.canUndo());
+  }
+
+  SECTION("The most recent command is always kept")
+  {
+    commandProcessor.setUndoMemoryBudget(50);
+    CHECK(commandProcessor.undoMemorySize() == 100);
+    CHECK(commandProcessor.undoCommandName() == "cmd3");
+
+    commandProcessor.executeAndStore(std::make_unique<SizedCommand>("cmd4", 500));
+    CHECK(commandProcessor.undoMemorySize() == 500);
+    CHECK(commandProcessor.undoCommandName() == "cmd4");
+  }
+
+  SECTION("Transactions are accounted for by their commands")
+  {
+    commandProcessor.setUndoMemoryBudget(350);
+
+    commandProcessor.startTransaction("transaction", TransactionScope::Oneshot);
+    commandProcessor.executeAndStore(std::make_unique<SizedCommand>("cmd4", 100));
+    commandProcessor.executeAndStore(std::make_unique<SizedCommand>("cmd5", 100));
+    CHECK(evictedCounts.empty());
+    commandProcessor.commitTransaction();
+
+    // the transaction itself holds more than 200 bytes, so all older commands are evicted
+    CHECK(commandProcessor.undoMemorySize() > 200);
+    CHECK(commandProcessor.undoMemorySize() <= 350);
+    CHECK(commandProcessor.undoCommandName() == "transaction");
+    CHECK(evictedCounts == std::vector<size_t>{3});
+  }
+
+  SECTION("Undone commands count against the budget")
+  {
+    commandProcessor.undo();
+    commandProcessor.undo();
+    CHECK(commandProcessor.undoMemorySize() == 300);
+
+    // the undone command that is furthest from the current state is evicted first
+    commandProcessor.setUndoMemoryBudget(250);
+    CHECK(commandProcessor.undoMemorySize() == 200);
+    CHECK(evictedCounts == std::vector<size_t>{1});
+    CHECK(commandProcessor.undoCommandName() == "cmd1");
+    CHECK(commandProcessor.redoCommandName() == "cmd2");
+
+    commandProcessor.redo();
+    CHECK_FALSE(commandProcessor.canRedo());
+  }
+
+  SECTION("Storing a command discards the undone commands before enforcing the budget")
+  {
+    commandProcessor.setUndoMemoryBudget(300);
+    commandProcessor.undo();
+
+    commandProcessor.executeAndStore(std::make_unique<SizedCommand>("cmd4", 100));
+    CHECK(commandProcessor.undoMemorySize() == 300);
+    CHECK(evictedCounts.empty());
+  }
+
+  SECTION("Changed estimates are taken into account")
+  {
+    auto memorySize = std::make_shared<size_t>(100);
+    commandProcessor.executeAndStore(
+      std::make_unique<VariableSizedCommand>("cmd4", memorySize));
+    CHECK(commandProcessor.undoMemorySize() == 400);
+
+    // e.g. the document no longer shares the brushes that the command holds
+    *memorySize = 300;
+    CHECK(commandProcessor.undoMemorySize() == 600);
+
+    commandProcessor.setUndoMemoryBudget(450);
+    CHECK(commandProcessor.undoMemorySize() == 400);
+    CHECK(evictedCounts == std::vector<size_t>{2});
+  }
+
+  SECTION("A budget of 0 disables eviction")
+  {
+    commandProcessor.setUndoMemoryBudget(0);
+    commandProcessor.executeAndStore(std::make_unique<SizedCommand>("cmd4", 100));
+    CHECK(commandProcessor.undoMemorySize() == 400);
+    CHECK(evictedCounts.empty());
+  }
+}
+
 } // namespace tb::ui
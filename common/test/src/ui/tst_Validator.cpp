@@ -22,21 +22,50 @@
 #include "mdl/BrushNode.h"
 #include "mdl/EmptyPropertyKeyValidator.h"
 #include "mdl/EmptyPropertyValueValidator.h"
+#include "mdl/Entity.h"
 #include "mdl/EntityNode.h"
 #include "mdl/GroupNode.h"
 #include "mdl/Issue.h"
 #include "mdl/IssueQuickFix.h"
 #include "mdl/LayerNode.h"
 #include "mdl/PatchNode.h"
+#include "mdl/Validator.h"
 #include "mdl/WorldNode.h"
 
 #include "kdl/overload.h"
 #include "kdl/vector_utils.h"
 
+#include <memory>
+#include <vector>
+
 #include "Catch2.h"
 
 namespace tb::ui
 {
+namespace
+{
+
+const auto SerialTestIssueType = mdl::freeIssueType();
+
+class SerialTestValidator : public mdl::Validator
+{
+public:
+  SerialTestValidator()
+    : Validator{SerialTestIssueType, "Serial test validator"}
+  {
+  }
+
+private:
+  void doValidate(
+    mdl::EntityNode& entityNode,
+    std::vector<std::unique_ptr<mdl::Issue>>& issues) const override
+  {
+    issues.push_back(std::make_unique<mdl::Issue>(
+      SerialTestIssueType, entityNode, "Serial issue"));
+  }
+};
+
+} // namespace
 
 TEST_CASE_METHOD(MapDocumentTest, "ValidatorTest.emptyProperty")
 {
@@ -104,4 +133,42 @@ TEST_CASE_METHOD(MapDocumentTest, "ValidatorTest.emptyProperty")
   kdl::vec_clear_and_delete(validators);
 }
 
+TEST_CASE("ValidatorTest.validateIssuesInParallel")
+{
+  const auto emptyPropertyKeyValidator = mdl::EmptyPropertyKeyValidator{};
+  const auto serialTestValidator = SerialTestValidator{};
+
+  REQUIRE(emptyPropertyKeyValidator.threadSafe());
+  REQUIRE_FALSE(serialTestValidator.threadSafe());
+
+  const auto validators = std::vector<const mdl::Validator*>{
+    &emptyPropertyKeyValidator, &serialTestValidator};
+
+  auto entityNodes = std::vector<std::unique_ptr<mdl::EntityNode>>{};
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    entityNodes.push_back(
+      std::make_unique<mdl::EntityNode>(mdl::Entity{{{"", "value"}}}));
+  }
+
+  const auto nodes = kdl::vec_transform(
+    entityNodes, [](const auto& entityNode) -> mdl::Node* { return entityNode.get(); });
+  mdl::Node::validateIssues(nodes, validators);
+
+  for (auto* node : nodes)
+  {
+    const auto issues = node->issues(validators);
+    REQUIRE(issues.size() == 2u);
+    CHECK(
+      kdl::vec_transform(issues, [](const auto* issue) { return issue->type(); })
+      == std::vector<mdl::IssueType>{
+        emptyPropertyKeyValidator.type(), serialTestValidator.type()});
+  }
+
+  // valid issues are not validated again
+  const auto issues = nodes.front()->issues(validators);
+  mdl::Node::validateIssues(nodes, validators);
+  CHECK(nodes.front()->issues(validators) == issues);
+}
+
 } // namespace tb::ui
@@ -0,0 +1,521 @@
+/*
+ Copyright (C) 2024 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PreferenceManager.h"
+#include "Preferences.h"
+#include "mdl/Hit.h"
+#include "mdl/PickResult.h"
+#include "render/OrthographicCamera.h"
+#include "render/PerspectiveCamera.h"
+#include "ui/Grid.h"
+#include "ui/Lasso.h"
+#include "ui/VertexHandleManager.h"
+
+#include "vm/distance.h"
+#include "vm/intersection.h"
+#include "vm/polygon.h"
+#include "vm/ray.h"
+#include "vm/segment.h"
+#include "vm/vec.h"
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "Catch2.h"
+
+namespace tb::ui
+{
+namespace
+{
+
+constexpr size_t HandleCount = 500;
+constexpr size_t PickCount = 500;
+constexpr size_t LassoCount = 20;
+
+std::unique_ptr<render::Camera> makeCamera(const bool orthographic)
+{
+  const auto viewport = render::Camera::Viewport{0, 0, 1024, 768};
+  const auto position = vm::vec3f{-1024.0f, 0.0f, 0.0f};
+  const auto direction = vm::vec3f{1.0f, 0.0f, 0.0f};
+  const auto up = vm::vec3f{0.0f, 0.0f, 1.0f};
+
+  if (orthographic)
+  {
+    return std::make_unique<render::OrthographicCamera>(
+      1.0f, 8192.0f, viewport, position, direction, up);
+  }
+  return std::make_unique<render::PerspectiveCamera>(
+    90.0f, 1.0f, 8192.0f, viewport, position, direction, up);
+}
+
+auto makePoints(std::mt19937& rng, const size_t count)
+{
+  auto dist = std::uniform_real_distribution<double>{-256.0, 256.0};
+
+  auto result = std::vector<vm::vec3d>{};
+  result.reserve(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    result.emplace_back(dist(rng), dist(rng), dist(rng));
+  }
+  return result;
+}
+
+auto makeSegments(std::mt19937& rng, const size_t count)
+{
+  auto offset = std::uniform_real_distribution<double>{-64.0, 64.0};
+
+  auto result = std::vector<vm::segment3d>{};
+  result.reserve(count);
+  for (const auto& start : makePoints(rng, count))
+  {
+    result.emplace_back(start, start + vm::vec3d{offset(rng), offset(rng), offset(rng)});
+  }
+  return result;
+}
+
+auto makePolygons(std::mt19937& rng, const size_t count)
+{
+  auto offset = std::uniform_real_distribution<double>{-64.0, 64.0};
+
+  auto result = std::vector<vm::polygon3d>{};
+  result.reserve(count);
+  for (const auto& first : makePoints(rng, count))
+  {
+    result.emplace_back(std::vector{
+      first,
+      first + vm::vec3d{offset(rng), offset(rng), offset(rng)},
+      first + vm::vec3d{offset(rng), offset(rng), offset(rng)},
+    });
+  }
+  return result;
+}
+
+/**
+ * Returns pick rays that pass close to randomly chosen targets, so that roughly half of
+ * them hit a handle.
+ */
+auto makePickRays(
+  std::mt19937& rng,
+  const render::Camera& camera,
+  const std::vector<vm::vec3d>& targets)
+{
+  auto index = std::uniform_int_distribution<size_t>{0, targets.size() - 1};
+  auto jitter = std::uniform_real_distribution<double>{-8.0, 8.0};
+
+  auto result = std::vector<vm::ray3d>{};
+  result.reserve(PickCount);
+  for (size_t i = 0; i < PickCount; ++i)
+  {
+    const auto target =
+      targets[index(rng)] + vm::vec3d{jitter(rng), jitter(rng), jitter(rng)};
+    result.emplace_back(camera.pickRay(vm::vec3f{target}));
+  }
+  return result;
+}
+
+template <typename T>
+auto makeTargets(const std::vector<T>& handles)
+{
+  auto result = std::vector<vm::vec3d>{};
+  result.reserve(handles.size());
+  std::transform(
+    handles.begin(), handles.end(), std::back_inserter(result), [](const auto& handle) {
+      if constexpr (std::is_same_v<T, vm::vec3d>)
+      {
+        return handle;
+      }
+      else
+      {
+        return handle.center();
+      }
+    });
+  return result;
+}
+
+template <typename T>
+auto getHits(const mdl::PickResult& pickResult)
+{
+  auto result = std::vector<std::pair<double, T>>{};
+  for (const auto& hit : pickResult.all())
+  {
+    result.emplace_back(hit.distance(), hit.target<T>());
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+/**
+ * Tests every handle of the given manager with the given test, which is how the handle
+ * managers picked before they indexed their handles.
+ */
+template <typename T, typename M, typename P>
+auto pickAll(const M& manager, const P& test)
+{
+  // VertexHandleManager hides the generic pick function
+  const auto& baseManager =
+    static_cast<const VertexHandleManagerBaseT<typename M::Handle>&>(manager);
+
+  auto pickResult = mdl::PickResult{};
+  baseManager.pick(test, pickResult);
+  return getHits<T>(pickResult);
+}
+
+template <typename T, typename P>
+auto pickIndexed(const P& pick)
+{
+  auto pickResult = mdl::PickResult{};
+  pick(pickResult);
+  return getHits<T>(pickResult);
+}
+
+template <typename M, typename H>
+void addHandles(M& manager, const std::vector<H>& handles)
+{
+  for (const auto& handle : handles)
+  {
+    manager.add(handle);
+  }
+}
+
+/**
+ * Checks that the lasso selects the same handles among the candidates returned by the
+ * given manager as among all of its handles.
+ */
+template <typename M>
+void checkLassoSelection(
+  std::mt19937& rng, const render::Camera& camera, const M& manager)
+{
+  auto x = std::uniform_real_distribution<float>{0.0f, 1024.0f};
+  auto y = std::uniform_real_distribution<float>{0.0f, 768.0f};
+
+  const auto allHandles = manager.allHandles();
+  auto candidateCount = size_t(0);
+  for (size_t i = 0; i < LassoCount; ++i)
+  {
+    auto lasso = Lasso{camera, 512.0, vm::vec3d{camera.defaultPoint(x(rng), y(rng))}};
+    lasso.update(vm::vec3d{camera.defaultPoint(x(rng), y(rng))});
+
+    const auto candidates = manager.findHandles(lasso.boundsTest());
+    CHECK(candidates.size() <= allHandles.size());
+    candidateCount += candidates.size();
+
+    auto expected = typename M::HandleList{};
+    lasso.selected(allHandles.begin(), allHandles.end(), std::back_inserter(expected));
+
+    auto actual = typename M::HandleList{};
+    lasso.selected(candidates.begin(), candidates.end(), std::back_inserter(actual));
+    std::sort(actual.begin(), actual.end());
+
+    CHECK(actual == expected);
+  }
+
+  // make sure that the bounds test discards some handles
+  CHECK(candidateCount < LassoCount * allHandles.size());
+}
+
+} // namespace
+
+TEST_CASE("mayHitPointHandle")
+{
+  const auto orthographic = GENERATE(false, true);
+  const auto camera = makeCamera(orthographic);
+  const auto handleRadius = double(pref(Preferences::HandleRadius));
+
+  auto rng = std::mt19937{0};
+
+  SECTION("Returns true if a point within the bounds is hit")
+  {
+    auto extent = std::uniform_real_distribution<double>{0.0, 32.0};
+    auto t = std::uniform_real_distribution<double>{0.0, 1.0};
+
+    const auto corners = makePoints(rng, HandleCount);
+    const auto pickRays = makePickRays(rng, *camera, corners);
+
+    auto hitCount = size_t(0);
+    for (size_t i = 0; i < corners.size(); ++i)
+    {
+      const auto& min = corners[i];
+      const auto max = min + vm::vec3d{extent(rng), extent(rng), extent(rng)};
+      const auto bounds = vm::bbox3d{min, max};
+      const auto point = min + (max - min) * vm::vec3d{t(rng), t(rng), t(rng)};
+
+      for (const auto& pickRay : pickRays)
+      {
+        if (camera->pickPointHandle(pickRay, point, handleRadius))
+        {
+          CHECK(mayHitPointHandle(pickRay, *camera, bounds, handleRadius));
+          ++hitCount;
+        }
+      }
+    }
+
+    CHECK(hitCount > 0);
+  }
+
+  SECTION("Returns false if the bounds are far away from the pick ray")
+  {
+    const auto pickRay = vm::ray3d{camera->pickRay(vm::vec3f{0.0f, 0.0f, 0.0f})};
+    const auto bounds = vm::bbox3d{vm::vec3d{0, 256, 256}, vm::vec3d{16, 272, 272}};
+
+    CHECK_FALSE(mayHitPointHandle(pickRay, *camera, bounds, handleRadius));
+  }
+}
+
+TEST_CASE("VertexHandleManager.pick")
+{
+  const auto orthographic = GENERATE(false, true);
+  const auto camera = makeCamera(orthographic);
+  const auto handleRadius = double(pref(Preferences::HandleRadius));
+
+  auto rng = std::mt19937{0};
+  const auto handles = makePoints(rng, HandleCount);
+
+  auto manager = VertexHandleManager{};
+  addHandles(manager, handles);
+
+  auto hitCount = size_t(0);
+  for (const auto& pickRay : makePickRays(rng, *camera, handles))
+  {
+    const auto expected = pickAll<vm::vec3d>(manager, [&](const auto& position) {
+      if (const auto distance = camera->pickPointHandle(pickRay, position, handleRadius))
+      {
+        const auto hitPoint = vm::point_at_distance(pickRay, *distance);
+        const auto error = vm::squared_distance(pickRay, position).distance;
+        return mdl::Hit{
+          VertexHandleManager::HandleHitType, *distance, hitPoint, position, error};
+      }
+      return mdl::Hit::NoHit;
+    });
+
+    const auto actual = pickIndexed<vm::vec3d>(
+      [&](auto& pickResult) { manager.pick(pickRay, *camera, pickResult); });
+
+    CHECK(actual == expected);
+    hitCount += expected.size();
+  }
+
+  // make sure that the test is meaningful
+  CHECK(hitCount > 0);
+}
+
+TEST_CASE("EdgeHandleManager.pick")
+{
+  const auto orthographic = GENERATE(false, true);
+  const auto camera = makeCamera(orthographic);
+  const auto handleRadius = double(pref(Preferences::HandleRadius));
+
+  auto rng = std::mt19937{0};
+  const auto handles = makeSegments(rng, HandleCount);
+
+  auto manager = EdgeHandleManager{};
+  addHandles(manager, handles);
+
+  SECTION("pickCenterHandle")
+  {
+    auto hitCount = size_t(0);
+    for (const auto& pickRay : makePickRays(rng, *camera, makeTargets(handles)))
+    {
+      const auto expected = pickAll<vm::segment3d>(manager, [&](const auto& position) {
+        if (
+          const auto pointDist =
+            camera->pickPointHandle(pickRay, position.center(), handleRadius))
+        {
+          const auto hitPoint = vm::point_at_distance(pickRay, *pointDist);
+          return mdl::Hit{
+            EdgeHandleManager::HandleHitType, *pointDist, hitPoint, position};
+        }
+        return mdl::Hit::NoHit;
+      });
+
+      const auto actual = pickIndexed<vm::segment3d>([&](auto& pickResult) {
+        manager.pickCenterHandle(pickRay, *camera, pickResult);
+      });
+
+      CHECK(actual == expected);
+      hitCount += expected.size();
+    }
+
+    CHECK(hitCount > 0);
+  }
+
+  SECTION("pickGridHandle")
+  {
+    const auto grid = Grid{4};
+
+    auto hitCount = size_t(0);
+    for (const auto& pickRay : makePickRays(rng, *camera, makeTargets(handles)))
+    {
+      using HitType = EdgeHandleManager::HitType;
+      const auto expected = pickAll<HitType>(manager, [&](const auto& position) {
+        if (
+          const auto edgeDist =
+            camera->pickLineSegmentHandle(pickRay, position, handleRadius))
+        {
+          if (
+            const auto pointHandle =
+              grid.snap(vm::point_at_distance(pickRay, *edgeDist), position))
+          {
+            if (
+              const auto pointDist =
+                camera->pickPointHandle(pickRay, *pointHandle, handleRadius))
+            {
+              const auto hitPoint = vm::point_at_distance(pickRay, *pointDist);
+              return mdl::Hit{
+                EdgeHandleManager::HandleHitType,
+                *pointDist,
+                hitPoint,
+                HitType{position, *pointHandle}};
+            }
+          }
+        }
+        return mdl::Hit::NoHit;
+      });
+
+      const auto actual = pickIndexed<HitType>([&](auto& pickResult) {
+        manager.pickGridHandle(pickRay, *camera, grid, pickResult);
+      });
+
+      CHECK(actual == expected);
+      hitCount += expected.size();
+    }
+
+    CHECK(hitCount > 0);
+  }
+}
+
+TEST_CASE("FaceHandleManager.pick")
+{
+  const auto orthographic = GENERATE(false, true);
+  const auto camera = makeCamera(orthographic);
+  const auto handleRadius = double(pref(Preferences::HandleRadius));
+
+  auto rng = std::mt19937{0};
+  const auto handles = makePolygons(rng, HandleCount);
+
+  auto manager = FaceHandleManager{};
+  addHandles(manager, handles);
+
+  SECTION("pickCenterHandle")
+  {
+    auto hitCount = size_t(0);
+    for (const auto& pickRay : makePickRays(rng, *camera, makeTargets(handles)))
+    {
+      const auto expected = pickAll<vm::polygon3d>(manager, [&](const auto& position) {
+        if (
+          const auto pointDist =
+            camera->pickPointHandle(pickRay, position.center(), handleRadius))
+        {
+          const auto hitPoint = vm::point_at_distance(pickRay, *pointDist);
+          return mdl::Hit{
+            FaceHandleManager::HandleHitType, *pointDist, hitPoint, position};
+        }
+        return mdl::Hit::NoHit;
+      });
+
+      const auto actual = pickIndexed<vm::polygon3d>([&](auto& pickResult) {
+        manager.pickCenterHandle(pickRay, *camera, pickResult);
+      });
+
+      CHECK(actual == expected);
+      hitCount += expected.size();
+    }
+
+    CHECK(hitCount > 0);
+  }
+
+  SECTION("pickGridHandle")
+  {
+    const auto grid = Grid{2};
+
+    auto hitCount = size_t(0);
+    for (const auto& pickRay : makePickRays(rng, *camera, makeTargets(handles)))
+    {
+      using HitType = FaceHandleManager::HitType;
+      const auto expected = pickAll<HitType>(manager, [&](const auto& position) {
+        if (const auto plane = vm::from_points(position.begin(), position.end()))
+        {
+          if (
+            const auto distance = vm::intersect_ray_polygon(
+              pickRay, *plane, position.begin(), position.end()))
+          {
+            const auto pointHandle =
+              grid.snap(vm::point_at_distance(pickRay, *distance), *plane);
+            if (
+              const auto pointDist =
+                camera->pickPointHandle(pickRay, pointHandle, handleRadius))
+            {
+              const auto hitPoint = vm::point_at_distance(pickRay, *pointDist);
+              return mdl::Hit{
+                FaceHandleManager::HandleHitType,
+                *pointDist,
+                hitPoint,
+                HitType{position, pointHandle}};
+            }
+          }
+        }
+        return mdl::Hit::NoHit;
+      });
+
+      const auto actual = pickIndexed<HitType>([&](auto& pickResult) {
+        manager.pickGridHandle(pickRay, *camera, grid, pickResult);
+      });
+
+      CHECK(actual == expected);
+      hitCount += expected.size();
+    }
+
+    CHECK(hitCount > 0);
+  }
+}
+
+TEST_CASE("VertexHandleManager.lassoSelection")
+{
+  const auto orthographic = GENERATE(false, true);
+  const auto camera = makeCamera(orthographic);
+
+  auto rng = std::mt19937{0};
+
+  SECTION("Vertex handles")
+  {
+    auto manager = VertexHandleManager{};
+    addHandles(manager, makePoints(rng, HandleCount));
+    checkLassoSelection(rng, *camera, manager);
+  }
+
+  SECTION("Edge handles")
+  {
+    auto manager = EdgeHandleManager{};
+    addHandles(manager, makeSegments(rng, HandleCount));
+    checkLassoSelection(rng, *camera, manager);
+  }
+
+  SECTION("Face handles")
+  {
+    auto manager = FaceHandleManager{};
+    addHandles(manager, makePolygons(rng, HandleCount));
+    checkLassoSelection(rng, *camera, manager);
+  }
+}
+
+} // namespace tb::ui
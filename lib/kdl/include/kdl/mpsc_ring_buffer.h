@@ -0,0 +1,143 @@
+/*
+ Copyright 2024 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace kdl
+{
+
+/**
+ * A bounded, lock free queue for multiple producers and a single consumer.
+ *
+ * Every slot carries a sequence number that tells producers and the consumer whether
+ * the slot is free or holds a value for the current lap around the buffer. Producers
+ * claim a slot by advancing the shared write position with a CAS, so try_push never
+ * blocks. If the buffer is full, try_push returns false and leaves it to the caller to
+ * decide whether to retry, wait or drop the value.
+ *
+ * try_pop must only be called from one thread at a time.
+ */
+template <typename T>
+class mpsc_ring_buffer
+{
+private:
+  struct slot
+  {
+    std::atomic<size_t> sequence;
+    std::optional<T> value;
+  };
+
+  // keep the producer and consumer positions on separate cache lines
+  static constexpr size_t cache_line_size = 64;
+
+  std::unique_ptr<slot[]> m_slots;
+  size_t m_mask;
+  alignas(cache_line_size) std::atomic<size_t> m_writePos = 0;
+  alignas(cache_line_size) size_t m_readPos = 0;
+
+public:
+  /**
+   * Creates a ring buffer that can hold at least the given number of values. The
+   * capacity is rounded up to the next power of two.
+   */
+  explicit mpsc_ring_buffer(const size_t capacity)
+    : m_slots{std::make_unique<slot[]>(std::bit_ceil(std::max(capacity, size_t(2))))}
+    , m_mask{std::bit_ceil(std::max(capacity, size_t(2))) - 1}
+  {
+    for (size_t i = 0; i <= m_mask; ++i)
+    {
+      m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  mpsc_ring_buffer(const mpsc_ring_buffer&) = delete;
+  mpsc_ring_buffer& operator=(const mpsc_ring_buffer&) = delete;
+
+  size_t capacity() const { return m_mask + 1; }
+
+  /**
+   * Appends the given value to the buffer unless it is full. Can be called from any
+   * thread.
+   *
+   * @return true if the value was appended and false if the buffer was full
+   */
+  template <typename U>
+  bool try_push(U&& value)
+  {
+    auto pos = m_writePos.load(std::memory_order_relaxed);
+    while (true)
+    {
+      auto& s = m_slots[pos & m_mask];
+      const auto sequence = s.sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+      if (diff == 0)
+      {
+        if (m_writePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        {
+          s.value.emplace(std::forward<U>(value));
+          s.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+        // pos was updated by the failed CAS
+      }
+      else if (diff < 0)
+      {
+        // the consumer has not freed this slot yet
+        return false;
+      }
+      else
+      {
+        pos = m_writePos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * Removes and returns the oldest value, or returns an empty optional if the buffer is
+   * empty or if the oldest slot has been claimed but not yet written by a producer.
+   *
+   * Must only be called from the consumer thread.
+   */
+  std::optional<T> try_pop()
+  {
+    auto& s = m_slots[m_readPos & m_mask];
+    const auto sequence = s.sequence.load(std::memory_order_acquire);
+    if (static_cast<std::ptrdiff_t>(sequence - (m_readPos + 1)) < 0)
+    {
+      return std::nullopt;
+    }
+
+    auto result = std::move(s.value);
+    s.value.reset();
+    s.sequence.store(m_readPos + m_mask + 1, std::memory_order_release);
+    ++m_readPos;
+    return result;
+  }
+};
+
+} // namespace kdl
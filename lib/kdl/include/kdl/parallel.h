@@ -20,84 +20,211 @@
 
 #pragma once
 
+#include "kdl/thread_pool.h"
 #include "kdl/vector_utils.h"
 
-#ifdef _WIN32
-#include <ppl.h>
-#endif
-
+#include <algorithm>
 #include <atomic>
-#include <future> // for std::async
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <optional>
-#include <thread>
 #include <utility> // for std::declval
 #include <vector>
 
 namespace kdl
 {
+namespace detail
+{
+
+/**
+ * Shared state of a parallel_for invocation. It is shared with the tasks submitted to the
+ * thread pool because these tasks may only start running after the invocation has
+ * returned. Such late tasks cannot claim a chunk anymore and never touch run_chunk.
+ */
+struct parallel_for_state
+{
+  std::function<void(size_t, size_t)> run_chunk;
+  size_t count;
+  size_t grain_size;
+  size_t num_chunks;
+
+  std::atomic<size_t> next_chunk = 0;
+  std::atomic<bool> failed = false;
+  std::exception_ptr exception;
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  size_t completed_chunks = 0;
+
+  parallel_for_state(
+    std::function<void(size_t, size_t)> run_chunk_,
+    const size_t count_,
+    const size_t grain_size_)
+    : run_chunk{std::move(run_chunk_)}
+    , count{count_}
+    , grain_size{grain_size_}
+    , num_chunks{(count_ + grain_size_ - 1) / grain_size_}
+  {
+  }
+
+  void work()
+  {
+    auto chunk = next_chunk++;
+    while (chunk < num_chunks)
+    {
+      if (!failed)
+      {
+        const auto begin = chunk * grain_size;
+        const auto end = std::min(begin + grain_size, count);
+        try
+        {
+          run_chunk(begin, end);
+        }
+        catch (...)
+        {
+          const auto lock = std::lock_guard{mutex};
+          if (!failed.exchange(true))
+          {
+            exception = std::current_exception();
+          }
+        }
+      }
+
+      {
+        const auto lock = std::lock_guard{mutex};
+        if (++completed_chunks == num_chunks)
+        {
+          condition.notify_all();
+        }
+      }
+
+      chunk = next_chunk++;
+    }
+  }
+
+  void wait()
+  {
+    auto lock = std::unique_lock{mutex};
+    condition.wait(lock, [&]() { return completed_chunks == num_chunks; });
+  }
+};
+
+inline size_t default_grain_size(const size_t count, const size_t concurrency)
+{
+  // aim for a few chunks per worker so that uneven workloads are balanced
+  return std::max(count / (concurrency * 4), size_t(1));
+}
+
+} // namespace detail
+
 /**
  * Runs the given lambda `count` times, passing it indices `0` through `count - 1`.
  *
- * Lambda is executed in parallel, using the number of threads returned by
- * std::thread::hardware_concurrency().
+ * The indices are split into chunks of `grain_size` consecutive indices. The chunks are
+ * processed in parallel by the calling thread and the workers of the given thread pool,
+ * using at most pool.max_concurrency() threads in total. If there is only a single chunk
+ * or the pool's concurrency is capped to 1, the lambda is executed on the calling thread
+ * without involving the pool at all.
+ *
+ * Since the calling thread processes chunks itself, this function can safely be called
+ * from within a lambda passed to another invocation of parallel_for.
  *
- * Because the threads are spawned with std::async(std::launch::async, ...) and no thread
- * pool is used, there is a relatively large overhead and this should only be used on
- * large/slow to process data sets.
+ * If the lambda throws an exception, the remaining chunks are skipped and the first
+ * exception is rethrown on the calling thread.
  *
  * @tparam L type of lambda
+ * @param pool the thread pool to use
  * @param count the maximum value (exclusive) to pass to lambda
+ * @param grain_size the number of consecutive indices to process in one chunk
  * @param lambda the lambda to run
  */
 template <class L>
-void parallel_for(const size_t count, L&& lambda)
+void parallel_for(
+  thread_pool& pool, const size_t count, const size_t grain_size, L&& lambda)
 {
-#ifdef _WIN32
-  concurrency::parallel_for<size_t>(0, count, lambda);
-#else
-  auto numThreads = static_cast<size_t>(std::thread::hardware_concurrency());
-  if (numThreads == 0)
+  const auto actual_grain_size = std::max(grain_size, size_t(1));
+  const auto num_chunks = (count + actual_grain_size - 1) / actual_grain_size;
+  const auto num_threads = std::min(num_chunks, pool.max_concurrency());
+
+  if (num_threads <= 1)
   {
-    numThreads = 1;
+    for (size_t i = 0; i < count; ++i)
+    {
+      lambda(i);
+    }
+    return;
   }
 
-  auto nextIndex = std::atomic<size_t>{0};
-
-  auto threads = std::vector<std::future<void>>{};
-  threads.resize(numThreads);
-
-  for (size_t i = 0; i < numThreads; ++i)
-  {
-    threads[i] = std::async(std::launch::async, [&]() {
-      while (true)
+  auto state = std::make_shared<detail::parallel_for_state>(
+    [&](const size_t begin, const size_t end) {
+      for (size_t i = begin; i < end; ++i)
       {
-        const size_t ourIndex = std::atomic_fetch_add(&nextIndex, static_cast<size_t>(1));
-        if (ourIndex >= count)
-        {
-          break;
-        }
-        lambda(ourIndex);
+        lambda(i);
       }
-    });
+    },
+    count,
+    actual_grain_size);
+
+  for (size_t i = 1; i < num_threads; ++i)
+  {
+    pool.submit([state]() { state->work(); });
   }
 
-  for (size_t i = 0; i < numThreads; ++i)
+  state->work();
+  state->wait();
+
+  if (state->exception)
   {
-    threads[i].wait();
+    std::rethrow_exception(state->exception);
   }
-#endif
+}
+
+/**
+ * Runs the given lambda `count` times, passing it indices `0` through `count - 1`.
+ *
+ * The lambda is executed in parallel on the default thread pool, see the documentation
+ * of the overload above.
+ *
+ * @tparam L type of lambda
+ * @param count the maximum value (exclusive) to pass to lambda
+ * @param grain_size the number of consecutive indices to process in one chunk
+ * @param lambda the lambda to run
+ */
+template <class L>
+void parallel_for(const size_t count, const size_t grain_size, L&& lambda)
+{
+  parallel_for(default_thread_pool(), count, grain_size, std::forward<L>(lambda));
+}
+
+/**
+ * Runs the given lambda `count` times, passing it indices `0` through `count - 1`.
+ *
+ * The lambda is executed in parallel on the default thread pool. The grain size is
+ * chosen such that every thread processes a few chunks.
+ *
+ * @tparam L type of lambda
+ * @param count the maximum value (exclusive) to pass to lambda
+ * @param lambda the lambda to run
+ */
+template <class L>
+void parallel_for(const size_t count, L&& lambda)
+{
+  auto& pool = default_thread_pool();
+  parallel_for(
+    pool,
+    count,
+    detail::default_grain_size(count, pool.max_concurrency()),
+    std::forward<L>(lambda));
 }
 
 /**
  * Applies the given lambda to each element of the input (passing elements as rvalue
  * references), and returns a vector of the resulting values, in their original order.
  *
- * The lambda is executed in parallel, using the number of threads returned by
- * std::thread::hardware_concurrency().
- *
- * Because the threads are spawned with std::async(std::launch::async, ...) and no thread
- * pool is used, there is a relatively large overhead and this should only be used on
- * large/slow to process data sets.
+ * The lambda is executed in parallel on the default thread pool using parallel_for.
  *
  * @tparam T the type of the vector elements
  * @tparam L the type of the lambda to apply
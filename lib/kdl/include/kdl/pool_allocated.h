@@ -0,0 +1,429 @@
+/*
+ Copyright 2024 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace kdl
+{
+
+/**
+ * Allocates memory blocks of a fixed size and alignment.
+ *
+ * The blocks are carved out of chunks of 64 KiB. Every chunk belongs to a heap, and every
+ * thread that allocates blocks owns one heap. Allocating a block and deallocating a block
+ * of the calling thread's heap do not need any synchronization unless a new chunk must be
+ * allocated.
+ *
+ * A block that is deallocated by another thread is pushed onto an atomic list of its
+ * heap, which the owning thread takes over once its own free list is empty. This returns
+ * blocks to the heap they came from, e.g. when objects are created by worker threads and
+ * destroyed by the main thread, so that the worker threads reuse their chunks instead of
+ * allocating new ones. When a thread exits, its heap is kept with all of its blocks and
+ * handed to the next thread that needs a heap.
+ *
+ * Chunks that contain no allocated blocks are returned to the system by trim(). Every
+ * thread calls it automatically after it has deallocated a number of blocks that is
+ * proportional to the number of free blocks that remained after its previous call, so
+ * that the cost of trimming is amortized over the deallocations. A thread trims its own
+ * heap and the heaps of exited threads, and it trims its own heap before it exits. The
+ * chunks of a heap whose thread is alive but no longer deallocates any blocks are not
+ * released until that thread deallocates or trims again.
+ *
+ * @tparam Size the size of the blocks
+ * @tparam Alignment the alignment of the blocks
+ */
+template <std::size_t Size, std::size_t Alignment>
+class fixed_size_pool
+{
+private:
+  union block
+  {
+    block* next;
+    alignas(Alignment) unsigned char storage[Size];
+  };
+
+  struct heap
+  {
+    block* free_list = nullptr;
+    std::atomic<block*> remote_free_list = nullptr;
+  };
+
+  // chunks are aligned to their size so that a block's chunk can be found by masking the
+  // block's address, every chunk starts with a header
+  struct chunk_header
+  {
+    heap* owner;
+    // only used while trimming the owning heap
+    std::size_t free_blocks = 0;
+    chunk_header* next_empty = nullptr;
+  };
+
+  static constexpr std::size_t chunk_size = 64 * 1024;
+  static constexpr std::size_t chunk_header_size =
+    (sizeof(chunk_header) + alignof(block) - 1) / alignof(block) * alignof(block);
+  static constexpr std::size_t blocks_per_chunk =
+    (chunk_size - chunk_header_size) / sizeof(block);
+
+  static_assert(blocks_per_chunk > 0, "block size exceeds chunk size");
+
+  // the minimum number of deallocations between two automatic calls to trim()
+  static constexpr std::size_t min_trim_interval = 4 * blocks_per_chunk;
+
+  struct registry
+  {
+    std::mutex mutex;
+    std::size_t chunk_count = 0;
+    // heaps whose threads have exited
+    std::vector<heap*> abandoned_heaps;
+  };
+
+  // releases the heap when its thread exits
+  struct heap_owner
+  {
+    heap* owned_heap = acquire_heap();
+
+    ~heap_owner()
+    {
+      release_chunks(release_empty_chunks(*owned_heap).released_chunks);
+
+      thread_state().current_heap = nullptr;
+      thread_state().exited = true;
+      abandon_heap(owned_heap);
+    }
+  };
+
+  struct thread_data
+  {
+    heap* current_heap = nullptr;
+    bool exited = false;
+    std::size_t deallocations = 0;
+    std::size_t trim_interval = min_trim_interval;
+  };
+
+  struct trim_result
+  {
+    std::size_t released_chunks = 0;
+    std::size_t remaining_free_blocks = 0;
+  };
+
+public:
+  /**
+   * Returns a block of uninitialized memory.
+   *
+   * @throws std::bad_alloc if a new chunk must be allocated and that fails
+   */
+  static void* allocate()
+  {
+    auto& h = local_heap();
+    if (!h.free_list)
+    {
+      h.free_list = h.remote_free_list.exchange(nullptr, std::memory_order_acquire);
+      if (!h.free_list)
+      {
+        h.free_list = allocate_chunk(h);
+      }
+    }
+
+    auto* result = h.free_list;
+    h.free_list = result->next;
+    return result;
+  }
+
+  /**
+   * Returns the given block to the heap it was allocated from. The block must have been
+   * returned by a call to allocate().
+   */
+  static void deallocate(void* ptr) noexcept
+  {
+    if (ptr)
+    {
+      auto* b = static_cast<block*>(ptr);
+      auto& owner = owning_heap(b);
+      if (&owner == thread_state().current_heap)
+      {
+        b->next = owner.free_list;
+        owner.free_list = b;
+      }
+      else
+      {
+        b->next = owner.remote_free_list.load(std::memory_order_relaxed);
+        while (!owner.remote_free_list.compare_exchange_weak(
+          b->next, b, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+      }
+
+      auto& state = thread_state();
+      if (++state.deallocations >= state.trim_interval)
+      {
+        trim();
+      }
+    }
+  }
+
+  /**
+   * Returns the chunks of the calling thread's heap and of the heaps of exited threads
+   * that contain no allocated blocks to the system.
+   *
+   * Blocks that other threads deallocate while this function runs may not be considered,
+   * so their chunks are released by a later call.
+   */
+  static void trim() noexcept
+  {
+    auto& state = thread_state();
+
+    auto result = trim_result{};
+    if (state.current_heap)
+    {
+      result = release_empty_chunks(*state.current_heap);
+    }
+
+    auto& r = get_registry();
+    {
+      const auto lock = std::lock_guard{r.mutex};
+      // the heaps of exited threads are only used by threads that hold the lock
+      for (auto* h : r.abandoned_heaps)
+      {
+        const auto abandoned_result = release_empty_chunks(*h);
+        result.released_chunks += abandoned_result.released_chunks;
+        result.remaining_free_blocks += abandoned_result.remaining_free_blocks;
+      }
+    }
+    release_chunks(result.released_chunks);
+
+    state.deallocations = 0;
+    state.trim_interval = std::max(min_trim_interval, result.remaining_free_blocks);
+  }
+
+  /**
+   * Returns the number of chunks that have been allocated by all threads.
+   */
+  static std::size_t chunk_count()
+  {
+    auto& r = get_registry();
+    const auto lock = std::lock_guard{r.mutex};
+    return r.chunk_count;
+  }
+
+private:
+  static thread_data& thread_state()
+  {
+    thread_local auto data = thread_data{};
+    return data;
+  }
+
+  static heap& local_heap()
+  {
+    auto& state = thread_state();
+    if (!state.current_heap)
+    {
+      if (state.exited)
+      {
+        // the thread is being torn down and has already given up its heap, so it gets a
+        // heap that is never abandoned
+        state.current_heap = acquire_heap();
+      }
+      else
+      {
+        thread_local auto owner = heap_owner{};
+        state.current_heap = owner.owned_heap;
+      }
+    }
+    return *state.current_heap;
+  }
+
+  static chunk_header& owning_chunk(block* b)
+  {
+    const auto address = reinterpret_cast<std::uintptr_t>(b);
+    return *reinterpret_cast<chunk_header*>(address & ~std::uintptr_t(chunk_size - 1));
+  }
+
+  static heap& owning_heap(block* b) { return *owning_chunk(b).owner; }
+
+  /**
+   * Deallocates the chunks of the given heap whose blocks are all free and removes their
+   * blocks from the heap's free list. The calling thread must own the heap.
+   *
+   * Returns the number of deallocated chunks, which the caller must subtract from the
+   * chunk count, and the number of remaining free blocks.
+   */
+  static trim_result release_empty_chunks(heap& h) noexcept
+  {
+    // take over the blocks that other threads have deallocated
+    if (
+      auto* remote_blocks =
+        h.remote_free_list.exchange(nullptr, std::memory_order_acquire))
+    {
+      auto* last = remote_blocks;
+      while (last->next)
+      {
+        last = last->next;
+      }
+      last->next = h.free_list;
+      h.free_list = remote_blocks;
+    }
+
+    for (auto* b = h.free_list; b; b = b->next)
+    {
+      ++owning_chunk(b).free_blocks;
+    }
+
+    // rebuild the free list from the blocks of the chunks that remain, and link the
+    // empty chunks, whose counters are set past the number of blocks once they are seen
+    auto result = trim_result{};
+    auto* empty_chunks = static_cast<chunk_header*>(nullptr);
+    auto** tail = &h.free_list;
+    for (auto* b = h.free_list; b;)
+    {
+      auto* next = b->next;
+      auto& chunk = owning_chunk(b);
+      if (chunk.free_blocks < blocks_per_chunk)
+      {
+        chunk.free_blocks = 0;
+        *tail = b;
+        tail = &b->next;
+        ++result.remaining_free_blocks;
+      }
+      else if (chunk.free_blocks == blocks_per_chunk)
+      {
+        chunk.free_blocks = blocks_per_chunk + 1;
+        chunk.next_empty = empty_chunks;
+        empty_chunks = &chunk;
+      }
+      b = next;
+    }
+    *tail = nullptr;
+
+    while (empty_chunks)
+    {
+      auto* next = empty_chunks->next_empty;
+      ::operator delete(empty_chunks, std::align_val_t{chunk_size});
+      empty_chunks = next;
+      ++result.released_chunks;
+    }
+
+    return result;
+  }
+
+  static void release_chunks(const std::size_t count) noexcept
+  {
+    if (count > 0)
+    {
+      auto& r = get_registry();
+      const auto lock = std::lock_guard{r.mutex};
+      r.chunk_count -= count;
+    }
+  }
+
+  static registry& get_registry()
+  {
+    // never destroyed so that blocks can still be released during static destruction
+    static auto* r = new registry{};
+    return *r;
+  }
+
+  static heap* acquire_heap()
+  {
+    auto& r = get_registry();
+    {
+      const auto lock = std::lock_guard{r.mutex};
+      if (!r.abandoned_heaps.empty())
+      {
+        auto* h = r.abandoned_heaps.back();
+        r.abandoned_heaps.pop_back();
+        return h;
+      }
+    }
+
+    // heaps are never destroyed because their chunks may still be in use
+    return new heap{};
+  }
+
+  static void abandon_heap(heap* h)
+  {
+    auto& r = get_registry();
+    const auto lock = std::lock_guard{r.mutex};
+    r.abandoned_heaps.push_back(h);
+  }
+
+  static block* allocate_chunk(heap& h)
+  {
+    auto* chunk = static_cast<unsigned char*>(
+      ::operator new(chunk_size, std::align_val_t{chunk_size}));
+    new (chunk) chunk_header{&h};
+
+    auto* blocks = reinterpret_cast<block*>(chunk + chunk_header_size);
+    for (std::size_t i = 0; i + 1 < blocks_per_chunk; ++i)
+    {
+      blocks[i].next = &blocks[i + 1];
+    }
+    blocks[blocks_per_chunk - 1].next = nullptr;
+
+    auto& r = get_registry();
+    const auto lock = std::lock_guard{r.mutex};
+    ++r.chunk_count;
+
+    return blocks;
+  }
+};
+
+/**
+ * A base class that allocates instances of T from a fixed_size_pool using class specific
+ * operator new and operator delete. This speeds up creating and destroying many small
+ * objects such as the nodes of a linked data structure.
+ *
+ * Derive T from pool_allocated<T>. Types derived from T that are larger than T fall back
+ * to the global operator new and operator delete.
+ *
+ * @tparam T the type of the objects to allocate
+ */
+template <typename T>
+class pool_allocated
+{
+public:
+  static void* operator new(const std::size_t size)
+  {
+    using pool = fixed_size_pool<sizeof(T), alignof(T)>;
+    return size == sizeof(T) ? pool::allocate() : ::operator new(size);
+  }
+
+  static void operator delete(void* ptr, const std::size_t size) noexcept
+  {
+    using pool = fixed_size_pool<sizeof(T), alignof(T)>;
+    if (size == sizeof(T))
+    {
+      pool::deallocate(ptr);
+    }
+    else
+    {
+      ::operator delete(ptr);
+    }
+  }
+};
+
+} // namespace kdl
@@ -25,11 +25,14 @@
 #include <algorithm>
 #include <cassert>
 #include <charconv>
+#include <cstdint>
 #include <iterator>
+#include <limits>
 #include <optional>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 
 namespace kdl
@@ -291,6 +294,75 @@ inline auto skip_whitespace(const std::string_view str)
   const auto first = str.find_first_not_of(Whitespace);
   return first != std::string::npos ? str.substr(first) : std::string_view{};
 }
+
+/**
+ * Interprets the given string as a plain decimal number of the form [-]digits[.digits]
+ * that is optionally followed by whitespace. Returns an empty optional if the string has
+ * any other form or if its value cannot be computed exactly by a single division.
+ *
+ * If the digits form an integer that can be represented exactly by T and the number of
+ * fractional digits is small enough for the corresponding power of ten to also be exact,
+ * the division yields the correctly rounded result. This covers the vast majority of the
+ * numbers in map files and avoids the general conversion routines.
+ */
+template <typename T>
+std::optional<T> str_to_plain_decimal(const std::string_view str)
+{
+  static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>);
+
+  constexpr auto max_mantissa = std::uint64_t(1) << std::numeric_limits<T>::digits;
+  constexpr auto max_exponent = std::is_same_v<T, float> ? 10 : 22;
+  constexpr double powers_of_ten[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                      1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                      1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+  auto it = str.begin();
+  const auto end = str.end();
+
+  const auto negative = it != end && *it == '-';
+  if (negative)
+  {
+    ++it;
+  }
+
+  auto mantissa = std::uint64_t(0);
+  auto digits = 0;
+  auto exponent = 0;
+  auto fraction = false;
+
+  for (; it != end; ++it)
+  {
+    const auto c = *it;
+    if (c >= '0' && c <= '9')
+    {
+      mantissa = mantissa * 10 + std::uint64_t(c - '0');
+      if (mantissa > max_mantissa)
+      {
+        return std::nullopt;
+      }
+      ++digits;
+      exponent += fraction ? 1 : 0;
+    }
+    else if (c == '.' && !fraction)
+    {
+      fraction = true;
+    }
+    else
+    {
+      break;
+    }
+  }
+
+  if (
+    digits == 0 || exponent > max_exponent
+    || (it != end && std::string_view{Whitespace}.find(*it) == std::string_view::npos))
+  {
+    return std::nullopt;
+  }
+
+  const auto value = T(mantissa) / T(powers_of_ten[exponent]);
+  return negative ? -value : value;
+}
 } // namespace detail
 
 /**
@@ -406,6 +478,11 @@ inline std::optional<std::size_t> str_to_size(std::string_view str)
 inline std::optional<float> str_to_float(std::string_view str)
 {
   str = detail::skip_whitespace(str);
+  if (const auto value = detail::str_to_plain_decimal<float>(str))
+  {
+    return value;
+  }
+
 #if defined(__clang__) || (defined(__GNUC__) && __GNUC__ < 11)
   // std::from_chars is not yet implemented for float
   try
@@ -439,6 +516,11 @@ inline std::optional<float> str_to_float(std::string_view str)
 inline std::optional<double> str_to_double(std::string_view str)
 {
   str = detail::skip_whitespace(str);
+  if (const auto value = detail::str_to_plain_decimal<double>(str))
+  {
+    return value;
+  }
+
 #if defined(__clang__) || (defined(__GNUC__) && __GNUC__ < 11)
   // std::from_chars is not yet implemented for double
   try
@@ -0,0 +1,291 @@
+/*
+ Copyright 2024 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace kdl
+{
+
+/**
+ * A work stealing thread pool.
+ *
+ * Every worker owns a task queue. Tasks submitted from a worker thread are pushed onto
+ * that worker's queue, and tasks submitted from other threads are distributed over the
+ * worker queues in a round robin fashion. A worker takes tasks from the back of its own
+ * queue and, if that is empty, steals tasks from the front of the other workers' queues.
+ *
+ * Worker threads are spawned lazily when the first task is submitted. The number of
+ * workers can be capped with set_max_concurrency, but it can never exceed the capacity
+ * that was passed to the constructor.
+ *
+ * Tasks must not block on other tasks submitted to the same pool because the workers
+ * might all be busy. Use parallel_for (see parallel.h) for fork / join style
+ * parallelism, it lets the calling thread participate and is thus safe to nest.
+ */
+class thread_pool
+{
+public:
+  using task = std::function<void()>;
+
+private:
+  struct worker_queue
+  {
+    std::mutex mutex;
+    std::deque<task> tasks;
+  };
+
+  struct current_worker
+  {
+    const thread_pool* pool = nullptr;
+    size_t index = 0;
+  };
+
+  std::vector<std::unique_ptr<worker_queue>> m_queues;
+  std::vector<std::thread> m_threads;
+
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::atomic<size_t> m_pendingTasks = 0;
+  std::atomic<size_t> m_maxConcurrency;
+  std::atomic<size_t> m_nextQueue = 0;
+  bool m_stopped = false;
+
+public:
+  /**
+   * Creates a thread pool that can use up to the given number of workers. If 0 is
+   * passed, std::thread::hardware_concurrency() is used instead.
+   */
+  explicit thread_pool(const size_t capacity = 0)
+    : m_maxConcurrency{std::max(default_capacity(capacity), size_t(1))}
+  {
+    const auto actualCapacity = m_maxConcurrency.load();
+    m_queues.reserve(actualCapacity);
+    for (size_t i = 0; i < actualCapacity; ++i)
+    {
+      m_queues.push_back(std::make_unique<worker_queue>());
+    }
+    m_threads.reserve(actualCapacity);
+  }
+
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+  /**
+   * Stops the pool. Tasks that are still queued are executed before the workers are
+   * joined.
+   */
+  ~thread_pool()
+  {
+    {
+      const auto lock = std::lock_guard{m_mutex};
+      m_stopped = true;
+    }
+    m_condition.notify_all();
+
+    for (auto& thread : m_threads)
+    {
+      thread.join();
+    }
+  }
+
+  /**
+   * The maximum number of workers this pool can ever use.
+   */
+  size_t capacity() const { return m_queues.size(); }
+
+  /**
+   * The number of workers that are currently allowed to run tasks.
+   */
+  size_t max_concurrency() const { return m_maxConcurrency; }
+
+  /**
+   * Caps the number of workers that are allowed to run tasks. The given value is
+   * clamped to [1, capacity()].
+   *
+   * Workers that were already spawned are kept alive, but tasks submitted afterwards are
+   * only distributed to the first max_concurrency() workers. Idle workers will still
+   * steal work, so this is a soft limit for callers that submit independent tasks.
+   * parallel_for honors this value exactly because it never submits more tasks than
+   * max_concurrency() - 1.
+   */
+  void set_max_concurrency(const size_t maxConcurrency)
+  {
+    m_maxConcurrency = std::clamp(maxConcurrency, size_t(1), capacity());
+  }
+
+  /**
+   * The number of worker threads that have been spawned so far.
+   */
+  size_t worker_count()
+  {
+    const auto lock = std::lock_guard{m_mutex};
+    return m_threads.size();
+  }
+
+  /**
+   * Indicates whether the calling thread is one of this pool's workers.
+   */
+  bool is_worker_thread() const { return this_worker().pool == this; }
+
+  /**
+   * Submits the given task for execution on one of the workers.
+   */
+  void submit(task t)
+  {
+    const auto queueIndex = select_queue();
+
+    {
+      const auto lock = std::lock_guard{m_mutex};
+      spawn_workers(queueIndex + 1);
+      ++m_pendingTasks;
+    }
+
+    {
+      auto& queue = *m_queues[queueIndex];
+      const auto lock = std::lock_guard{queue.mutex};
+      queue.tasks.push_back(std::move(t));
+    }
+
+    m_condition.notify_one();
+  }
+
+private:
+  static size_t default_capacity(const size_t capacity)
+  {
+    return capacity > 0 ? capacity : size_t(std::thread::hardware_concurrency());
+  }
+
+  static current_worker& this_worker()
+  {
+    thread_local auto worker = current_worker{};
+    return worker;
+  }
+
+  size_t select_queue()
+  {
+    if (const auto& worker = this_worker(); worker.pool == this)
+    {
+      return worker.index;
+    }
+    return m_nextQueue++ % m_maxConcurrency;
+  }
+
+  /**
+   * Must be called with m_mutex locked.
+   */
+  void spawn_workers(const size_t count)
+  {
+    while (m_threads.size() < std::min(count, capacity()))
+    {
+      const auto index = m_threads.size();
+      m_threads.emplace_back([this, index]() { run_worker(index); });
+    }
+  }
+
+  std::optional<task> pop_task(const size_t index)
+  {
+    if (auto t = pop_back(*m_queues[index]))
+    {
+      return t;
+    }
+
+    for (size_t i = 1; i < m_queues.size(); ++i)
+    {
+      if (auto t = pop_front(*m_queues[(index + i) % m_queues.size()]))
+      {
+        return t;
+      }
+    }
+
+    return std::nullopt;
+  }
+
+  std::optional<task> pop_back(worker_queue& queue)
+  {
+    const auto lock = std::lock_guard{queue.mutex};
+    if (queue.tasks.empty())
+    {
+      return std::nullopt;
+    }
+
+    auto t = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    --m_pendingTasks;
+    return t;
+  }
+
+  std::optional<task> pop_front(worker_queue& queue)
+  {
+    const auto lock = std::lock_guard{queue.mutex};
+    if (queue.tasks.empty())
+    {
+      return std::nullopt;
+    }
+
+    auto t = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    --m_pendingTasks;
+    return t;
+  }
+
+  void run_worker(const size_t index)
+  {
+    this_worker() = current_worker{this, index};
+
+    while (true)
+    {
+      if (auto t = pop_task(index))
+      {
+        (*t)();
+        continue;
+      }
+
+      auto lock = std::unique_lock{m_mutex};
+      m_condition.wait(lock, [&]() { return m_stopped || m_pendingTasks > 0; });
+      if (m_stopped && m_pendingTasks == 0)
+      {
+        return;
+      }
+    }
+  }
+};
+
+/**
+ * Returns the process wide thread pool that is used by parallel_for and
+ * vec_parallel_transform.
+ */
+inline thread_pool& default_thread_pool()
+{
+  static auto pool = thread_pool{};
+  return pool;
+}
+
+} // namespace kdl
@@ -0,0 +1,121 @@
+/*
+ Copyright 2024 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#include "kdl/mpsc_ring_buffer.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "catch2.h"
+
+namespace kdl
+{
+
+TEST_CASE("mpsc_ring_buffer")
+{
+  SECTION("capacity is rounded up to a power of two")
+  {
+    CHECK(mpsc_ring_buffer<int>{0}.capacity() == 2);
+    CHECK(mpsc_ring_buffer<int>{4}.capacity() == 4);
+    CHECK(mpsc_ring_buffer<int>{5}.capacity() == 8);
+  }
+
+  SECTION("try_pop on an empty buffer")
+  {
+    auto buffer = mpsc_ring_buffer<std::string>{4};
+    CHECK(buffer.try_pop() == std::nullopt);
+  }
+
+  SECTION("values are popped in the order they were pushed")
+  {
+    auto buffer = mpsc_ring_buffer<std::string>{4};
+    CHECK(buffer.try_push("a"));
+    CHECK(buffer.try_push(std::string{"b"}));
+    CHECK(buffer.try_pop() == "a");
+    CHECK(buffer.try_push("c"));
+    CHECK(buffer.try_pop() == "b");
+    CHECK(buffer.try_pop() == "c");
+    CHECK(buffer.try_pop() == std::nullopt);
+  }
+
+  SECTION("try_push fails when the buffer is full")
+  {
+    auto buffer = mpsc_ring_buffer<int>{2};
+    CHECK(buffer.try_push(1));
+    CHECK(buffer.try_push(2));
+    CHECK_FALSE(buffer.try_push(3));
+
+    CHECK(buffer.try_pop() == 1);
+    CHECK(buffer.try_push(3));
+    CHECK(buffer.try_pop() == 2);
+    CHECK(buffer.try_pop() == 3);
+  }
+
+  SECTION("concurrent producers")
+  {
+    constexpr auto producerCount = size_t(4);
+    constexpr auto valuesPerProducer = size_t(10000);
+
+    auto buffer = mpsc_ring_buffer<size_t>{64};
+
+    auto producers = std::vector<std::thread>{};
+    for (size_t p = 0; p < producerCount; ++p)
+    {
+      producers.emplace_back([&, p]() {
+        for (size_t i = 0; i < valuesPerProducer; ++i)
+        {
+          while (!buffer.try_push(p * valuesPerProducer + i))
+          {
+            std::this_thread::yield();
+          }
+        }
+      });
+    }
+
+    // the values of every producer must arrive in order
+    auto nextValues = std::vector<size_t>(producerCount, 0);
+    auto received = size_t(0);
+    while (received < producerCount * valuesPerProducer)
+    {
+      if (const auto value = buffer.try_pop())
+      {
+        const auto producer = *value / valuesPerProducer;
+        REQUIRE(*value % valuesPerProducer == nextValues[producer]);
+        ++nextValues[producer];
+        ++received;
+      }
+      else
+      {
+        std::this_thread::yield();
+      }
+    }
+
+    for (auto& producer : producers)
+    {
+      producer.join();
+    }
+
+    CHECK(nextValues == std::vector<size_t>(producerCount, valuesPerProducer));
+    CHECK(buffer.try_pop() == std::nullopt);
+  }
+}
+
+} // namespace kdl
@@ -19,12 +19,15 @@
 */
 
 #include "kdl/parallel.h"
+#include "kdl/thread_pool.h"
 
 #include <array>
 #include <atomic>
 #include <chrono>
 #include <iostream>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "catch2.h"
@@ -72,6 +75,93 @@ TEST_CASE("for 10000")
   }
 }
 
+TEST_CASE("for with grain size")
+{
+  constexpr size_t TestSize = 1'000;
+
+  auto pool = thread_pool{4};
+
+  const auto grainSizes = {size_t(0), size_t(1), size_t(7), size_t(1'000), size_t(5'000)};
+  for (const auto grainSize : grainSizes)
+  {
+    CAPTURE(grainSize);
+
+    std::array<std::atomic<size_t>, TestSize> counts;
+    for (auto& count : counts)
+    {
+      count = 0;
+    }
+
+    kdl::parallel_for(pool, TestSize, grainSize, [&](const size_t i) { ++counts[i]; });
+
+    for (const auto& count : counts)
+    {
+      CHECK(count == 1);
+    }
+  }
+}
+
+TEST_CASE("for with capped concurrency")
+{
+  auto pool = thread_pool{4};
+  pool.set_max_concurrency(1);
+
+  const auto callerId = std::this_thread::get_id();
+  auto ranOnOtherThread = std::atomic<bool>{false};
+
+  kdl::parallel_for(pool, 1'000, 1, [&](const size_t) {
+    if (std::this_thread::get_id() != callerId)
+    {
+      ranOnOtherThread = true;
+    }
+  });
+
+  CHECK_FALSE(ranOnOtherThread);
+  CHECK(pool.worker_count() == 0);
+}
+
+TEST_CASE("nested for")
+{
+  constexpr size_t OuterSize = 64;
+  constexpr size_t InnerSize = 64;
+
+  auto pool = thread_pool{2};
+
+  std::array<std::atomic<size_t>, OuterSize * InnerSize> counts;
+  for (auto& count : counts)
+  {
+    count = 0;
+  }
+
+  kdl::parallel_for(pool, OuterSize, 1, [&](const size_t i) {
+    kdl::parallel_for(
+      pool, InnerSize, 1, [&](const size_t j) { ++counts[i * InnerSize + j]; });
+  });
+
+  for (const auto& count : counts)
+  {
+    CHECK(count == 1);
+  }
+}
+
+TEST_CASE("for rethrows exceptions")
+{
+  auto pool = thread_pool{4};
+
+  CHECK_THROWS_AS(
+    kdl::parallel_for(
+      pool,
+      1'000,
+      1,
+      [](const size_t i) {
+        if (i == 500)
+        {
+          throw std::runtime_error{"error"};
+        }
+      }),
+    std::runtime_error);
+}
+
 TEST_CASE("transform")
 {
   const auto L = [](const int& v) { return v * 10; };
@@ -0,0 +1,319 @@
+/*
+ Copyright 2024 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#include "kdl/pool_allocated.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "catch2.h"
+
+namespace kdl
+{
+namespace
+{
+
+struct pooled_item : public pool_allocated<pooled_item>
+{
+  int value;
+
+  explicit pooled_item(const int i_value)
+    : value{i_value}
+  {
+  }
+};
+
+struct alignas(32) aligned_pooled_item : public pool_allocated<aligned_pooled_item>
+{
+  double value = 0.0;
+};
+
+struct larger_pooled_item : public pooled_item
+{
+  int other_value[16] = {};
+
+  larger_pooled_item()
+    : pooled_item{0}
+  {
+  }
+};
+
+} // namespace
+
+TEST_CASE("fixed_size_pool")
+{
+  using pool = fixed_size_pool<24, 8>;
+
+  SECTION("reuses deallocated blocks")
+  {
+    auto* block = pool::allocate();
+    pool::deallocate(block);
+    CHECK(pool::allocate() == block);
+    pool::deallocate(block);
+  }
+
+  SECTION("allocates new chunks when exhausted")
+  {
+    const auto chunkCount = pool::chunk_count();
+
+    auto blocks = std::vector<void*>{};
+    for (size_t i = 0; i < 10'000; ++i)
+    {
+      blocks.push_back(pool::allocate());
+    }
+    CHECK(pool::chunk_count() > chunkCount);
+
+    for (auto* block : blocks)
+    {
+      pool::deallocate(block);
+    }
+  }
+
+  SECTION("blocks deallocated by other threads are returned to their heap")
+  {
+    auto blocks = std::vector<void*>{};
+
+    const auto allocateAndFree = [&]() {
+      for (size_t i = 0; i < 10'000; ++i)
+      {
+        blocks.push_back(pool::allocate());
+      }
+
+      auto thread = std::thread{[&]() {
+        for (auto* block : blocks)
+        {
+          pool::deallocate(block);
+        }
+      }};
+      thread.join();
+      blocks.clear();
+    };
+
+    allocateAndFree();
+    const auto chunkCount = pool::chunk_count();
+
+    for (size_t i = 0; i < 10; ++i)
+    {
+      allocateAndFree();
+    }
+    CHECK(pool::chunk_count() == chunkCount);
+  }
+
+  SECTION("blocks allocated by exited threads are reused")
+  {
+    using other_pool = fixed_size_pool<40, 8>;
+
+    auto blocks = std::vector<void*>{};
+
+    const auto allocateOnThreadAndFree = [&]() {
+      auto thread = std::thread{[&]() {
+        for (size_t i = 0; i < 10'000; ++i)
+        {
+          blocks.push_back(other_pool::allocate());
+        }
+      }};
+      thread.join();
+
+      for (auto* block : blocks)
+      {
+        other_pool::deallocate(block);
+      }
+      blocks.clear();
+
+      // the number of chunks that are released automatically depends on when the
+      // deallocations trigger trimming
+      other_pool::trim();
+    };
+
+    allocateOnThreadAndFree();
+    const auto chunkCount = other_pool::chunk_count();
+
+    for (size_t i = 0; i < 10; ++i)
+    {
+      allocateOnThreadAndFree();
+    }
+    CHECK(other_pool::chunk_count() == chunkCount);
+  }
+
+  SECTION("empty chunks are released")
+  {
+    using other_pool = fixed_size_pool<56, 8>;
+    other_pool::trim();
+    const auto chunkCount = other_pool::chunk_count();
+
+    auto blocks = std::vector<void*>{};
+    for (size_t i = 0; i < 10'000; ++i)
+    {
+      blocks.push_back(other_pool::allocate());
+    }
+    REQUIRE(other_pool::chunk_count() > chunkCount + 1);
+
+    SECTION("when all blocks are deallocated")
+    {
+      for (auto* block : blocks)
+      {
+        other_pool::deallocate(block);
+      }
+      other_pool::trim();
+      CHECK(other_pool::chunk_count() == chunkCount);
+    }
+
+    SECTION("except for chunks with allocated blocks")
+    {
+      for (size_t i = 1; i < blocks.size(); ++i)
+      {
+        other_pool::deallocate(blocks[i]);
+      }
+      other_pool::trim();
+      CHECK(other_pool::chunk_count() == chunkCount + 1);
+
+      other_pool::deallocate(blocks.front());
+      other_pool::trim();
+      CHECK(other_pool::chunk_count() == chunkCount);
+    }
+
+    SECTION("when blocks are deallocated by other threads")
+    {
+      auto thread = std::thread{[&]() {
+        for (auto* block : blocks)
+        {
+          other_pool::deallocate(block);
+        }
+      }};
+      thread.join();
+
+      other_pool::trim();
+      CHECK(other_pool::chunk_count() == chunkCount);
+    }
+
+    SECTION("automatically when many blocks are deallocated")
+    {
+      const auto allocatedChunkCount = other_pool::chunk_count();
+      for (auto* block : blocks)
+      {
+        other_pool::deallocate(block);
+      }
+      CHECK(other_pool::chunk_count() < allocatedChunkCount);
+    }
+  }
+
+  SECTION("empty chunks of exited threads are released")
+  {
+    using other_pool = fixed_size_pool<72, 8>;
+    const auto chunkCount = other_pool::chunk_count();
+
+    auto blocks = std::vector<void*>{};
+    auto thread = std::thread{[&]() {
+      for (size_t i = 0; i < 10'000; ++i)
+      {
+        blocks.push_back(other_pool::allocate());
+      }
+    }};
+    thread.join();
+    REQUIRE(other_pool::chunk_count() > chunkCount);
+
+    for (auto* block : blocks)
+    {
+      other_pool::deallocate(block);
+    }
+    other_pool::trim();
+    CHECK(other_pool::chunk_count() == chunkCount);
+  }
+
+  SECTION("blocks can be deallocated concurrently")
+  {
+    auto blocks = std::vector<void*>{};
+    for (size_t i = 0; i < 10'000; ++i)
+    {
+      blocks.push_back(pool::allocate());
+    }
+
+    auto threads = std::vector<std::thread>{};
+    for (size_t t = 0; t < 4; ++t)
+    {
+      threads.emplace_back([&, t]() {
+        for (size_t i = t; i < blocks.size(); i += 4)
+        {
+          pool::deallocate(blocks[i]);
+        }
+      });
+    }
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+
+    const auto chunkCount = pool::chunk_count();
+
+    auto reallocated = std::vector<void*>{};
+    for (size_t i = 0; i < blocks.size(); ++i)
+    {
+      reallocated.push_back(pool::allocate());
+    }
+    CHECK(pool::chunk_count() == chunkCount);
+
+    std::sort(reallocated.begin(), reallocated.end());
+    CHECK(std::adjacent_find(reallocated.begin(), reallocated.end()) == reallocated.end());
+
+    for (auto* block : reallocated)
+    {
+      pool::deallocate(block);
+    }
+  }
+}
+
+TEST_CASE("pool_allocated")
+{
+  SECTION("new and delete")
+  {
+    auto items = std::vector<std::unique_ptr<pooled_item>>{};
+    for (int i = 0; i < 1'000; ++i)
+    {
+      items.push_back(std::make_unique<pooled_item>(i));
+    }
+
+    for (int i = 0; i < 1'000; ++i)
+    {
+      CHECK(items[size_t(i)]->value == i);
+    }
+  }
+
+  SECTION("alignment")
+  {
+    auto items = std::vector<std::unique_ptr<aligned_pooled_item>>{};
+    for (size_t i = 0; i < 100; ++i)
+    {
+      items.push_back(std::make_unique<aligned_pooled_item>());
+      CHECK(reinterpret_cast<std::uintptr_t>(items.back().get()) % 32 == 0);
+    }
+  }
+
+  SECTION("larger derived types")
+  {
+    auto item = std::make_unique<larger_pooled_item>();
+    item->other_value[15] = 1;
+    CHECK(item->other_value[15] == 1);
+  }
+}
+
+} // namespace kdl
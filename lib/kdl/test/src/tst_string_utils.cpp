@@ -216,6 +216,14 @@ TEST_CASE("string_format_test.str_to_float")
   CHECK(str_to_float("a123231.0") == std::nullopt);
   CHECK(str_to_float(" ") == std::nullopt);
   CHECK(str_to_float("") == std::nullopt);
+  CHECK(str_to_float("-16") == -16.0f);
+  CHECK(str_to_float("0.1") == 0.1f);
+  CHECK(str_to_float(".5") == 0.5f);
+  CHECK(str_to_float("3.") == 3.0f);
+  CHECK(str_to_float("16777217") == 16777216.0f);
+  CHECK(str_to_float("1.5e2") == 150.0f);
+  CHECK(str_to_float("-") == std::nullopt);
+  CHECK(str_to_float(".") == std::nullopt);
 }
 
 TEST_CASE("string_format_test.str_to_double")
@@ -226,6 +234,16 @@ TEST_CASE("string_format_test.str_to_double")
   CHECK(str_to_double("a123231.0") == std::nullopt);
   CHECK(str_to_double(" ") == std::nullopt);
   CHECK(str_to_double("") == std::nullopt);
+  CHECK(str_to_double("-16") == -16.0);
+  CHECK(str_to_double("0.1") == 0.1);
+  CHECK(str_to_double("-0.015625") == -0.015625);
+  CHECK(str_to_double("123456.789") == 123456.789);
+  CHECK(str_to_double("0.12345678901234567890123") == 0.12345678901234567890123);
+  CHECK(str_to_double("9007199254740993") == 9007199254740992.0);
+  CHECK(str_to_double("1.5e2") == 150.0);
+  CHECK(str_to_double("1.5.2") == 1.5);
+  CHECK(str_to_double("-") == std::nullopt);
+  CHECK(str_to_double(".") == std::nullopt);
 }
 
 TEST_CASE("string_format_test.str_to_long_double")
@@ -0,0 +1,134 @@
+/*
+ Copyright 2024 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this
+ software and associated documentation files (the "Software"), to deal in the Software
+ without restriction, including without limitation the rights to use, copy, modify, merge,
+ publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+ INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR
+ PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE
+ FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ DEALINGS IN THE SOFTWARE.
+*/
+
+#include "kdl/thread_pool.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "catch2.h"
+
+namespace kdl
+{
+
+TEST_CASE("thread_pool")
+{
+  SECTION("capacity")
+  {
+    CHECK(thread_pool{3}.capacity() == 3);
+    CHECK(thread_pool{3}.max_concurrency() == 3);
+    CHECK(thread_pool{}.capacity() >= 1);
+  }
+
+  SECTION("set_max_concurrency")
+  {
+    auto pool = thread_pool{4};
+
+    pool.set_max_concurrency(2);
+    CHECK(pool.max_concurrency() == 2);
+
+    pool.set_max_concurrency(0);
+    CHECK(pool.max_concurrency() == 1);
+
+    pool.set_max_concurrency(8);
+    CHECK(pool.max_concurrency() == 4);
+  }
+
+  SECTION("workers are spawned lazily")
+  {
+    auto pool = thread_pool{2};
+    CHECK(pool.worker_count() == 0);
+
+    auto done = std::atomic<bool>{false};
+    pool.submit([&]() { done = true; });
+    CHECK(pool.worker_count() >= 1);
+
+    while (!done)
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  SECTION("runs all submitted tasks")
+  {
+    constexpr size_t TaskCount = 1000;
+    auto counter = std::atomic<size_t>{0};
+
+    {
+      auto pool = thread_pool{4};
+      for (size_t i = 0; i < TaskCount; ++i)
+      {
+        pool.submit([&]() { ++counter; });
+      }
+      // the destructor runs the remaining tasks before joining
+    }
+
+    CHECK(counter == TaskCount);
+  }
+
+  SECTION("is_worker_thread")
+  {
+    auto pool = thread_pool{2};
+    CHECK_FALSE(pool.is_worker_thread());
+
+    auto mutex = std::mutex{};
+    auto condition = std::condition_variable{};
+    auto done = false;
+    auto isWorker = false;
+
+    pool.submit([&]() {
+      const auto lock = std::lock_guard{mutex};
+      isWorker = pool.is_worker_thread();
+      done = true;
+      condition.notify_all();
+    });
+
+    auto lock = std::unique_lock{mutex};
+    condition.wait(lock, [&]() { return done; });
+    CHECK(isWorker);
+  }
+
+  SECTION("tasks submitted from workers are run")
+  {
+    auto counter = std::atomic<size_t>{0};
+
+    {
+      auto pool = thread_pool{2};
+      pool.submit([&]() {
+        for (size_t i = 0; i < 10; ++i)
+        {
+          pool.submit([&]() { ++counter; });
+        }
+      });
+
+      while (counter < 10)
+      {
+        std::this_thread::yield();
+      }
+    }
+
+    CHECK(counter == 10);
+  }
+}
+
+} // namespace kdl